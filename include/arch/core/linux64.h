@@ -47,6 +47,7 @@
 #include <arch/core/linux64/int.h>
 #include <arch/core/linux64/ivt.h>
 #include <arch/core/linux64/spinlock.h>
+#include <arch/core/linux64/spinwait.h>
 #include <arch/core/linux64/mmu.h>
 #include <arch/core/linux64/trap.h>
 #include <arch/core/linux64/ctx.h>
@@ -0,0 +1,97 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef ARCH_CORE_LINUX64_SPINWAIT_H_
+#define ARCH_CORE_LINUX64_SPINWAIT_H_
+
+/**
+ * @addtogroup linux64-core-spinwait Spin Wait
+ * @ingroup linux64-core
+ *
+ * @brief linux64 Spin Wait Hooks
+ */
+/**@{*/
+
+#include <sched.h>
+
+/**
+ * @brief Relaxes the underlying core in a spin loop.
+ *
+ * On x86 this hints the core that it is spinning, which saves power
+ * and frees resources for the sibling hardware thread.
+ */
+static inline void linux64_core_pause(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+/**
+ * @brief Yields the underlying core to other threads.
+ */
+static inline void linux64_core_yield(void)
+{
+    sched_yield();
+}
+
+/**@}*/
+
+/*============================================================================*
+ * Exported Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @cond linux64
+ */
+
+/**
+ * @name Exported Functions
+ */
+/**@{*/
+#define __spinwait_pause_fn /**< spinwait_pause() */
+#define __spinwait_yield_fn /**< spinwait_yield() */
+/**@}*/
+
+/**
+ * @see linux64_core_pause().
+ */
+static inline void __spinwait_pause(void)
+{
+    linux64_core_pause();
+}
+
+/**
+ * @see linux64_core_yield().
+ */
+static inline void __spinwait_yield(void)
+{
+    linux64_core_yield();
+}
+
+/**@endcond*/
+
+#endif /* ARCH_CORE_LINUX64_SPINWAIT_H_ */
@@ -49,15 +49,28 @@
 
 #ifdef __NANVIX_HAL
 
+/**
+ * @name Boot flags of the underlying processor.
+ */
+/**@{*/
+#define LINUX64_PROCESSOR_LOCAL                                                \
+    (1 << 0) /**< Clusters and NoC live in the calling process. */
+/**@}*/
+
 /**
  * @brief Powers on the underlying processor.
  *
  * @param nclusters Number of clusters to power on.
+ * @param flags     Boot flags.
  *
  * @returns Upon successful completion, zero is returned. Upon
  * failure, a negative error code is returned instead.
+ *
+ * @note When LINUX64_PROCESSOR_LOCAL is set, the tables of clusters
+ * and the NoC are backed by the memory of the calling process instead
+ * of POSIX IPC objects, thus no other process can attach to them.
  */
-extern int linux64_processor_boot(int nclusters);
+extern int linux64_processor_boot(int nclusters, unsigned flags);
 
 /**
  * @brief Initializes the underlying processor.
@@ -74,8 +74,11 @@
 
 /**
  * @brief Powers on clusters of the underlying processor.
+ *
+ * @param nclusters Number of clusters to power on.
+ * @param flags     Boot flags of the underlying processor.
  */
-extern void linux64_processor_clusters_boot(void);
+extern void linux64_processor_clusters_boot(int nclusters, unsigned flags);
 
 /**
  * @brief Powers off clusters of the underlying processor.
@@ -94,6 +97,14 @@ extern void linux64_processor_clusters_setup(void);
  */
 extern int linux64_cluster_get_num(void);
 
+/**
+ * @brief Retrieves the number of clusters that were powered on.
+ *
+ * @note Every process of the virtual processor should be powered on
+ * with the same number of clusters.
+ */
+extern int linux64_processor_get_nclusters(void);
+
 /**
  * @brief Asserts whether or not the target cluster is a compute cluster.
  *
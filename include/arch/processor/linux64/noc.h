@@ -61,12 +61,96 @@
  */
 #define LINUX64_PROCESSOR_NODENUM_LEADER (LINUX64_PROCESSOR_NOC_IONODES_NUM + 0)
 
+/**
+ * @brief Size (in bytes) of a slot in the shared arena of the NoC.
+ *
+ * The arena has one slot for each ordered pair of NoC nodes, and one
+ * multicast slot for each NoC node. The size must be a multiple of
+ * the cache line size. Pages of the arena are only allocated when
+ * touched, thus unused room is cheap.
+ */
+#ifndef LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE
+#define LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE (8 * LINUX64_PAGE_SIZE)
+#endif
+
+/**
+ * @brief Size (in bytes) of a doorbell in the shared arena of the NoC.
+ *
+ * Doorbells of all NoC nodes are packed into a single slot of the
+ * arena, thus the size must be a multiple of the cache line size.
+ */
+#define LINUX64_PROCESSOR_NOC_ARENA_BELL_SIZE 128
+
+/**
+ * @brief Size (in bytes) of a credit block in the shared arena of the
+ * NoC.
+ *
+ * Credit blocks of all NoC nodes are packed into the slot of
+ * doorbells, right after them, thus the size must be a multiple of the
+ * cache line size.
+ */
+#define LINUX64_PROCESSOR_NOC_ARENA_CREDIT_SIZE 128
+
+/**
+ * @brief Advise the kernel to back the shared arena with huge pages?
+ */
+#ifndef __LINUX64_PROCESSOR_NOC_ARENA_USES_HUGEPAGES
+#define __LINUX64_PROCESSOR_NOC_ARENA_USES_HUGEPAGES 1
+#endif
+
 #ifdef __NANVIX_HAL
 
+/**
+ * @brief Gets the slot of a pair of NoC nodes in the shared arena.
+ *
+ * @param local  Logical number of the receiver NoC node.
+ * @param remote Logical number of the sender NoC node.
+ *
+ * @returns A pointer to a zero-filled region of
+ * LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE bytes, which is shared by all
+ * clusters and aligned to a cache line boundary.
+ */
+extern void *linux64_processor_noc_arena_slot(int local, int remote);
+
+/**
+ * @brief Gets the multicast slot of a NoC node in the shared arena.
+ *
+ * @param nodenum Logical number of the sender NoC node.
+ *
+ * @returns A pointer to a zero-filled region of
+ * LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE bytes, which is shared by all
+ * clusters and aligned to a cache line boundary.
+ */
+extern void *linux64_processor_noc_arena_mslot(int nodenum);
+
+/**
+ * @brief Gets the doorbell of a NoC node in the shared arena.
+ *
+ * @param nodenum Logical number of the target NoC node.
+ *
+ * @returns A pointer to a zero-filled region of
+ * LINUX64_PROCESSOR_NOC_ARENA_BELL_SIZE bytes, which is shared by all
+ * clusters and aligned to a cache line boundary.
+ */
+extern void *linux64_processor_noc_arena_bell(int nodenum);
+
+/**
+ * @brief Gets the credit block of a NoC node in the shared arena.
+ *
+ * @param nodenum Logical number of the receiver NoC node.
+ *
+ * @returns A pointer to a zero-filled region of
+ * LINUX64_PROCESSOR_NOC_ARENA_CREDIT_SIZE bytes, which is shared by
+ * all clusters and aligned to a cache line boundary.
+ */
+extern void *linux64_processor_noc_arena_credit(int nodenum);
+
 /**
  * @brief Powers on the network-on-chip.
+ *
+ * @param flags Boot flags of the underlying processor.
  */
-extern void linux64_processor_noc_boot(void);
+extern void linux64_processor_noc_boot(unsigned flags);
 
 /**
  * @brief Powers off the network-on-chip.
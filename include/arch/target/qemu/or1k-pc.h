@@ -72,6 +72,7 @@
 #define __TARGET_HAS_SYNC 0    /**< Synchronization feature */
 #define __TARGET_HAS_MAILBOX 0 /**< Mailbox feature         */
 #define __TARGET_HAS_PORTAL 0  /**< Portal feature          */
+#define __TARGET_HAS_POLL 0    /**< Poll feature            */
                                /**@}*/
 
 /**@endcond*/
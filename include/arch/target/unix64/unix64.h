@@ -47,6 +47,7 @@
 #include <arch/target/unix64/unix64/sync.h>
 #include <arch/target/unix64/unix64/mailbox.h>
 #include <arch/target/unix64/unix64/portal.h>
+#include <arch/target/unix64/unix64/poll.h>
 #include <arch/target/unix64/unix64/stdout.h>
 
 /**
@@ -89,6 +90,7 @@ extern NORETURN void unix64_poweroff(void);
 #define __TARGET_HAS_SYNC 1    /**< Synchronization feature */
 #define __TARGET_HAS_MAILBOX 1 /**< Mailbox feature         */
 #define __TARGET_HAS_PORTAL 1  /**< Portal feature          */
+#define __TARGET_HAS_POLL 1    /**< Poll feature            */
 /**@}*/
 
 /**
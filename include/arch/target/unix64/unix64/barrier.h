@@ -0,0 +1,193 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TARGET_UNIX64_UNIX64_BARRIER_H_
+#define TARGET_UNIX64_UNIX64_BARRIER_H_
+
+/* Processor API. */
+#include <arch/target/unix64/unix64/_unix64.h>
+
+/**
+ * @addtogroup target-unix64-barrier Barrier
+ * @ingroup target-unix64
+ *
+ * @brief Shared-memory sense-reversing barrier.
+ */
+/**@{*/
+
+/* Must come first. */
+#define __NEED_CC
+
+#include <arch/target/unix64/unix64/futex.h>
+#include <nanvix/cc.h>
+#include <posix/stddef.h>
+#include <posix/stdint.h>
+
+/**
+ * @name Barrier parameters.
+ */
+/**@{*/
+#define UNIX64_BARRIER_TABLE_SIZE 64 /**< Number of barriers in a table. */
+#define UNIX64_BARRIER_ALIGN 64      /**< Alignment (cache line size).   */
+#define UNIX64_BARRIER_NODES_NUM                                               \
+    (LINUX64_PROCESSOR_NOC_IONODES_NUM +                                       \
+     LINUX64_PROCESSOR_NOC_CNODES_NUM) /**< Number of NoC nodes. */
+/**@}*/
+
+/**
+ * @brief Barrier.
+ *
+ * Senders count their arrivals in @p count. The last sender of a
+ * round resets the count and reverses the sense of the barrier, by
+ * bumping the counter of the @p done event. Thus the event counter is
+ * the number of completed rounds, and each waiter keeps in @p consumed
+ * how many of them it has seen. A zero-filled barrier is a valid
+ * barrier with no completed rounds.
+ */
+struct unix64_barrier {
+    uint64_t key;              /**< Key (zero if free).            */
+    uint32_t count;            /**< Arrivals in the current round. */
+    struct unix64_event done;  /**< Round completed.               */
+    uint32_t consumed[UNIX64_BARRIER_NODES_NUM]; /**< Rounds seen by waiters. */
+} ALIGN(UNIX64_BARRIER_ALIGN);
+
+/**
+ * @brief Table of barriers.
+ *
+ * Barriers are looked up by key with open addressing, and a key is
+ * never removed from the table, so that rounds completed before a
+ * waiter shows up are not lost.
+ */
+struct unix64_barrier_table {
+    struct unix64_barrier barriers[UNIX64_BARRIER_TABLE_SIZE]; /**< Barriers. */
+};
+
+#ifdef __NANVIX_HAL
+
+/**
+ * @brief Maps a table of barriers.
+ *
+ * @param name Name of the underlying shared memory segment.
+ *
+ * @returns Upon successful completion, a pointer to the table is
+ * returned. Upon failure, NULL is returned instead.
+ *
+ * @note The table is created if it does not exist.
+ */
+extern struct unix64_barrier_table *unix64_barrier_map(const char *name);
+
+/**
+ * @brief Unmaps a table of barriers.
+ *
+ * @param table Target table.
+ */
+extern void unix64_barrier_unmap(struct unix64_barrier_table *table);
+
+/**
+ * @brief Removes the shared memory segment of a table of barriers.
+ *
+ * @param name Name of the underlying shared memory segment.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+extern int unix64_barrier_unlink(const char *name);
+
+/**
+ * @brief Gets a barrier.
+ *
+ * @param table Target table.
+ * @param key   Key of the barrier (non-zero).
+ *
+ * @returns Upon successful completion, the barrier that matches @p
+ * key is returned, claiming a free one if needed. If the table is
+ * full, NULL is returned instead.
+ *
+ * @note This function is lock-free.
+ */
+extern struct unix64_barrier *
+unix64_barrier_get(struct unix64_barrier_table *table, uint64_t key);
+
+/**
+ * @brief Gets the number of completed rounds of a barrier.
+ *
+ * @param barrier Target barrier.
+ *
+ * @returns The number of completed rounds of @p barrier.
+ */
+extern uint32_t unix64_barrier_round(struct unix64_barrier *barrier);
+
+/**
+ * @brief Arrives at a barrier.
+ *
+ * @param barrier  Target barrier.
+ * @param round    Round of the caller. It is updated to the next
+ * round upon successful completion.
+ * @param nsenders Number of senders of the barrier.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, zero is returned. If the
+ * previous round of the caller does not complete before the deadline
+ * expires, -ETIMEDOUT is returned instead.
+ *
+ * @note A sender is never more than one round ahead of the others.
+ */
+extern int unix64_barrier_arrive(struct unix64_barrier *barrier,
+                                 uint32_t *round, uint32_t nsenders,
+                                 const struct unix64_deadline *deadline);
+
+/**
+ * @brief Waits for a round of a barrier to complete.
+ *
+ * @param barrier  Target barrier.
+ * @param nodenum  NoC node of the caller.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, zero is returned. If the
+ * deadline expires, -ETIMEDOUT is returned instead.
+ *
+ * @note Each call consumes a single completed round.
+ */
+extern int unix64_barrier_wait(struct unix64_barrier *barrier, int nodenum,
+                               const struct unix64_deadline *deadline);
+
+/**
+ * @brief Asserts whether or not a barrier has rounds left to consume.
+ *
+ * @param barrier Target barrier.
+ * @param nodenum NoC node of the caller.
+ *
+ * @returns Non-zero if a completed round was not consumed by @p
+ * nodenum yet, and zero otherwise.
+ *
+ * @note This function does not consume any round.
+ */
+extern int unix64_barrier_is_complete(struct unix64_barrier *barrier,
+                                      int nodenum);
+
+#endif /* __NANVIX_HAL */
+
+/**@}*/
+
+#endif /* TARGET_UNIX64_UNIX64_BARRIER_H_ */
@@ -0,0 +1,193 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TARGET_UNIX64_UNIX64_FUTEX_H_
+#define TARGET_UNIX64_UNIX64_FUTEX_H_
+
+/**
+ * @addtogroup target-unix64-futex Futex
+ * @ingroup target-unix64
+ *
+ * @brief Wait/wake primitives and deadlines.
+ */
+/**@{*/
+
+/* Must come first. */
+#define __NEED_CC
+
+#include <nanvix/cc.h>
+#include <posix/stdint.h>
+#include <time.h>
+
+/**
+ * @brief Timeout that never expires.
+ */
+#define UNIX64_TIMEOUT_INFINITE (-1)
+
+/**
+ * @brief Deadline.
+ */
+struct unix64_deadline {
+    int infinite;       /**< Never expires?                 */
+    struct timespec tm; /**< Absolute time (CLOCK_MONOTONIC). */
+};
+
+/**
+ * @brief Alignment of an event (cache line size).
+ */
+#define UNIX64_EVENT_ALIGN 64
+
+/**
+ * @brief Event.
+ *
+ * The event counter is a futex word that is bumped whenever the
+ * event happens. Waiters are counted, so that the notifying side only
+ * issues a system call when someone is actually sleeping. A
+ * zero-filled event is a valid event, thus events may live in shared
+ * memory segments without further initialization.
+ */
+struct unix64_event {
+    uint32_t counter;  /**< Event counter (futex word). */
+    uint32_t nwaiters; /**< Number of sleeping waiters. */
+} ALIGN(UNIX64_EVENT_ALIGN);
+
+/**
+ * @brief Longest time that a spin waiter stays parked (in milliseconds).
+ *
+ * Waiters recheck their condition at least this often, even if a
+ * wakeup is lost.
+ */
+#define UNIX64_SPINWAIT_PARK_TIMEOUT 10
+
+#ifdef __NANVIX_HAL
+
+/* Forward definitions. */
+struct spinwait;
+
+/**
+ * @brief Sets a deadline.
+ *
+ * @param deadline Target deadline.
+ * @param timeout  Timeout (in milliseconds) from now on. A negative
+ * value means that the deadline never expires.
+ */
+extern void unix64_deadline_set(struct unix64_deadline *deadline,
+                                int timeout);
+
+/**
+ * @brief Asserts whether or not a deadline has expired.
+ *
+ * @param deadline Target deadline.
+ *
+ * @returns Non-zero if the deadline has expired and zero otherwise.
+ */
+extern int unix64_deadline_expired(const struct unix64_deadline *deadline);
+
+/**
+ * @brief Converts the next slice of a deadline to wall-clock time.
+ *
+ * @param deadline Target deadline.
+ * @param tm       Place where the absolute time (CLOCK_REALTIME)
+ * should be stored.
+ *
+ * Slices are at most one second long, so that a wall-clock jump
+ * disturbs a single slice at most. This is meant for primitives that
+ * only take CLOCK_REALTIME timeouts, such as mq_timedsend().
+ */
+extern void unix64_deadline_slice(const struct unix64_deadline *deadline,
+                                  struct timespec *tm);
+
+/**
+ * @brief Waits on a shared futex.
+ *
+ * @param addr     Target futex word.
+ * @param val      Expected value of the futex word.
+ * @param deadline Deadline for waking up.
+ *
+ * @returns Upon successful completion, zero is returned. If the
+ * futex word does not hold @p val, or the wait was interrupted,
+ * -EAGAIN is returned. If the deadline expires, -ETIMEDOUT is
+ * returned instead.
+ */
+extern int unix64_futex_wait(uint32_t *addr, uint32_t val,
+                             const struct unix64_deadline *deadline);
+
+/**
+ * @brief Wakes up all waiters of a shared futex.
+ *
+ * @param addr Target futex word.
+ */
+extern void unix64_futex_wake(uint32_t *addr);
+
+/**
+ * @brief Snapshots the counter of an event.
+ *
+ * @param event Target event.
+ *
+ * @returns The current value of the event counter. It should be
+ * taken before checking the condition that the event signals, so that
+ * no wakeup is missed.
+ */
+extern uint32_t unix64_event_counter(struct unix64_event *event);
+
+/**
+ * @brief Notifies an event.
+ *
+ * @param event Target event.
+ */
+extern void unix64_event_notify(struct unix64_event *event);
+
+/**
+ * @brief Waits for an event.
+ *
+ * @param event    Target event.
+ * @param counter  Value of the event counter that was last seen.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, zero is returned. If the
+ * deadline expires, -ETIMEDOUT is returned instead.
+ *
+ * @note A spurious wakeup is reported as success.
+ */
+extern int unix64_event_wait(struct unix64_event *event, uint32_t counter,
+                             const struct unix64_deadline *deadline);
+
+/**
+ * @brief Spends a round waiting for an event.
+ *
+ * @param event   Target event.
+ * @param counter Value of the event counter that was last seen.
+ * @param waiter  Spin waiter of the caller.
+ *
+ * The round is spent spinning or yielding, as the policy of @p waiter
+ * says, and once that is over it is spent parked on @p event.
+ */
+extern void unix64_event_spinwait(struct unix64_event *event,
+                                  uint32_t counter, struct spinwait *waiter);
+
+#endif /* __NANVIX_HAL */
+
+/**@}*/
+
+#endif /* TARGET_UNIX64_UNIX64_FUTEX_H_ */
@@ -0,0 +1,103 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TARGET_UNIX64_UNIX64_LOOPBACK_H_
+#define TARGET_UNIX64_UNIX64_LOOPBACK_H_
+
+/**
+ * @addtogroup target-unix64-loopback Loopback
+ * @ingroup target-unix64
+ *
+ * @brief In-process memory segments.
+ *
+ * Loopback segments stand in for shared memory segments when all NoC
+ * nodes live in the same address space, thus no POSIX IPC object
+ * backs them.
+ */
+/**@{*/
+
+/* Must come first. */
+#define __NEED_CC
+
+#include <nanvix/cc.h>
+#include <posix/stddef.h>
+
+/**
+ * @brief Maximum number of loopback segments in a process.
+ */
+#ifndef UNIX64_LOOPBACK_SEGMENTS_MAX
+#define UNIX64_LOOPBACK_SEGMENTS_MAX 64
+#endif
+
+/**
+ * @brief Maximum length of the name of a loopback segment.
+ */
+#define UNIX64_LOOPBACK_NAME_LENGTH 128
+
+/**
+ * @brief Alignment of a loopback segment (in bytes).
+ */
+#define UNIX64_LOOPBACK_ALIGN 64
+
+#ifdef __NANVIX_HAL
+
+/**
+ * @brief Maps a loopback segment.
+ *
+ * @param name Name of the segment.
+ * @param size Size of the segment (in bytes).
+ *
+ * @returns Upon successful completion, a pointer to the segment is
+ * returned. Upon failure, NULL is returned instead.
+ *
+ * @note The segment is created if it does not exist.
+ * @note The segment lives in the memory of the calling process, thus
+ * it is only reachable from the same address space.
+ */
+extern void *unix64_loopback_map(const char *name, size_t size);
+
+/**
+ * @brief Unmaps a loopback segment.
+ *
+ * @param addr Target segment.
+ */
+extern void unix64_loopback_unmap(void *addr);
+
+/**
+ * @brief Removes the name of a loopback segment.
+ *
+ * @param name Name of the segment.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note The segment is released once it is no longer mapped.
+ */
+extern int unix64_loopback_unlink(const char *name);
+
+#endif /* __NANVIX_HAL */
+
+/**@}*/
+
+#endif /* TARGET_UNIX64_UNIX64_LOOPBACK_H_ */
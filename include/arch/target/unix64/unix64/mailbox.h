@@ -42,6 +42,16 @@
 #include <posix/sys/types.h>
 #include <nanvix/cc.h>
 
+/**
+ * @brief Use shared-memory rings instead of POSIX message queues?
+ *
+ * This only sets the default transport of NoC connectors, which may
+ * be overridden at boot with the --transport argument.
+ */
+#ifndef __UNIX64_MAILBOX_USES_RING
+#define __UNIX64_MAILBOX_USES_RING 0
+#endif
+
 /**
  * @name Maximum number of mailboxes points.
  */
@@ -73,12 +83,72 @@
      UNIX64_MAILBOX_DATA_SIZE) /**< Message size.                  */
 /**@}*/
 
+/**
+ * @brief Maximum size (in bytes) of a mailbox message.
+ *
+ * Single messages may be of any size up to this one, and are delivered
+ * with their actual size. Batches and reserved messages are always
+ * UNIX64_MAILBOX_MSG_SIZE bytes long.
+ */
+#ifndef UNIX64_MAILBOX_MSG_SIZE_MAX
+#define UNIX64_MAILBOX_MSG_SIZE_MAX UNIX64_MAILBOX_MSG_SIZE
+#endif
+
+#if (UNIX64_MAILBOX_MSG_SIZE_MAX < UNIX64_MAILBOX_MSG_SIZE)
+#error "UNIX64_MAILBOX_MSG_SIZE_MAX is smaller than UNIX64_MAILBOX_MSG_SIZE"
+#endif
+
+/**
+ * @brief Number of idle NoC connectors kept open by a process.
+ *
+ * Reopening a mailbox to a recently used node reuses a cached NoC
+ * connector instead of opening it again. The least recently used
+ * connector is evicted when the cache is full.
+ */
+#ifndef UNIX64_MAILBOX_CACHE_SIZE
+#define UNIX64_MAILBOX_CACHE_SIZE 16
+#endif
+
+/**
+ * @brief Default timeout (in milliseconds) of blocking operations.
+ */
+#define UNIX64_MAILBOX_TIMEOUT 5000
+
+/**
+ * @name Special timeouts.
+ */
+/**@{*/
+#define UNIX64_MAILBOX_TIMEOUT_TRY 0         /**< Never block.  */
+#define UNIX64_MAILBOX_TIMEOUT_INFINITE (-1) /**< Never expire. */
+/**@}*/
+
+/**
+ * @name Priority classes.
+ *
+ * Messages of a higher class are received first, and messages of the
+ * same class are received in order.
+ */
+/**@{*/
+#define UNIX64_MAILBOX_PRIORITY_LOW 0    /**< Bulk traffic.       */
+#define UNIX64_MAILBOX_PRIORITY_NORMAL 1 /**< Default.            */
+#define UNIX64_MAILBOX_PRIORITY_HIGH 2   /**< Control traffic.    */
+#define UNIX64_MAILBOX_PRIORITY_NUM 3    /**< Number of classes.  */
+/**@}*/
+
 /**
  * @name IO control requests.
  */
 /**@{*/
 #define UNIX64_MAILBOX_IOCTL_SET_ASYNC_BEHAVIOR                                \
     0 /**< Sets the wait/wakeup functions on a resource. */
+#define UNIX64_MAILBOX_IOCTL_SET_TIMEOUT                                       \
+    1 /**< Sets the timeout (in milliseconds) of blocking operations. */
+#define UNIX64_MAILBOX_IOCTL_SET_PRIORITY                                      \
+    2 /**< Sets the priority class of messages sent afterwards. */
+#define UNIX64_MAILBOX_IOCTL_SET_CREDITS                                       \
+    3 /**< Sets the send credits granted per priority class. */
+#define UNIX64_MAILBOX_IOCTL_GET_CREDITS                                       \
+    4 /**< Gets the send credits available to an output mailbox. */
       /**@}*/
 
 #ifdef __NANVIX_HAL
@@ -88,6 +158,25 @@
  */
 extern void unix64_mailbox_shutdown(void);
 
+/**
+ * @brief Closes all idle NoC connectors cached by the calling process.
+ */
+extern void unix64_mailbox_cache_flush(void);
+
+/**
+ * @brief Polls a mailbox for readiness.
+ *
+ * @param mbxid  Target mailbox.
+ * @param events Requested events.
+ *
+ * @returns Upon successful completion, the requested events that are
+ * ready are returned. Upon failure, a negative error code is returned
+ * instead.
+ *
+ * @note This function is non-blocking.
+ */
+extern int unix64_mailbox_poll(int mbxid, unsigned events);
+
 #endif /* __NANVIX_HAL */
 
 /**
@@ -162,6 +251,74 @@ extern ssize_t unix64_mailbox_awrite(int mbxid, const void *buffer,
  */
 extern ssize_t unix64_mailbox_aread(int mbxid, void *buffer, uint64_t size);
 
+/**
+ * @brief Writes a batch of messages to a mailbox.
+ *
+ * @param mbxid  ID of the target mailbox.
+ * @param buffer Buffer where the messages should be read from.
+ * @param nmsgs  Number of messages to write.
+ *
+ * @returns Upon successful completion, the number of messages written
+ * is returned. Upon failure, a negative error code is returned
+ * instead.
+ */
+extern int unix64_mailbox_awritev(int mbxid, const void *buffer, int nmsgs);
+
+/**
+ * @brief Reads a batch of messages from a mailbox.
+ *
+ * @param mbxid  ID of the target mailbox.
+ * @param buffer Buffer where the messages should be written to.
+ * @param nmsgs  Maximum number of messages to read.
+ *
+ * @returns Upon successful completion, the number of messages read
+ * is returned. Upon failure, a negative error code is returned
+ * instead.
+ */
+extern int unix64_mailbox_areadv(int mbxid, void *buffer, int nmsgs);
+
+/**
+ * @brief Reserves room for a message in a mailbox.
+ *
+ * @param mbxid  ID of the target mailbox.
+ * @param buffer Place where the reserved room should be stored.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+extern int unix64_mailbox_reserve(int mbxid, void **buffer);
+
+/**
+ * @brief Sends a message reserved in a mailbox.
+ *
+ * @param mbxid ID of the target mailbox.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+extern int unix64_mailbox_commit(int mbxid);
+
+/**
+ * @brief Gets the oldest message of a mailbox in place.
+ *
+ * @param mbxid  ID of the target mailbox.
+ * @param buffer Place where the message should be stored.
+ *
+ * @returns Upon successful completion, the size of the message is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+extern ssize_t unix64_mailbox_peek(int mbxid, void **buffer);
+
+/**
+ * @brief Consumes a message peeked from a mailbox.
+ *
+ * @param mbxid ID of the target mailbox.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+extern int unix64_mailbox_release(int mbxid);
+
 /**
  * @brief Request an I/O operation on a mailbox.
  *
@@ -188,15 +345,21 @@ extern int unix64_mailbox_ioctl(int mbxid, unsigned request, va_list args);
  * @name Provided Functions
  */
 /**@{*/
-#define __mailbox_setup_fn  /**< mailbox_setup()  */
-#define __mailbox_create_fn /**< mailbox_create() */
-#define __mailbox_open_fn   /**< mailbox_open()   */
-#define __mailbox_unlink_fn /**< mailbox_unlink() */
-#define __mailbox_close_fn  /**< mailbox_close()  */
-#define __mailbox_awrite_fn /**< mailbox_awrite() */
-#define __mailbox_aread_fn  /**< mailbox_aread()  */
-#define __mailbox_wait_fn   /**< mailbox_wait()   */
-#define __mailbox_ioctl_fn  /**< mailbox_ioctl()  */
+#define __mailbox_setup_fn   /**< mailbox_setup()   */
+#define __mailbox_create_fn  /**< mailbox_create()  */
+#define __mailbox_open_fn    /**< mailbox_open()    */
+#define __mailbox_unlink_fn  /**< mailbox_unlink()  */
+#define __mailbox_close_fn   /**< mailbox_close()   */
+#define __mailbox_awrite_fn  /**< mailbox_awrite()  */
+#define __mailbox_aread_fn   /**< mailbox_aread()   */
+#define __mailbox_awritev_fn /**< mailbox_awritev() */
+#define __mailbox_areadv_fn  /**< mailbox_areadv()  */
+#define __mailbox_reserve_fn /**< mailbox_reserve() */
+#define __mailbox_commit_fn  /**< mailbox_commit()  */
+#define __mailbox_peek_fn    /**< mailbox_peek()    */
+#define __mailbox_release_fn /**< mailbox_release() */
+#define __mailbox_wait_fn    /**< mailbox_wait()    */
+#define __mailbox_ioctl_fn   /**< mailbox_ioctl()   */
 /**@}*/
 
 /**
@@ -217,6 +380,8 @@ extern int unix64_mailbox_ioctl(int mbxid, unsigned request, va_list args);
     UNIX64_MAILBOX_DATA_SIZE /**< @see UNIX64_MAILBOX_DATA_SIZE     */
 #define HAL_MAILBOX_MSG_SIZE                                                   \
     UNIX64_MAILBOX_MSG_SIZE /**< @see UNIX64_MAILBOX_MSG_SIZE      */
+#define HAL_MAILBOX_MSG_SIZE_MAX                                               \
+    UNIX64_MAILBOX_MSG_SIZE_MAX /**< @see UNIX64_MAILBOX_MSG_SIZE_MAX */
 /**@}*/
 
 /**
@@ -227,6 +392,45 @@ extern int unix64_mailbox_ioctl(int mbxid, unsigned request, va_list args);
     UNIX64_MAILBOX_IOCTL_SET_ASYNC_BEHAVIOR /**< @see                                  \
                                                UNIX64_MAILBOX_IOCTL_SET_ASYNC_BEHAVIOR \
                                              */
+#define HAL_MAILBOX_IOCTL_SET_TIMEOUT                                          \
+    UNIX64_MAILBOX_IOCTL_SET_TIMEOUT /**< @see                                 \
+                                        UNIX64_MAILBOX_IOCTL_SET_TIMEOUT       \
+                                      */
+#define HAL_MAILBOX_IOCTL_SET_PRIORITY                                         \
+    UNIX64_MAILBOX_IOCTL_SET_PRIORITY /**< @see                                \
+                                         UNIX64_MAILBOX_IOCTL_SET_PRIORITY     \
+                                       */
+#define HAL_MAILBOX_IOCTL_SET_CREDITS                                          \
+    UNIX64_MAILBOX_IOCTL_SET_CREDITS /**< @see                                 \
+                                        UNIX64_MAILBOX_IOCTL_SET_CREDITS       \
+                                      */
+#define HAL_MAILBOX_IOCTL_GET_CREDITS                                          \
+    UNIX64_MAILBOX_IOCTL_GET_CREDITS /**< @see                                 \
+                                        UNIX64_MAILBOX_IOCTL_GET_CREDITS       \
+                                      */
+/**@}*/
+
+/**
+ * @name Priority classes.
+ */
+/**@{*/
+#define HAL_MAILBOX_PRIORITY_LOW                                               \
+    UNIX64_MAILBOX_PRIORITY_LOW /**< @see UNIX64_MAILBOX_PRIORITY_LOW */
+#define HAL_MAILBOX_PRIORITY_NORMAL                                            \
+    UNIX64_MAILBOX_PRIORITY_NORMAL /**< @see UNIX64_MAILBOX_PRIORITY_NORMAL */
+#define HAL_MAILBOX_PRIORITY_HIGH                                              \
+    UNIX64_MAILBOX_PRIORITY_HIGH /**< @see UNIX64_MAILBOX_PRIORITY_HIGH */
+/**@}*/
+
+/**
+ * @name Special timeouts.
+ */
+/**@{*/
+#define HAL_MAILBOX_TIMEOUT_TRY                                                \
+    UNIX64_MAILBOX_TIMEOUT_TRY /**< @see UNIX64_MAILBOX_TIMEOUT_TRY */
+#define HAL_MAILBOX_TIMEOUT_INFINITE                                           \
+    UNIX64_MAILBOX_TIMEOUT_INFINITE /**< @see UNIX64_MAILBOX_TIMEOUT_INFINITE \
+                                     */
 /**@}*/
 
 /**
@@ -266,6 +470,38 @@ extern int unix64_mailbox_ioctl(int mbxid, unsigned request, va_list args);
 #define __mailbox_aread(mbxid, buffer, size)                                   \
     unix64_mailbox_aread(mbxid, buffer, size)
 
+/**
+ * @see unix64_mailbox_awritev()
+ */
+#define __mailbox_awritev(mbxid, buffer, nmsgs)                                \
+    unix64_mailbox_awritev(mbxid, buffer, nmsgs)
+
+/**
+ * @see unix64_mailbox_areadv()
+ */
+#define __mailbox_areadv(mbxid, buffer, nmsgs)                                 \
+    unix64_mailbox_areadv(mbxid, buffer, nmsgs)
+
+/**
+ * @see unix64_mailbox_reserve()
+ */
+#define __mailbox_reserve(mbxid, buffer) unix64_mailbox_reserve(mbxid, buffer)
+
+/**
+ * @see unix64_mailbox_commit()
+ */
+#define __mailbox_commit(mbxid) unix64_mailbox_commit(mbxid)
+
+/**
+ * @see unix64_mailbox_peek()
+ */
+#define __mailbox_peek(mbxid, buffer) unix64_mailbox_peek(mbxid, buffer)
+
+/**
+ * @see unix64_mailbox_release()
+ */
+#define __mailbox_release(mbxid) unix64_mailbox_release(mbxid)
+
 /**
  * @brief Dummy operation.
  *
@@ -0,0 +1,174 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TARGET_UNIX64_UNIX64_POLL_H_
+#define TARGET_UNIX64_UNIX64_POLL_H_
+
+/* Processor API. */
+#include <arch/target/unix64/unix64/_unix64.h>
+
+/**
+ * @addtogroup target-unix64-poll Poll
+ * @ingroup target-unix64
+ *
+ * @brief Readiness polling of IKC endpoints.
+ */
+/**@{*/
+
+/* Must come first. */
+#define __NEED_CC
+
+#include <arch/target/unix64/unix64/futex.h>
+#include <nanvix/cc.h>
+#include <posix/stdint.h>
+
+/**
+ * @brief Maximum number of endpoints in a poll.
+ */
+#define UNIX64_IKC_POLL_MAX 32
+
+/**
+ * @name Types of endpoints.
+ */
+/**@{*/
+#define UNIX64_IKC_MAILBOX 0 /**< Mailbox. */
+#define UNIX64_IKC_PORTAL 1  /**< Portal.  */
+#define UNIX64_IKC_SYNC 2    /**< Sync.    */
+/**@}*/
+
+/**
+ * @name Readiness events.
+ *
+ * Input and output mailboxes (and portals) share the same IDs, thus
+ * the events also select the direction of the endpoint.
+ */
+/**@{*/
+#define UNIX64_IKC_POLLIN (1 << 0)  /**< Input endpoint may be read.     */
+#define UNIX64_IKC_POLLOUT (1 << 1) /**< Output endpoint may be written. */
+/**@}*/
+
+/**
+ * @brief Interval (in milliseconds) between scans of endpoints that
+ * do not ring doorbells.
+ *
+ * Readers of mailboxes do not know their writers, thus an output
+ * mailbox that becomes writable is only noticed on the next scan.
+ */
+#define UNIX64_IKC_POLL_SLICE 1
+
+/**
+ * @brief Polled endpoint.
+ */
+struct ikc_pollfd {
+    int type;         /**< Type of endpoint.  */
+    int id;           /**< ID of endpoint.    */
+    unsigned events;  /**< Requested events.  */
+    unsigned revents; /**< Returned events.   */
+};
+
+/**
+ * @brief Doorbell of a NoC node.
+ *
+ * Writers ring the doorbell of the NoC node that they make progress
+ * for, but only when some thread of that node is polling. Pollers are
+ * counted on a cache line of their own, so that the check is cheap.
+ */
+struct unix64_doorbell {
+    struct unix64_event event; /**< Ring.              */
+    uint32_t npollers ALIGN(UNIX64_EVENT_ALIGN); /**< Number of pollers. */
+};
+
+#ifdef __NANVIX_HAL
+
+/**
+ * @brief Rings the doorbell of a NoC node.
+ *
+ * @param nodenum Target NoC node.
+ *
+ * @note This function should be called after the progress that it
+ * announces is visible.
+ */
+extern void unix64_doorbell_ring(int nodenum);
+
+#endif /* __NANVIX_HAL */
+
+/**
+ * @brief Waits for some IKC endpoints to become ready.
+ *
+ * @param fds     Target endpoints.
+ * @param nfds    Number of target endpoints.
+ * @param timeout Timeout (in milliseconds). Zero means that the call
+ * does not block, and a negative value means that it never expires.
+ *
+ * @returns Upon successful completion, the number of ready endpoints
+ * is returned, and the revents field of each endpoint is set. If the
+ * timeout expires, zero is returned. Upon failure, a negative error
+ * code is returned instead.
+ */
+extern int unix64_ikc_poll(struct ikc_pollfd *fds, int nfds, int timeout);
+
+/**@}*/
+
+/*============================================================================*
+ * Exported Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @cond unix64_poll
+ */
+
+/**
+ * @name Provided Structures
+ */
+/**@{*/
+#define __ikc_pollfd_struct /**< @ref ikc_pollfd */
+/**@}*/
+
+/**
+ * @name Provided Functions
+ */
+/**@{*/
+#define __ikc_poll_fn /**< ikc_poll() */
+/**@}*/
+
+/**
+ * @name Provided Constants
+ */
+/**@{*/
+#define IKC_POLL_MAX UNIX64_IKC_POLL_MAX /**< @see UNIX64_IKC_POLL_MAX */
+#define IKC_MAILBOX UNIX64_IKC_MAILBOX   /**< @see UNIX64_IKC_MAILBOX  */
+#define IKC_PORTAL UNIX64_IKC_PORTAL     /**< @see UNIX64_IKC_PORTAL   */
+#define IKC_SYNC UNIX64_IKC_SYNC         /**< @see UNIX64_IKC_SYNC     */
+#define IKC_POLLIN UNIX64_IKC_POLLIN     /**< @see UNIX64_IKC_POLLIN   */
+#define IKC_POLLOUT UNIX64_IKC_POLLOUT   /**< @see UNIX64_IKC_POLLOUT  */
+/**@}*/
+
+/**
+ * @see unix64_ikc_poll()
+ */
+#define __ikc_poll(fds, nfds, timeout) unix64_ikc_poll(fds, nfds, timeout)
+
+/**@endcond*/
+
+#endif /* TARGET_UNIX64_UNIX64_POLL_H_ */
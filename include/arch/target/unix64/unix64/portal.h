@@ -73,13 +73,51 @@
      UNIX64_PORTAL_DATA_SIZE) /**< Maximum size.                  */
 /**@}*/
 
+/**
+ * @brief Number of slots in the buffer of a pair of portals.
+ *
+ * Up to this number of writes may be in flight before the receiver
+ * drains them.
+ */
+#ifndef UNIX64_PORTAL_SLOTS_NUM
+#define UNIX64_PORTAL_SLOTS_NUM 4
+#endif
+
+/**
+ * @brief Maximum number of segments in a scatter-gather operation.
+ */
+#define UNIX64_PORTAL_IOV_MAX 16
+
+/**
+ * @brief Default timeout (in milliseconds) of portal operations.
+ */
+#define UNIX64_PORTAL_TIMEOUT 5000
+
+/**
+ * @name Special timeouts.
+ */
+/**@{*/
+#define UNIX64_PORTAL_TIMEOUT_TRY 0         /**< Never block.  */
+#define UNIX64_PORTAL_TIMEOUT_INFINITE (-1) /**< Never expire. */
+/**@}*/
+
 /**
  * @name IO control requests.
  */
 /**@{*/
 #define UNIX64_PORTAL_IOCTL_SET_ASYNC_BEHAVIOR                                 \
     0 /**< Sets the wait/wakeup functions on a resource. */
-      /**@}*/
+#define UNIX64_PORTAL_IOCTL_SET_TIMEOUT                                        \
+    1 /**< Sets the timeout (in milliseconds) of a portal. */
+/**@}*/
+
+/**
+ * @brief Segment of a scatter-gather operation.
+ */
+struct portal_iovec {
+    void *base; /**< Base address. */
+    size_t len; /**< Length.       */
+};
 
 #ifdef __NANVIX_HAL
 
@@ -88,6 +126,20 @@
  */
 extern void unix64_portal_shutdown(void);
 
+/**
+ * @brief Polls a portal for readiness.
+ *
+ * @param portalid Target portal.
+ * @param events   Requested events.
+ *
+ * @returns Upon successful completion, the requested events that are
+ * ready are returned. Upon failure, a negative error code is returned
+ * instead.
+ *
+ * @note This function is non-blocking.
+ */
+extern int unix64_portal_poll(int portalid, unsigned events);
+
 #endif
 
 /**
@@ -128,6 +180,19 @@ extern int unix64_portal_allow(int portalid, int remote);
  */
 extern int unix64_portal_open(int local, int remote);
 
+/**
+ * @brief Opens a multicast portal.
+ *
+ * @param nodes  Logic IDs of the target NoC nodes. The first one is
+ * the local NoC node.
+ * @param nnodes Number of target NoC nodes.
+ *
+ * @returns Upon successful completion, the ID of the target portal
+ * is returned. Upon failure, a negative error code is returned
+ * instead.
+ */
+extern int unix64_portal_mopen(const int *nodes, int nnodes);
+
 /**
  * @brief Reads data from a portal.
  *
@@ -150,10 +215,88 @@ extern ssize_t unix64_portal_read(int portalid, void *buffer, uint64_t size);
  * @returns Upon successful completion, the number of bytes
  * successfully written is returned. Upon failure, a negative error
  * code is returned instead.
+ *
+ * @note The data is buffered in a free slot of the portal, whether or
+ * not the receiver has allowed the write.
  */
 extern ssize_t unix64_portal_write(int portalid, const void *buffer,
                                    uint64_t size);
 
+/**
+ * @brief Reads data from a portal, scattering it into segments.
+ *
+ * @param portalid ID of the target portal.
+ * @param iov      Segments where the data should be written to.
+ * @param iovcnt   Number of segments.
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+extern ssize_t unix64_portal_readv(int portalid,
+                                   const struct portal_iovec *iov, int iovcnt);
+
+/**
+ * @brief Writes data to a portal, gathering it from segments.
+ *
+ * @param portalid ID of the target portal.
+ * @param iov      Segments where the data should be read from.
+ * @param iovcnt   Number of segments.
+ *
+ * @returns Upon successful completion, the number of bytes written
+ * is returned. Upon failure, a negative error code is returned
+ * instead.
+ */
+extern ssize_t unix64_portal_writev(int portalid,
+                                    const struct portal_iovec *iov,
+                                    int iovcnt);
+
+/**
+ * @brief Gets the oldest message of a portal in place.
+ *
+ * @param portalid ID of the target portal.
+ * @param buffer   Place where the message should be stored.
+ *
+ * @returns Upon successful completion, the size of the message is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+extern ssize_t unix64_portal_peek(int portalid, void **buffer);
+
+/**
+ * @brief Hands a peeked message back to the writer.
+ *
+ * @param portalid ID of the target portal.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+extern int unix64_portal_release(int portalid);
+
+/**
+ * @brief Reads a large amount of data from a portal.
+ *
+ * @param portalid ID of the target portal.
+ * @param buffer   Buffer where the data should be written to.
+ * @param size     Number of bytes to read.
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+extern ssize_t unix64_portal_read_large(int portalid, void *buffer,
+                                        uint64_t size);
+
+/**
+ * @brief Writes a large amount of data to a portal.
+ *
+ * @param portalid ID of the target portal.
+ * @param buffer   Buffer where the data should be read from.
+ * @param size     Number of bytes to write.
+ *
+ * @returns Upon successful completion, the number of bytes written is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+extern ssize_t unix64_portal_write_large(int portalid, const void *buffer,
+                                         uint64_t size);
+
 /**
  * @brief Destroys a portal.
  *
@@ -196,6 +339,13 @@ extern int unix64_portal_ioctl(int portalid, unsigned request, va_list args);
  * @cond unix64_portal
  */
 
+/**
+ * @name Provided Structures
+ */
+/**@{*/
+#define __portal_iovec_struct /**< @ref portal_iovec */
+/**@}*/
+
 /**
  * @name Provided Functions
  */
@@ -204,11 +354,18 @@ extern int unix64_portal_ioctl(int portalid, unsigned request, va_list args);
 #define __portal_create_fn /**< portal_create() */
 #define __portal_allow_fn  /**< portal_allow()  */
 #define __portal_open_fn   /**< portal_open()   */
+#define __portal_mopen_fn  /**< portal_mopen()  */
 #define __portal_unlink_fn /**< portal_unlink() */
 #define __portal_close_fn  /**< portal_close()  */
 #define __portal_wait_fn   /**< portal_wait()   */
 #define __portal_awrite_fn /**< portal_write()  */
 #define __portal_aread_fn  /**< portal_aread()  */
+#define __portal_awrite_large_fn /**< portal_awrite_large() */
+#define __portal_aread_large_fn  /**< portal_aread_large()  */
+#define __portal_awritev_fn      /**< portal_awritev()      */
+#define __portal_areadv_fn       /**< portal_areadv()       */
+#define __portal_peek_fn         /**< portal_peek()         */
+#define __portal_release_fn      /**< portal_release()      */
 #define __portal_wait_fn   /**< portal_wait()   */
 #define __portal_ioctl_fn  /**< portal_ioctl()  */
 /**@}*/
@@ -231,6 +388,8 @@ extern int unix64_portal_ioctl(int portalid, unsigned request, va_list args);
     UNIX64_PORTAL_DATA_SIZE /**< @see UNIX64_PORTAL_DATA_SIZE     */
 #define HAL_PORTAL_MAX_SIZE                                                    \
     UNIX64_PORTAL_MAX_SIZE /**< @see UNIX64_PORTAL_MAX_SIZE      */
+#define HAL_PORTAL_IOV_MAX                                                     \
+    UNIX64_PORTAL_IOV_MAX /**< @see UNIX64_PORTAL_IOV_MAX       */
 /**@}*/
 
 /**
@@ -241,6 +400,20 @@ extern int unix64_portal_ioctl(int portalid, unsigned request, va_list args);
     UNIX64_PORTAL_IOCTL_SET_ASYNC_BEHAVIOR /**< @see                                 \
                                               UNIX64_PORTAL_IOCTL_SET_ASYNC_BEHAVIOR \
                                             */
+#define HAL_PORTAL_IOCTL_SET_TIMEOUT                                           \
+    UNIX64_PORTAL_IOCTL_SET_TIMEOUT /**< @see                                  \
+                                       UNIX64_PORTAL_IOCTL_SET_TIMEOUT        \
+                                     */
+/**@}*/
+
+/**
+ * @name Special timeouts.
+ */
+/**@{*/
+#define HAL_PORTAL_TIMEOUT_TRY                                                 \
+    UNIX64_PORTAL_TIMEOUT_TRY /**< @see UNIX64_PORTAL_TIMEOUT_TRY */
+#define HAL_PORTAL_TIMEOUT_INFINITE                                            \
+    UNIX64_PORTAL_TIMEOUT_INFINITE /**< @see UNIX64_PORTAL_TIMEOUT_INFINITE */
 /**@}*/
 
 /**
@@ -270,11 +443,50 @@ extern int unix64_portal_ioctl(int portalid, unsigned request, va_list args);
 #define __portal_awrite(portalid, buffer, size)                                \
     unix64_portal_write(portalid, buffer, size)
 
+/**
+ * @see unix64_portal_readv()
+ */
+#define __portal_areadv(portalid, iov, iovcnt)                                 \
+    unix64_portal_readv(portalid, iov, iovcnt)
+
+/**
+ * @see unix64_portal_writev()
+ */
+#define __portal_awritev(portalid, iov, iovcnt)                                \
+    unix64_portal_writev(portalid, iov, iovcnt)
+
+/**
+ * @see unix64_portal_read_large()
+ */
+#define __portal_aread_large(portalid, buffer, size)                           \
+    unix64_portal_read_large(portalid, buffer, size)
+
+/**
+ * @see unix64_portal_write_large()
+ */
+#define __portal_awrite_large(portalid, buffer, size)                          \
+    unix64_portal_write_large(portalid, buffer, size)
+
+/**
+ * @see unix64_portal_peek()
+ */
+#define __portal_peek(portalid, buffer) unix64_portal_peek(portalid, buffer)
+
+/**
+ * @see unix64_portal_release()
+ */
+#define __portal_release(portalid) unix64_portal_release(portalid)
+
 /**
  * @see unix64_portal_open()
  */
 #define __portal_open(local, remote) unix64_portal_open(local, remote)
 
+/**
+ * @see unix64_portal_mopen()
+ */
+#define __portal_mopen(nodes, nnodes) unix64_portal_mopen(nodes, nnodes)
+
 /**
  * @see unix64_portal_unlink()
  */
@@ -0,0 +1,280 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TARGET_UNIX64_UNIX64_RING_H_
+#define TARGET_UNIX64_UNIX64_RING_H_
+
+/**
+ * @addtogroup target-unix64-ring Ring
+ * @ingroup target-unix64
+ *
+ * @brief Shared-memory message ring.
+ */
+/**@{*/
+
+/* Must come first. */
+#define __NEED_CC
+
+#include <arch/target/unix64/unix64/futex.h>
+#include <nanvix/cc.h>
+#include <posix/stddef.h>
+#include <posix/stdint.h>
+#include <posix/sys/types.h>
+
+/**
+ * @name Ring parameters.
+ */
+/**@{*/
+#define UNIX64_RING_SLOTS_NUM 16  /**< Number of slots (power of two). */
+#define UNIX64_RING_DATA_SIZE 256 /**< Maximum size of a message.      */
+#define UNIX64_RING_ALIGN 64      /**< Alignment (cache line size).    */
+#define UNIX64_RING_LANES_NUM 3   /**< Number of priority lanes.       */
+/**@}*/
+
+/**
+ * @brief Ring slot.
+ *
+ * The sequence number is stored relative to the index of the slot,
+ * so that a zero-filled segment is an empty ring.
+ */
+struct unix64_ring_slot {
+    uint64_t seq;                     /**< Relative sequence number. */
+    uint64_t size;                    /**< Size of the message.      */
+    char data[UNIX64_RING_DATA_SIZE]; /**< Message.                  */
+} ALIGN(UNIX64_RING_ALIGN);
+
+/**
+ * @brief Priority lane of a ring.
+ *
+ * Producers claim slots by atomically advancing @p head and publish
+ * messages by releasing the sequence number of the slot. The single
+ * consumer advances @p tail, so no lock is taken on either side.
+ */
+struct unix64_ring_lane {
+    uint64_t head ALIGN(UNIX64_RING_ALIGN); /**< Next slot to write. */
+    uint64_t tail ALIGN(UNIX64_RING_ALIGN); /**< Next slot to read.  */
+    struct unix64_event writable;           /**< Slot released.      */
+    struct unix64_ring_slot slots[UNIX64_RING_SLOTS_NUM]; /**< Slots. */
+};
+
+/**
+ * @brief Multiple-producer single-consumer ring.
+ *
+ * Messages are FIFO within a lane, and the consumer always drains
+ * higher lanes first. Each lane has slots of its own, so that a
+ * backlog of low-priority messages never holds up a high-priority
+ * producer. All lanes share a single @p readable event, thus the
+ * consumer sleeps on one futex.
+ */
+struct unix64_ring {
+    struct unix64_event readable; /**< Message published. */
+    struct unix64_ring_lane lanes[UNIX64_RING_LANES_NUM]; /**< Lanes. */
+};
+
+#ifdef __NANVIX_HAL
+
+/**
+ * @brief Maps a ring.
+ *
+ * @param name Name of the underlying shared memory segment.
+ *
+ * @returns Upon successful completion, a pointer to the ring is
+ * returned. Upon failure, NULL is returned instead.
+ *
+ * @note The ring is created if it does not exist.
+ */
+extern struct unix64_ring *unix64_ring_map(const char *name);
+
+/**
+ * @brief Unmaps a ring.
+ *
+ * @param ring Target ring.
+ */
+extern void unix64_ring_unmap(struct unix64_ring *ring);
+
+/**
+ * @brief Removes the shared memory segment of a ring.
+ *
+ * @param name Name of the underlying shared memory segment.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+extern int unix64_ring_unlink(const char *name);
+
+/**
+ * @brief Pushes a message into a ring.
+ *
+ * @param ring Target ring.
+ * @param lane Target lane.
+ * @param buf  Message.
+ * @param n    Size of the message.
+ *
+ * @returns Upon successful completion, zero is returned. If the lane
+ * is full, -EAGAIN is returned instead.
+ *
+ * @note This function is non-blocking.
+ * @note This function is lock-free.
+ */
+extern int unix64_ring_push(struct unix64_ring *ring, int lane,
+                            const void *buf, size_t n);
+
+/**
+ * @brief Pops the most urgent message from a ring.
+ *
+ * @param ring Target ring.
+ * @param buf  Target buffer.
+ * @param n    Size of the target buffer.
+ * @param lane Place where the lane of the message should be stored.
+ *
+ * @returns Upon successful completion, the size of the message is
+ * returned. If the ring is empty, -EAGAIN is returned instead. If @p
+ * buf is too small, -EMSGSIZE is returned and the message is kept.
+ *
+ * @note This function is non-blocking.
+ * @note This function must have a single caller at a time.
+ */
+extern ssize_t unix64_ring_pop(struct unix64_ring *ring, void *buf, size_t n,
+                               int *lane);
+
+/**
+ * @brief Pushes a message into a ring, waiting for a free slot.
+ *
+ * @param ring     Target ring.
+ * @param lane     Target lane.
+ * @param buf      Message.
+ * @param n        Size of the message.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, zero is returned. If the
+ * deadline expires, -ETIMEDOUT is returned. Upon failure, a negative
+ * error code is returned instead.
+ */
+extern int unix64_ring_send(struct unix64_ring *ring, int lane,
+                            const void *buf, size_t n,
+                            const struct unix64_deadline *deadline);
+
+/**
+ * @brief Pops the most urgent message from a ring, waiting for one.
+ *
+ * @param ring     Target ring.
+ * @param buf      Target buffer.
+ * @param n        Size of the target buffer.
+ * @param lane     Place where the lane of the message should be stored.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, the size of the message is
+ * returned. If the deadline expires, -ETIMEDOUT is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note This function must have a single caller at a time.
+ */
+extern ssize_t unix64_ring_recv(struct unix64_ring *ring, void *buf, size_t n,
+                                int *lane,
+                                const struct unix64_deadline *deadline);
+
+/**
+ * @brief Reserves a free slot of a ring, waiting for one.
+ *
+ * @param ring     Target ring.
+ * @param lane     Target lane.
+ * @param pos      Place where the position of the slot should be
+ * stored.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, a pointer to the data area of
+ * the slot is returned. If the deadline expires, NULL is returned
+ * instead.
+ *
+ * @note The slot must be handed to unix64_ring_commit() afterwards.
+ */
+extern void *unix64_ring_reserve(struct unix64_ring *ring, int lane,
+                                 uint64_t *pos,
+                                 const struct unix64_deadline *deadline);
+
+/**
+ * @brief Publishes a message built in a reserved slot.
+ *
+ * @param ring Target ring.
+ * @param lane Lane of the slot.
+ * @param pos  Position of the slot.
+ * @param n    Size of the message.
+ */
+extern void unix64_ring_commit(struct unix64_ring *ring, int lane,
+                               uint64_t pos, size_t n);
+
+/**
+ * @brief Gets the most urgent message of a ring in place, waiting for
+ * one.
+ *
+ * @param ring     Target ring.
+ * @param n        Place where the size of the message should be stored.
+ * @param lane     Place where the lane of the message should be stored.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, a pointer to the message is
+ * returned. If the deadline expires, NULL is returned instead.
+ *
+ * @note The message must be handed to unix64_ring_release() afterwards.
+ * @note This function must have a single caller at a time.
+ */
+extern void *unix64_ring_peek(struct unix64_ring *ring, size_t *n, int *lane,
+                              const struct unix64_deadline *deadline);
+
+/**
+ * @brief Releases the oldest message of a lane of a ring.
+ *
+ * @param ring Target ring.
+ * @param lane Lane of the message, as got with unix64_ring_peek().
+ */
+extern void unix64_ring_release(struct unix64_ring *ring, int lane);
+
+/**
+ * @brief Asserts whether or not a ring has a message to read.
+ *
+ * @param ring Target ring.
+ *
+ * @returns Non-zero if the ring is not empty and zero otherwise.
+ *
+ * @note This function is non-blocking.
+ */
+extern int unix64_ring_is_readable(struct unix64_ring *ring);
+
+/**
+ * @brief Asserts whether or not a lane of a ring has a free slot.
+ *
+ * @param ring Target ring.
+ * @param lane Target lane.
+ *
+ * @returns Non-zero if the lane is not full and zero otherwise.
+ *
+ * @note This function is non-blocking.
+ */
+extern int unix64_ring_is_writable(struct unix64_ring *ring, int lane);
+
+#endif /* __NANVIX_HAL */
+
+/**@}*/
+
+#endif /* TARGET_UNIX64_UNIX64_RING_H_ */
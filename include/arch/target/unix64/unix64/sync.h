@@ -41,6 +41,13 @@
 
 #include <nanvix/cc.h>
 
+/**
+ * @brief Use shared-memory barriers instead of POSIX message queues?
+ */
+#ifndef __UNIX64_SYNC_USES_SHM
+#define __UNIX64_SYNC_USES_SHM 0
+#endif
+
 /**
  * @brief Type of synchronization points.
  */
@@ -72,12 +79,52 @@
  */
 #define UNIX64_SYNC_MAX (UNIX64_SYNC_CREATE_MAX + UNIX64_SYNC_OPEN_MAX)
 
+/**
+ * @brief Default timeout (in milliseconds) of signals.
+ */
+#define UNIX64_SYNC_TIMEOUT 5000
+
+/**
+ * @name Special timeouts.
+ *
+ * @note Waits default to #UNIX64_SYNC_TIMEOUT_INFINITE.
+ */
+/**@{*/
+#define UNIX64_SYNC_TIMEOUT_TRY 0         /**< Never block.  */
+#define UNIX64_SYNC_TIMEOUT_INFINITE (-1) /**< Never expire. */
+/**@}*/
+
 /**
  * @name IO control requests.
  */
 /**@{*/
 #define UNIX64_SYNC_IOCTL_SET_ASYNC_BEHAVIOR                                   \
     0 /**< Sets the wait/wakeup functions on a resource. */
+#define UNIX64_SYNC_IOCTL_SET_TIMEOUT                                          \
+    1 /**< Sets the timeout (in milliseconds) of a sync.  */
+#define UNIX64_SYNC_IOCTL_SET_ALGORITHM                                        \
+    2 /**< Sets the algorithm that propagates signals.    */
+/**@}*/
+
+/**
+ * @name Algorithms of synchronization points.
+ *
+ * Nodes of a sync are ranked with the master first and the others in
+ * increasing order of NoC node number. A broadcast flows down from the
+ * master and a gather flows up to it along the edges of the selected
+ * topology. Intermediate nodes relay broadcasts when they wait, and
+ * combine the signals of their children before they signal. All nodes
+ * of a sync should select the same algorithm before any of them
+ * signals.
+ *
+ * @note The shared-memory backend ignores the algorithm.
+ */
+/**@{*/
+#define UNIX64_SYNC_ALGORITHM_LINEAR 0 /**< Master talks to all nodes.   */
+#define UNIX64_SYNC_ALGORITHM_TREE 1   /**< Binary combining tree.       */
+#define UNIX64_SYNC_ALGORITHM_DISSEMINATION                                    \
+    2 /**< Recursive doubling: in round k, ranks below 2^k reach rank + 2^k. */
+#define UNIX64_SYNC_ALGORITHM_MAX 3 /**< Number of algorithms. */
 /**@}*/
 
 /**
@@ -101,6 +148,20 @@ extern int unix64_sync_ioctl(int syncid, unsigned request, va_list args);
  */
 extern void unix64_sync_shutdown(void);
 
+/**
+ * @brief Polls a sync for readiness.
+ *
+ * @param syncid Target sync.
+ * @param events Requested events.
+ *
+ * @returns Upon successful completion, the requested events that are
+ * ready are returned. Upon failure, a negative error code is returned
+ * instead.
+ *
+ * @note This function is non-blocking.
+ */
+extern int unix64_sync_poll(int syncid, unsigned events);
+
 #endif
 
 /**
@@ -178,6 +239,36 @@ extern int unix64_sync_wait(int syncid);
  */
 extern int unix64_sync_signal(int syncid);
 
+/**
+ * @brief Announces arrival at a synchronization point.
+ *
+ * @param syncid ID of the target synchronization point.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+extern int unix64_sync_arrive(int syncid);
+
+/**
+ * @brief Tests a split-phase synchronization point.
+ *
+ * @param syncid ID of the target synchronization point.
+ *
+ * @returns One if the split-phase operation has completed, and zero
+ * otherwise. Upon failure, a negative error code is returned instead.
+ */
+extern int unix64_sync_test(int syncid);
+
+/**
+ * @brief Awaits a split-phase synchronization point.
+ *
+ * @param syncid ID of the target synchronization point.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+extern int unix64_sync_await(int syncid);
+
 #endif /* !__NANVIX_IKC_USES_ONLY_MAILBOX */
 
 /**@}*/
@@ -202,6 +293,9 @@ extern int unix64_sync_signal(int syncid);
 #define __sync_wait_fn   /**< sync_wait()   */
 #define __sync_signal_fn /**< sync_signal() */
 #define __sync_ioctl_fn  /**< sync_ioctl()  */
+#define __sync_arrive_fn /**< sync_arrive() */
+#define __sync_test_fn   /**< sync_test()   */
+#define __sync_await_fn  /**< sync_await()  */
 /**@}*/
 
 /**
@@ -226,7 +320,35 @@ extern int unix64_sync_signal(int syncid);
     UNIX64_SYNC_IOCTL_SET_ASYNC_BEHAVIOR /**< @see                               \
                                             UNIX64_SYNC_IOCTL_SET_ASYNC_BEHAVIOR \
                                           */
-                                         /**@}*/
+#define SYNC_IOCTL_SET_TIMEOUT                                                 \
+    UNIX64_SYNC_IOCTL_SET_TIMEOUT /**< @see UNIX64_SYNC_IOCTL_SET_TIMEOUT */
+#define SYNC_IOCTL_SET_ALGORITHM                                               \
+    UNIX64_SYNC_IOCTL_SET_ALGORITHM /**< @see UNIX64_SYNC_IOCTL_SET_ALGORITHM \
+                                     */
+                                    /**@}*/
+
+/**
+ * @name Algorithms of synchronization points.
+ */
+/**@{*/
+#define SYNC_ALGORITHM_LINEAR                                                  \
+    UNIX64_SYNC_ALGORITHM_LINEAR /**< UNIX64_SYNC_ALGORITHM_LINEAR        */
+#define SYNC_ALGORITHM_TREE                                                    \
+    UNIX64_SYNC_ALGORITHM_TREE /**< UNIX64_SYNC_ALGORITHM_TREE          */
+#define SYNC_ALGORITHM_DISSEMINATION                                           \
+    UNIX64_SYNC_ALGORITHM_DISSEMINATION /**< UNIX64_SYNC_ALGORITHM_DISSEMINATION \
+                                         */
+/**@}*/
+
+/**
+ * @name Special timeouts.
+ */
+/**@{*/
+#define SYNC_TIMEOUT_TRY                                                       \
+    UNIX64_SYNC_TIMEOUT_TRY /**< @see UNIX64_SYNC_TIMEOUT_TRY */
+#define SYNC_TIMEOUT_INFINITE                                                  \
+    UNIX64_SYNC_TIMEOUT_INFINITE /**< @see UNIX64_SYNC_TIMEOUT_INFINITE */
+/**@}*/
 
 #if !__NANVIX_IKC_USES_ONLY_MAILBOX
 
@@ -272,6 +394,21 @@ extern int unix64_sync_signal(int syncid);
 #define __sync_ioctl(syncid, request, args)                                    \
     unix64_sync_ioctl(syncid, request, args)
 
+/**
+ * @see unix64_sync_arrive()
+ */
+#define __sync_arrive(syncid) unix64_sync_arrive(syncid)
+
+/**
+ * @see unix64_sync_test()
+ */
+#define __sync_test(syncid) unix64_sync_test(syncid)
+
+/**
+ * @see unix64_sync_await()
+ */
+#define __sync_await(syncid) unix64_sync_await(syncid)
+
 #endif /* !__NANVIX_IKC_USES_ONLY_MAILBOX */
 
 /**@}*/
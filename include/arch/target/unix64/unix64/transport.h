@@ -0,0 +1,184 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef TARGET_UNIX64_UNIX64_TRANSPORT_H_
+#define TARGET_UNIX64_UNIX64_TRANSPORT_H_
+
+/**
+ * @addtogroup target-unix64-transport Transport
+ * @ingroup target-unix64
+ *
+ * @brief Pluggable NoC connectors.
+ *
+ * The NoC connectors of mailboxes and syncs go through a transport.
+ * Portal buffers, doorbells and send credits of mailboxes live in the
+ * shared arena of the NoC, and shared barriers of syncs in a segment
+ * of their own. A process-local transport keeps all of them in the
+ * memory of the calling process, thus no POSIX IPC object is created,
+ * but only one cluster may boot.
+ */
+/**@{*/
+
+/* Must come first. */
+#define __NEED_CC
+
+#include <arch/target/unix64/unix64/futex.h>
+#include <arch/target/unix64/unix64/ring.h>
+#include <nanvix/cc.h>
+#include <posix/stddef.h>
+#include <posix/stdint.h>
+#include <posix/sys/types.h>
+#include <mqueue.h>
+
+/**
+ * @name Features of a transport.
+ */
+/**@{*/
+#define UNIX64_TRANSPORT_INPLACE                                               \
+    (1 << 0) /**< Messages may be built and read in place. */
+#define UNIX64_TRANSPORT_LOCAL                                                 \
+    (1 << 1) /**< Only reaches the calling process. */
+/**@}*/
+
+/**
+ * @brief NoC connector.
+ */
+union unix64_connector {
+    mqd_t fd;                 /**< Message queue. */
+    struct unix64_ring *ring; /**< Message ring.  */
+};
+
+/**
+ * @brief Transport.
+ *
+ * A transport moves messages between NoC nodes through NoC
+ * connectors, which are named after the receiving NoC node. Each
+ * message belongs to a lane, and messages of higher lanes are received
+ * first. Blocking operations take a deadline, and they return
+ * -ETIMEDOUT when it expires.
+ *
+ * Transports that feature UNIX64_TRANSPORT_INPLACE provide
+ * reserve(), commit(), peek() and release(), and their recv() keeps a
+ * message that does not fit in the target buffer, failing with
+ * -EMSGSIZE. Other transports leave these operations NULL, and their
+ * recv() takes buffers of UNIX64_MAILBOX_MSG_SIZE_MAX bytes.
+ */
+struct unix64_transport {
+    const char *name; /**< Name.                                 */
+    unsigned flags;   /**< Features.                             */
+    int depth;        /**< Messages per lane of a NoC connector. */
+
+    /**
+     * @brief Opens a NoC connector.
+     */
+    int (*connect)(union unix64_connector *conn, const char *name, int flags);
+
+    /**
+     * @brief Closes a NoC connector.
+     */
+    void (*disconnect)(union unix64_connector *conn);
+
+    /**
+     * @brief Removes a NoC connector from the system.
+     */
+    int (*unlink)(const char *name);
+
+    /**
+     * @brief Sends a message.
+     */
+    int (*send)(union unix64_connector *conn, int lane, const void *buf,
+                size_t n, const struct unix64_deadline *deadline);
+
+    /**
+     * @brief Receives the most urgent message.
+     */
+    ssize_t (*recv)(union unix64_connector *conn, void *buf, size_t n,
+                    int *lane, const struct unix64_deadline *deadline);
+
+    /**
+     * @brief Reserves room for a message in place.
+     */
+    void *(*reserve)(union unix64_connector *conn, int lane, uint64_t *pos,
+                     const struct unix64_deadline *deadline);
+
+    /**
+     * @brief Sends a message built in reserved room.
+     */
+    void (*commit)(union unix64_connector *conn, int lane, uint64_t pos,
+                   size_t n);
+
+    /**
+     * @brief Gets the most urgent message in place.
+     */
+    void *(*peek)(union unix64_connector *conn, size_t *n, int *lane,
+                  const struct unix64_deadline *deadline);
+
+    /**
+     * @brief Consumes a message got in place.
+     */
+    void (*release)(union unix64_connector *conn, int lane);
+
+    /**
+     * @brief Asserts whether or not there is a message to read.
+     */
+    int (*is_readable)(union unix64_connector *conn);
+
+    /**
+     * @brief Asserts whether or not a lane has room for a message.
+     */
+    int (*is_writable)(union unix64_connector *conn, int lane);
+
+    /**
+     * @brief Counts the messages that fit in all lanes together.
+     */
+    int (*room)(union unix64_connector *conn);
+};
+
+#ifdef __NANVIX_HAL
+
+/**
+ * @brief Selects the transport of NoC connectors.
+ *
+ * @param name Name of the target transport.
+ *
+ * @returns Upon successful completion, zero is returned. If there is
+ * no transport named @p name, -EINVAL is returned instead.
+ *
+ * @note This function should be called at boot, before any NoC
+ * connector is opened, and all processes must agree on the transport.
+ */
+extern int unix64_transport_select(const char *name);
+
+/**
+ * @brief Gets the transport of NoC connectors.
+ *
+ * @returns The selected transport.
+ */
+extern const struct unix64_transport *unix64_transport_get(void);
+
+#endif /* __NANVIX_HAL */
+
+/**@}*/
+
+#endif /* TARGET_UNIX64_UNIX64_TRANSPORT_H_ */
@@ -0,0 +1,170 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NANVIX_HAL_SPINWAIT_H_
+#define NANVIX_HAL_SPINWAIT_H_
+
+/* Core Interface Implementation */
+#include <nanvix/hal/core/_core.h>
+
+/*============================================================================*
+ * Spin Wait Interface                                                        *
+ *============================================================================*/
+
+/**
+ * @addtogroup kernel-hal-core-spinwait Spin Wait
+ * @ingroup kernel-hal-core
+ *
+ * @brief Spin-Then-Park Wait Policy
+ *
+ * A waiter first spins for a bounded number of rounds, relaxing the
+ * core in between, then yields the core for a bounded number of
+ * rounds, and finally asks the caller to park on whatever wakeup
+ * primitive guards the awaited condition. Short waits thus never
+ * sleep, while long waits do not burn a core that could be running
+ * the thread that is being waited for.
+ */
+/**@{*/
+
+#include <nanvix/const.h>
+
+/**
+ * @brief Maintain counters of call sites?
+ */
+#ifndef __NANVIX_HAL_SPINWAIT_STATS
+#define __NANVIX_HAL_SPINWAIT_STATS 0
+#endif
+
+/**
+ * @name Wait Policy
+ */
+/**@{*/
+#define SPINWAIT_SPINS 64 /**< Rounds spent spinning before yielding. */
+#define SPINWAIT_YIELDS 8 /**< Rounds spent yielding before parking.  */
+/**@}*/
+
+/**
+ * @brief Counters of a call site.
+ *
+ * Call sites own their counters, which are statically allocated and
+ * updated atomically. A call site is listed on its first wait, so
+ * that spinwait_report() finds it.
+ */
+struct spinwait_stats {
+    const char *name;             /**< Name of the call site.   */
+    unsigned spins;               /**< Rounds spent spinning.   */
+    unsigned yields;              /**< Rounds spent yielding.   */
+    unsigned parks;               /**< Rounds spent parked.     */
+    int listed;                   /**< Listed for reporting?    */
+    struct spinwait_stats *next;  /**< Next listed call site.   */
+};
+
+/**
+ * @brief Static initializer for the counters of a call site.
+ *
+ * @param x Name of the call site.
+ */
+#define SPINWAIT_STATS_INITIALIZER(x)                                          \
+    {                                                                          \
+        (x), 0, 0, 0, 0, NULL                                                  \
+    }
+
+/**
+ * @brief Waiter.
+ */
+struct spinwait {
+    unsigned round;               /**< Current round.           */
+    struct spinwait_stats *stats; /**< Counters of the call site. */
+};
+
+/**
+ * @brief Relaxes the underlying core in a spin loop.
+ */
+static inline void spinwait_pause(void)
+{
+#ifdef __spinwait_pause_fn
+    __spinwait_pause();
+#else
+    noop();
+#endif
+}
+
+/**
+ * @brief Yields the underlying core.
+ *
+ * @note On cores that are not shared with other threads, this is the
+ * same as spinwait_pause().
+ */
+static inline void spinwait_yield(void)
+{
+#ifdef __spinwait_yield_fn
+    __spinwait_yield();
+#else
+    spinwait_pause();
+#endif
+}
+
+/**
+ * @brief Initializes a waiter.
+ *
+ * @param waiter Target waiter.
+ * @param stats  Counters of the call site.
+ */
+EXTERN void spinwait_init(struct spinwait *waiter,
+                          struct spinwait_stats *stats);
+
+/**
+ * @brief Waits for one round.
+ *
+ * @param waiter Target waiter.
+ *
+ * @returns Zero if the round was spent spinning or yielding, and
+ * non-zero if the caller should park instead.
+ *
+ * @note The caller should check the awaited condition in between
+ * rounds.
+ */
+EXTERN int spinwait_once(struct spinwait *waiter);
+
+/**
+ * @brief Waits for one round, without ever parking.
+ *
+ * @param waiter Target waiter.
+ *
+ * @note This is meant for callers that have nothing to park on, thus
+ * rounds that would be spent parked are spent yielding instead.
+ */
+EXTERN void spinwait_relax(struct spinwait *waiter);
+
+/**
+ * @brief Reports the counters of every call site that waited.
+ *
+ * @note This is a no-op unless __NANVIX_HAL_SPINWAIT_STATS is set.
+ * @note This should be called once, on shutdown.
+ */
+EXTERN void spinwait_report(void);
+
+/**@}*/
+
+#endif /* NANVIX_HAL_SPINWAIT_H_ */
@@ -61,6 +61,8 @@
 #include <nanvix/hal/target/sync.h>
 #include <nanvix/hal/target/mailbox.h>
 #include <nanvix/hal/target/portal.h>
+#include <nanvix/hal/target/poll.h>
+#include <nanvix/hal/target/coalesce.h>
 
 /**
  * @name Functions to wait/wakeup for a comm resource.
@@ -0,0 +1,241 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef NANVIX_HAL_TARGET_COALESCE_H_
+#define NANVIX_HAL_TARGET_COALESCE_H_
+
+/* Target Interface Implementation */
+#include <nanvix/hal/target/_target.h>
+
+#include <nanvix/hal/target/mailbox.h>
+#include <nanvix/hal/target/portal.h>
+
+/**
+ * @brief Does the target feature message coalescing?
+ *
+ * Coalescing is built on top of the mailbox and portal interfaces,
+ * thus it is available on targets that feature both.
+ */
+#define __HAL_HAS_COALESCE                                                     \
+    (__TARGET_HAS_MAILBOX && __TARGET_HAS_PORTAL &&                            \
+     !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+/*============================================================================*
+ * Constants                                                                  *
+ *============================================================================*/
+
+#if (__HAL_HAS_COALESCE)
+
+/**
+ * @name Coalescing parameters.
+ */
+/**@{*/
+#define COALESCE_CREATE_MAX HAL_MAILBOX_CREATE_MAX /**< Input endpoints.  */
+#define COALESCE_OPEN_MAX HAL_MAILBOX_OPEN_MAX     /**< Output endpoints. */
+#define COALESCE_MSGS_MAX                                                      \
+    ((int)(HAL_PORTAL_DATA_SIZE /                                              \
+           HAL_MAILBOX_MSG_SIZE)) /**< Messages per batch. */
+#define COALESCE_DELAY_DEFAULT 1 /**< Default delay (in milliseconds). */
+/**@}*/
+
+#else
+
+#define COALESCE_CREATE_MAX 1
+#define COALESCE_OPEN_MAX 1
+#define COALESCE_MSGS_MAX 1
+#define COALESCE_DELAY_DEFAULT 0
+
+#endif /* __HAL_HAS_COALESCE */
+
+/**
+ * @name Coalescing control requests.
+ */
+/**@{*/
+#define COALESCE_IOCTL_SET_THRESHOLD 0 /**< Set size threshold. */
+#define COALESCE_IOCTL_SET_DELAY 1     /**< Set time threshold. */
+/**@}*/
+
+/**
+ * @brief Batch announcement.
+ *
+ * A batch of messages is sent as a single portal transfer, which is
+ * announced to the receiver by a mailbox message that holds only this
+ * header. Plain messages are HAL_MAILBOX_MSG_SIZE bytes long, thus the
+ * size of the mailbox message tells them apart, whatever their data.
+ */
+struct coalesce_header {
+    uint32_t source; /**< Sender NoC node.             */
+    uint32_t nmsgs;  /**< Number of messages in batch. */
+};
+
+/*============================================================================*
+ * Provided Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @defgroup kernel-hal-target-coalesce Coalescing service
+ * @ingroup kernel-hal-target
+ *
+ * @brief Mailbox Message Coalescing HAL Interface
+ *
+ * A coalesced output mailbox buffers outgoing messages and sends them
+ * to the receiver in batches, each one as a single portal transfer.
+ * A coalesced input mailbox unpacks the batches back into individual
+ * messages, and passes plain mailbox messages through unchanged.
+ */
+/**@{*/
+
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Creates a coalesced input mailbox.
+ *
+ * @param local Logic ID of the local NoC node.
+ *
+ * @returns Upon successful completion, the ID of the newly created
+ * mailbox is returned. Upon failure, a negative error code is
+ * returned instead.
+ *
+ * @note The input portal of @p local is owned by the mailbox.
+ */
+EXTERN int coalesce_create(int local);
+
+/**
+ * @brief Opens a coalesced output mailbox.
+ *
+ * @param remote Logic ID of the target NoC node.
+ *
+ * @returns Upon successful completion, the ID of the newly opened
+ * mailbox is returned. Upon failure, a negative error code is
+ * returned instead.
+ *
+ * @note The output portal to @p remote is owned by the mailbox.
+ */
+EXTERN int coalesce_open(int remote);
+
+/**
+ * @brief Destroys a coalesced input mailbox.
+ *
+ * @param mbxid ID of the target mailbox.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note Messages of a batch that were not read yet are discarded.
+ */
+EXTERN int coalesce_unlink(int mbxid);
+
+/**
+ * @brief Closes a coalesced output mailbox.
+ *
+ * @param mbxid ID of the target mailbox.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note Buffered messages are flushed before the mailbox is closed.
+ */
+EXTERN int coalesce_close(int mbxid);
+
+/**
+ * @brief Writes a message to a coalesced output mailbox.
+ *
+ * @param mbxid  ID of the target mailbox.
+ * @param buffer Buffer where the data should be read from.
+ * @param size   Number of bytes to write (HAL_MAILBOX_MSG_SIZE).
+ *
+ * @returns Upon successful completion, the number of bytes written is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note The message is buffered, and buffered messages are flushed
+ * once the size threshold is hit or the oldest of them is older than
+ * the time threshold. The time threshold is checked by this function,
+ * coalesce_aread(), ikc_poll() and coalesce_sweep(), thus a sender
+ * that does none of them for a while should call coalesce_flush().
+ */
+EXTERN ssize_t coalesce_awrite(int mbxid, const void *buffer, uint64_t size);
+
+/**
+ * @brief Reads a message from a coalesced input mailbox.
+ *
+ * @param mbxid  ID of the target mailbox.
+ * @param buffer Buffer where the data should be written to.
+ * @param size   Number of bytes to read (HAL_MAILBOX_MSG_SIZE).
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note While waiting for a message, output mailboxes that hit the
+ * time threshold are flushed, thus the wait may overrun the timeout
+ * of the mailbox by the time threshold.
+ */
+EXTERN ssize_t coalesce_aread(int mbxid, void *buffer, uint64_t size);
+
+/**
+ * @brief Flushes the buffered messages of a coalesced output mailbox.
+ *
+ * @param mbxid ID of the target mailbox.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+EXTERN int coalesce_flush(int mbxid);
+
+/**
+ * @brief Flushes the coalesced output mailboxes that hit the time
+ * threshold.
+ *
+ * @returns The number of milliseconds until the next buffered message
+ * hits the time threshold, or zero if no message is left buffered.
+ */
+EXTERN int coalesce_sweep(void);
+
+/**
+ * @brief Performs control operations in a coalesced output mailbox.
+ *
+ * @param mbxid   Target mailbox.
+ * @param request Request.
+ * @param ...     Additional arguments.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note A COALESCE_IOCTL_SET_THRESHOLD request takes the number of
+ * buffered messages (at most COALESCE_MSGS_MAX) that triggers a
+ * flush. A COALESCE_IOCTL_SET_DELAY request takes the age (in
+ * milliseconds) of the oldest buffered message that triggers a flush.
+ */
+EXTERN int coalesce_ioctl(int mbxid, unsigned request, ...);
+
+/**
+ * @brief Initializes the coalescing interface.
+ */
+EXTERN void coalesce_setup(void);
+
+/**@}*/
+
+#endif /* NANVIX_HAL_TARGET_COALESCE_H_ */
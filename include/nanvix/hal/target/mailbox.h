@@ -59,6 +59,9 @@
 #ifndef HAL_MAILBOX_MSG_SIZE
 #error "HAL_MAILBOX_MSG_SIZE not defined"
 #endif
+#ifndef HAL_MAILBOX_MSG_SIZE_MAX
+#error "HAL_MAILBOX_MSG_SIZE_MAX not defined"
+#endif
 #ifndef HAL_MAILBOX_RESERVED_SIZE
 #error "HAL_MAILBOX_RESERVED_SIZE not defined"
 #endif
@@ -91,6 +94,24 @@
 #ifndef __mailbox_aread_fn
 #error "mailbox_aread() not defined?"
 #endif
+#ifndef __mailbox_awritev_fn
+#error "mailbox_awritev() not defined?"
+#endif
+#ifndef __mailbox_areadv_fn
+#error "mailbox_areadv() not defined?"
+#endif
+#ifndef __mailbox_reserve_fn
+#error "mailbox_reserve() not defined?"
+#endif
+#ifndef __mailbox_commit_fn
+#error "mailbox_commit() not defined?"
+#endif
+#ifndef __mailbox_peek_fn
+#error "mailbox_peek() not defined?"
+#endif
+#ifndef __mailbox_release_fn
+#error "mailbox_release() not defined?"
+#endif
 #ifndef __mailbox_wait_fn
 #error "mailbox_wait() not defined?"
 #endif
@@ -110,7 +131,17 @@
 #define HAL_MAILBOX_OPEN_MAX 1
 #define HAL_MAILBOX_OPEN_OFFSET 0
 #define HAL_MAILBOX_MSG_SIZE 1
+#define HAL_MAILBOX_MSG_SIZE_MAX 1
 #define HAL_MAILBOX_IOCTL_SET_ASYNC_BEHAVIOR 0
+#define HAL_MAILBOX_IOCTL_SET_TIMEOUT 1
+#define HAL_MAILBOX_IOCTL_SET_PRIORITY 2
+#define HAL_MAILBOX_IOCTL_SET_CREDITS 3
+#define HAL_MAILBOX_IOCTL_GET_CREDITS 4
+#define HAL_MAILBOX_TIMEOUT_TRY 0
+#define HAL_MAILBOX_TIMEOUT_INFINITE (-1)
+#define HAL_MAILBOX_PRIORITY_LOW 0
+#define HAL_MAILBOX_PRIORITY_NORMAL 1
+#define HAL_MAILBOX_PRIORITY_HIGH 2
 
 #endif /* !__TARGET_HAS_MAILBOX */
 
@@ -179,8 +210,11 @@ EXTERN int mailbox_close(int mbxid);
  * @param buffer Buffer where the data should be read from.
  * @param size   Number of bytes to write.
  *
- * @returns Upon successful completion, 0 is returned
- * and non zero otherwise.
+ * @returns Upon successful completion, the number of bytes written is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note A message may be of any size up to HAL_MAILBOX_MSG_SIZE_MAX
+ * bytes, and only @p size bytes are sent.
  */
 EXTERN ssize_t mailbox_awrite(int mbxid, const void *buffer, uint64_t size);
 
@@ -189,13 +223,104 @@ EXTERN ssize_t mailbox_awrite(int mbxid, const void *buffer, uint64_t size);
  *
  * @param mbxid  ID of the target mailbox.
  * @param buffer Buffer where the data should be written to.
- * @param size   Number of bytes to read.
+ * @param size   Size of the target buffer.
+ *
+ * @returns Upon successful completion, the size of the message read is
+ * returned. Upon failure, a negative error code is returned instead.
  *
- * @returns Upon successful completion, 0 is returned
- * and non zero otherwise.
+ * @note If the message is larger than @p size, -EMSGSIZE is returned
+ * and the message is kept for a subsequent read with a larger buffer.
  */
 EXTERN ssize_t mailbox_aread(int mbxid, void *buffer, uint64_t size);
 
+/**
+ * @brief Writes a batch of messages to a mailbox.
+ *
+ * @param mbxid  ID of the target mailbox.
+ * @param buffer Buffer where the messages should be read from.
+ * @param nmsgs  Number of messages to write.
+ *
+ * @returns Upon successful completion, the number of messages written
+ * is returned, which may be less than @p nmsgs. Upon failure, a
+ * negative error code is returned instead.
+ *
+ * @note Messages are HAL_MAILBOX_MSG_SIZE bytes long and are laid
+ * out contiguously in @p buffer.
+ * @note If writing fails after some messages were written, their count
+ * is returned, and the error is returned by the next call on the
+ * mailbox.
+ */
+EXTERN int mailbox_awritev(int mbxid, const void *buffer, int nmsgs);
+
+/**
+ * @brief Reads a batch of messages from a mailbox.
+ *
+ * @param mbxid  ID of the target mailbox.
+ * @param buffer Buffer where the messages should be written to.
+ * @param nmsgs  Maximum number of messages to read.
+ *
+ * @returns Upon successful completion, the number of messages read
+ * is returned, which may be less than @p nmsgs. Upon failure, a
+ * negative error code is returned instead.
+ *
+ * @note Messages are HAL_MAILBOX_MSG_SIZE bytes long and are laid
+ * out contiguously in @p buffer.
+ * @note If reading fails after some messages were read, their count is
+ * returned, and the error is returned by the next call on the mailbox.
+ * @note A message shorter than HAL_MAILBOX_MSG_SIZE ends the batch and
+ * is left in the mailbox. If it comes first, -EMSGSIZE is returned,
+ * and mailbox_aread() should be used to receive it.
+ */
+EXTERN int mailbox_areadv(int mbxid, void *buffer, int nmsgs);
+
+/**
+ * @brief Reserves room for a message in a mailbox.
+ *
+ * @param mbxid  ID of the target mailbox.
+ * @param buffer Place where the reserved room should be stored.
+ *
+ * @returns Upon successful completion, zero is returned and @p buffer
+ * points to HAL_MAILBOX_MSG_SIZE bytes where the message should be
+ * built. Upon failure, a negative error code is returned instead.
+ *
+ * @note The mailbox stays busy until mailbox_commit() is called.
+ */
+EXTERN int mailbox_reserve(int mbxid, void **buffer);
+
+/**
+ * @brief Sends the message reserved with mailbox_reserve().
+ *
+ * @param mbxid ID of the target mailbox.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+EXTERN int mailbox_commit(int mbxid);
+
+/**
+ * @brief Gets the oldest message of a mailbox in place.
+ *
+ * @param mbxid  ID of the target mailbox.
+ * @param buffer Place where the message should be stored.
+ *
+ * @returns Upon successful completion, the size of the message is
+ * returned and @p buffer points to it. Upon failure, a negative error
+ * code is returned instead.
+ *
+ * @note The mailbox stays busy until mailbox_release() is called.
+ */
+EXTERN ssize_t mailbox_peek(int mbxid, void **buffer);
+
+/**
+ * @brief Consumes the message got with mailbox_peek().
+ *
+ * @param mbxid ID of the target mailbox.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+EXTERN int mailbox_release(int mbxid);
+
 /**
  * @brief Waits asynchronous operation.
  *
@@ -214,6 +339,19 @@ EXTERN int mailbox_wait(int mbxid);
  *
  * @param Upon successful completion, zero is returned. Upon failure,
  * a negative error code is returned instead.
+ *
+ * @note A HAL_MAILBOX_IOCTL_SET_TIMEOUT request takes a timeout in
+ * milliseconds. With HAL_MAILBOX_TIMEOUT_TRY, blocking operations fail
+ * with -ETIMEDOUT instead of blocking, and with
+ * HAL_MAILBOX_TIMEOUT_INFINITE they never time out.
+ * @note A HAL_MAILBOX_IOCTL_SET_PRIORITY request takes the priority
+ * class of the messages that an output mailbox sends afterwards.
+ * Messages of a higher class are received first.
+ * @note A HAL_MAILBOX_IOCTL_SET_CREDITS request takes the number of
+ * messages per priority class that an input mailbox lets senders have
+ * in flight. A HAL_MAILBOX_IOCTL_GET_CREDITS request takes a pointer
+ * to where the number of messages that an output mailbox may send
+ * without blocking should be stored.
  */
 EXTERN int mailbox_ioctl(int mbxid, unsigned request, ...);
 
@@ -0,0 +1,143 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef NANVIX_HAL_TARGET_POLL_H_
+#define NANVIX_HAL_TARGET_POLL_H_
+
+/* Target Interface Implementation */
+#include <nanvix/hal/target/_target.h>
+
+/*============================================================================*
+ * Interface Implementation Checking                                          *
+ *============================================================================*/
+
+#if defined(__INTERFACE_CHECK) || defined(__INTERFACE_CHECK_TARGET_AL) ||      \
+    defined(__INTERFACE_CHECK_POLL)
+
+/* Feature Checking */
+#ifndef __TARGET_HAS_POLL
+#error "does this target feature a poll interface?"
+#endif
+
+/* Has Poll Interface */
+#if (__TARGET_HAS_POLL)
+
+/* Constants */
+#ifndef IKC_POLL_MAX
+#error "IKC_POLL_MAX not defined"
+#endif
+#ifndef IKC_MAILBOX
+#error "IKC_MAILBOX not defined"
+#endif
+#ifndef IKC_PORTAL
+#error "IKC_PORTAL not defined"
+#endif
+#ifndef IKC_SYNC
+#error "IKC_SYNC not defined"
+#endif
+#ifndef IKC_POLLIN
+#error "IKC_POLLIN not defined"
+#endif
+#ifndef IKC_POLLOUT
+#error "IKC_POLLOUT not defined"
+#endif
+
+/* Structures */
+#ifndef __ikc_pollfd_struct
+#error "struct ikc_pollfd not defined?"
+#endif
+
+/* Functions */
+#ifndef __ikc_poll_fn
+#error "ikc_poll() not defined?"
+#endif
+
+#endif
+
+#endif
+
+/* Dummy Constants */
+#if (!__TARGET_HAS_POLL)
+
+#define IKC_POLL_MAX 1
+#define IKC_MAILBOX 0
+#define IKC_PORTAL 1
+#define IKC_SYNC 2
+#define IKC_POLLIN (1 << 0)
+#define IKC_POLLOUT (1 << 1)
+
+/**
+ * @brief Dummy polled endpoint.
+ */
+struct ikc_pollfd {
+    int type;         /**< Type of endpoint. */
+    int id;           /**< ID of endpoint.   */
+    unsigned events;  /**< Requested events. */
+    unsigned revents; /**< Returned events.  */
+};
+
+#endif /* !__TARGET_HAS_POLL */
+
+/*============================================================================*
+ * Provided Interface                                                         *
+ *============================================================================*/
+
+/**
+ * @defgroup kernel-hal-target-poll Poll service
+ * @ingroup kernel-hal-target
+ *
+ * @brief Target Poll HAL Interface
+ */
+/**@{*/
+
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+
+/**
+ * @brief Waits for some IKC endpoints to become ready.
+ *
+ * @param fds     Target endpoints. Each one is a mailbox, portal or
+ * sync, and the IKC_POLLIN and IKC_POLLOUT events select whether it
+ * is an input or an output endpoint.
+ * @param nfds    Number of target endpoints (at most IKC_POLL_MAX).
+ * @param timeout Timeout (in milliseconds).
+ *
+ * @returns Upon successful completion, the number of ready endpoints
+ * is returned, and the revents field of each endpoint is set. If the
+ * timeout expires, zero is returned. Upon failure, a negative error
+ * code is returned instead.
+ *
+ * @note A zero @p timeout only checks the endpoints, and a negative
+ * one never expires.
+ * @note An endpoint reported as ready may be consumed by a concurrent
+ * thread before the caller gets to it.
+ * @note Coalesced output mailboxes that hit their time threshold are
+ * flushed before waiting.
+ */
+EXTERN int ikc_poll(struct ikc_pollfd *fds, int nfds, int timeout);
+
+/**@}*/
+
+#endif /* NANVIX_HAL_TARGET_POLL_H_ */
@@ -65,10 +65,18 @@
 #ifndef HAL_PORTAL_MAX_SIZE
 #error "HAL_PORTAL_MAX_SIZE not defined"
 #endif
+#ifndef HAL_PORTAL_IOV_MAX
+#error "HAL_PORTAL_IOV_MAX not defined"
+#endif
 #ifndef HAL_PORTAL_IOCTL_SET_ASYNC_BEHAVIOR
 #error "HAL_PORTAL_IOCTL_SET_ASYNC_BEHAVIOR not defined"
 #endif
 
+/* Structures */
+#ifndef __portal_iovec_struct
+#error "struct portal_iovec not defined?"
+#endif
+
 /* Functions */
 #ifndef __portal_setup_fn
 #error "portal_setup() not defined?"
@@ -82,6 +90,9 @@
 #ifndef __portal_open_fn
 #error "portal_open() not defined?"
 #endif
+#ifndef __portal_mopen_fn
+#error "portal_mopen() not defined?"
+#endif
 #ifndef __portal_unlink_fn
 #error "portal_unlink() not defined?"
 #endif
@@ -94,6 +105,24 @@
 #ifndef __portal_aread_fn
 #error "portal_aread() not defined?"
 #endif
+#ifndef __portal_awrite_large_fn
+#error "portal_awrite_large() not defined?"
+#endif
+#ifndef __portal_aread_large_fn
+#error "portal_aread_large() not defined?"
+#endif
+#ifndef __portal_awritev_fn
+#error "portal_awritev() not defined?"
+#endif
+#ifndef __portal_areadv_fn
+#error "portal_areadv() not defined?"
+#endif
+#ifndef __portal_peek_fn
+#error "portal_peek() not defined?"
+#endif
+#ifndef __portal_release_fn
+#error "portal_release() not defined?"
+#endif
 #ifndef __portal_wait_fn
 #error "portal_wait() not defined?"
 #endif
@@ -113,7 +142,19 @@
 #define HAL_PORTAL_OPEN_MAX 1
 #define HAL_PORTAL_OPEN_OFFSET 0
 #define HAL_PORTAL_MAX_SIZE 1
+#define HAL_PORTAL_IOV_MAX 1
 #define HAL_PORTAL_IOCTL_SET_ASYNC_BEHAVIOR 0
+#define HAL_PORTAL_IOCTL_SET_TIMEOUT 1
+#define HAL_PORTAL_TIMEOUT_TRY 0
+#define HAL_PORTAL_TIMEOUT_INFINITE (-1)
+
+/**
+ * @brief Dummy segment of a scatter-gather operation.
+ */
+struct portal_iovec {
+    void *base; /**< Base address. */
+    size_t len; /**< Length.       */
+};
 
 #endif /* !__TARGET_HAS_PORTAL */
 
@@ -155,6 +196,22 @@ EXTERN int portal_create(int nodenum);
  */
 EXTERN int portal_open(int localnum, int remotenum);
 
+/**
+ * @brief Opens a multicast portal.
+ *
+ * @param nodes  Logic IDs of the target NoC nodes. The first one is
+ * the local node, and the others are the receivers.
+ * @param nnodes Number of target NoC nodes.
+ *
+ * @returns Upon successful completion, the ID of the newly opened
+ * portal is returned. Upon failure, a negative error code is returned
+ * instead.
+ *
+ * @note Data written to the portal is copied once and delivered to
+ * all receivers, which read it as if it came from a regular portal.
+ */
+EXTERN int portal_mopen(const int *nodes, int nnodes);
+
 /**
  * @brief Allows remote writes in a portal.
  *
@@ -163,6 +220,9 @@ EXTERN int portal_open(int localnum, int remotenum);
  *
  * @reutrns Upon successful completion, zero is returned. Upon
  * failure, a negative error code is returned instead.
+ *
+ * @note An allow enables the next read from @p nodenum. It does not
+ * gate writes, which are buffered until read.
  */
 EXTERN int portal_allow(int portalid, int nodenum);
 
@@ -196,6 +256,9 @@ EXTERN int portal_close(int portalid);
  * @returns Upon successful completion, the number of bytes
  * successfully written is returned. Upon failure, a negative error
  * code is returned instead.
+ *
+ * @note The receiver need not have allowed the write beforehand. The
+ * write only fails with -EBUSY if the portal has no room left.
  */
 EXTERN ssize_t portal_awrite(int portalid, const void *buffer, uint64_t size);
 
@@ -211,6 +274,94 @@ EXTERN ssize_t portal_awrite(int portalid, const void *buffer, uint64_t size);
  */
 EXTERN ssize_t portal_aread(int portalid, void *buffer, uint64_t size);
 
+/**
+ * @brief Writes a large amount of data to a portal.
+ *
+ * @param portalid ID of the target portal.
+ * @param buffer   Buffer where the data should be read from.
+ * @param size     Number of bytes to write.
+ *
+ * @returns Upon successful completion, the number of bytes written is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note The data is streamed in chunks of HAL_PORTAL_MAX_SIZE bytes,
+ * and the receiver should read it with portal_aread_large() using the
+ * same @p size.
+ */
+EXTERN ssize_t portal_awrite_large(int portalid, const void *buffer,
+                                   uint64_t size);
+
+/**
+ * @brief Reads a large amount of data from a portal.
+ *
+ * @param portalid ID of the target portal.
+ * @param buffer   Buffer where the data should be written to.
+ * @param size     Number of bytes to read.
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, a negative error code is returned instead.
+ *
+ * @note A single portal_allow() enables the whole transfer.
+ * @note If the transfer fails, the next call with the same @p buffer
+ * and @p size resumes it where it stopped.
+ */
+EXTERN ssize_t portal_aread_large(int portalid, void *buffer, uint64_t size);
+
+/**
+ * @brief Writes data to a portal, gathering it from segments.
+ *
+ * @param portalid ID of the target portal.
+ * @param iov      Segments where the data should be read from.
+ * @param iovcnt   Number of segments (at most HAL_PORTAL_IOV_MAX).
+ *
+ * @returns Upon successful completion, the number of bytes written
+ * is returned. Upon failure, a negative error code is returned
+ * instead.
+ *
+ * @note The segments are sent as a single message, thus their total
+ * length may not exceed HAL_PORTAL_MAX_SIZE.
+ */
+EXTERN ssize_t portal_awritev(int portalid, const struct portal_iovec *iov,
+                              int iovcnt);
+
+/**
+ * @brief Reads data from a portal, scattering it into segments.
+ *
+ * @param portalid ID of the target portal.
+ * @param iov      Segments where the data should be written to.
+ * @param iovcnt   Number of segments (at most HAL_PORTAL_IOV_MAX).
+ *
+ * @returns Upon successful completion, the number of bytes read is
+ * returned. Upon failure, a negative error code is returned instead.
+ */
+EXTERN ssize_t portal_areadv(int portalid, const struct portal_iovec *iov,
+                             int iovcnt);
+
+/**
+ * @brief Gets the oldest message of a portal in place.
+ *
+ * @param portalid ID of the target portal.
+ * @param buffer   Place where the message should be stored.
+ *
+ * @returns Upon successful completion, the size of the message is
+ * returned and @p buffer points to it, inside the portal buffer
+ * shared with the writer. Upon failure, a negative error code is
+ * returned instead.
+ *
+ * @note The portal stays busy until portal_release() is called.
+ */
+EXTERN ssize_t portal_peek(int portalid, void **buffer);
+
+/**
+ * @brief Hands the message got with portal_peek() back to the writer.
+ *
+ * @param portalid ID of the target portal.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+EXTERN int portal_release(int portalid);
+
 /**
  * @brief Waits asynchronous operation.
  *
@@ -229,6 +380,11 @@ EXTERN int portal_wait(int portalid);
  *
  * @param Upon successful completion, zero is returned. Upon failure,
  * a negative error code is returned instead.
+ *
+ * @note A HAL_PORTAL_IOCTL_SET_TIMEOUT request takes a timeout in
+ * milliseconds. With HAL_PORTAL_TIMEOUT_TRY, blocking operations fail
+ * with -ETIMEDOUT instead of blocking, and with
+ * HAL_PORTAL_TIMEOUT_INFINITE they never time out.
  */
 EXTERN int portal_ioctl(int syncid, unsigned request, ...);
 
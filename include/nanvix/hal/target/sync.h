@@ -91,6 +91,15 @@
 #ifndef __sync_ioctl_fn
 #error "sync_ioctl() not defined?"
 #endif
+#ifndef __sync_arrive_fn
+#error "sync_arrive() not defined?"
+#endif
+#ifndef __sync_test_fn
+#error "sync_test() not defined?"
+#endif
+#ifndef __sync_await_fn
+#error "sync_await() not defined?"
+#endif
 
 #endif
 
@@ -106,6 +115,13 @@
 #define SYNC_OPEN_MAX 1
 #define SYNC_OPEN_OFFSET SYNC_CREATE_MAX
 #define SYNC_IOCTL_SET_ASYNC_BEHAVIOR 0
+#define SYNC_IOCTL_SET_TIMEOUT 1
+#define SYNC_IOCTL_SET_ALGORITHM 2
+#define SYNC_ALGORITHM_LINEAR 0
+#define SYNC_ALGORITHM_TREE 1
+#define SYNC_ALGORITHM_DISSEMINATION 2
+#define SYNC_TIMEOUT_TRY 0
+#define SYNC_TIMEOUT_INFINITE (-1)
 
 #endif /* !__TARGET_HAS_SYNC */
 
@@ -196,9 +212,50 @@ EXTERN int sync_signal(int syncid);
  *
  * @param Upon successful completion, zero is returned. Upon failure,
  * a negative error code is returned instead.
+ *
+ * @note A SYNC_IOCTL_SET_TIMEOUT request takes a timeout in
+ * milliseconds. With SYNC_TIMEOUT_TRY, blocking operations fail
+ * with -ETIMEDOUT instead of blocking, and with
+ * SYNC_TIMEOUT_INFINITE they never time out.
  */
 EXTERN int sync_ioctl(int syncid, unsigned request, ...);
 
+/**
+ * @brief Announces arrival at a synchronization point.
+ *
+ * @param syncid ID of the target sync, which must be opened.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * @note This function does not block. The arrival is completed by
+ * sync_test() or sync_await().
+ */
+EXTERN int sync_arrive(int syncid);
+
+/**
+ * @brief Tests a split-phase synchronization point.
+ *
+ * @param syncid ID of the target sync.
+ *
+ * @returns One if the barrier of a created sync has completed, or the
+ * arrival on an opened sync has been delivered, and zero otherwise.
+ * Upon failure, a negative error code is returned instead.
+ *
+ * @note A completed barrier is consumed.
+ */
+EXTERN int sync_test(int syncid);
+
+/**
+ * @brief Awaits a split-phase synchronization point.
+ *
+ * @param syncid ID of the target sync.
+ *
+ * @returns Upon successful completion, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ */
+EXTERN int sync_await(int syncid);
+
 /**
  * @brief Initializes the sync interface.
  */
@@ -32,14 +32,12 @@
 /**
  * @todo TODO: provide a detailed description for this function.
  */
-PUBLIC int linux64_processor_boot(int nclusters)
+PUBLIC int linux64_processor_boot(int nclusters, unsigned flags)
 {
-    UNUSED(nclusters);
-
     kprintf("[hal][processor] powering on...");
 
-    linux64_processor_clusters_boot();
-    linux64_processor_noc_boot();
+    linux64_processor_clusters_boot(nclusters, flags);
+    linux64_processor_noc_boot(flags);
 
     return (linux64_cluster_boot());
 }
@@ -64,6 +64,21 @@ PRIVATE struct {
      */
     sem_t *lock;
 
+    /**
+     * @brief Process-local virtual processor?
+     */
+    int local;
+
+    /**
+     * @brief Underlying lock of a process-local virtual processor.
+     */
+    sem_t local_lock;
+
+    /**
+     * @brief Number of clusters powered on.
+     */
+    int nclusters;
+
     /**
      * @brief Lookup table for logical cluster numbers.
      */
@@ -76,6 +91,8 @@ PRIVATE struct {
 
 } clusters = {.shm = -1,
               .lock = NULL,
+              .local = 0,
+              .nclusters = 1,
               .pids = NULL,
 
               .types = {
@@ -166,6 +183,19 @@ PUBLIC int linux64_cluster_get_num(void)
     return (clusternum);
 }
 
+/*============================================================================*
+ * linux64_processor_get_nclusters()                                          *
+ *============================================================================*/
+
+/**
+ * The linux64_processor_get_nclusters() function returns the number of
+ * clusters that the underlying processor was powered on with.
+ */
+PUBLIC int linux64_processor_get_nclusters(void)
+{
+    return (clusters.nclusters);
+}
+
 /*============================================================================*
  * linux64_processor_cluster_is_compute()                                     *
  *============================================================================*/
@@ -200,8 +230,12 @@ PUBLIC int linux64_cluster_is_io(int clusternum)
 
 /**
  * @todo TODO: Provide a detailed description for this function.
+ *
+ * @note If @p flags has LINUX64_PROCESSOR_LOCAL set, the virtual
+ * processor lives in the memory of the calling process, and no POSIX
+ * IPC object backs it.
  */
-PUBLIC void linux64_processor_clusters_boot(void)
+PUBLIC void linux64_processor_clusters_boot(int nclusters, unsigned flags)
 {
     void *p;
     struct stat st;
@@ -210,31 +244,47 @@ PUBLIC void linux64_processor_clusters_boot(void)
 
     LINUX64_PROCESSOR_CLUSTERID_MASTER = linux64_cluster_get_id();
 
-    KASSERT((clusters.lock = sem_open(UNIX64_CLUSTERS_LOCK_NAME,
-                                      O_RDWR | O_CREAT,
-                                      S_IRUSR | S_IWUSR,
-                                      1)) != NULL);
-
-    /* Open virtual processor. */
-    KASSERT((clusters.shm = shm_open(UNIX64_CLUSTERS_NAME,
-                                     O_RDWR | O_CREAT,
-                                     S_IRUSR | S_IWUSR)) != -1);
+    clusters.local = ((flags & LINUX64_PROCESSOR_LOCAL) != 0);
+    clusters.nclusters = nclusters;
+
+    /* Process-local virtual processor. */
+    if (clusters.local) {
+        KASSERT(sem_init(&clusters.local_lock, 0, 1) != -1);
+        clusters.lock = &clusters.local_lock;
+    } else {
+        KASSERT((clusters.lock = sem_open(UNIX64_CLUSTERS_LOCK_NAME,
+                                          O_RDWR | O_CREAT,
+                                          S_IRUSR | S_IWUSR,
+                                          1)) != NULL);
+
+        /* Open virtual processor. */
+        KASSERT((clusters.shm = shm_open(UNIX64_CLUSTERS_NAME,
+                                         O_RDWR | O_CREAT,
+                                         S_IRUSR | S_IWUSR)) != -1);
+    }
 
     linux64_processor_clusters_lock();
 
     /* Allocate virtual processor. */
-    KASSERT(fstat(clusters.shm, &st) != -1);
-    if (st.st_size == 0) {
-        kprintf("[hal][processor] allocating virtual clusters...");
+    if (clusters.local)
         initialize = 1;
-        KASSERT(ftruncate(clusters.shm, clusters_sz) != -1);
+    else {
+        KASSERT(fstat(clusters.shm, &st) != -1);
+        if (st.st_size == 0) {
+            initialize = 1;
+            KASSERT(ftruncate(clusters.shm, clusters_sz) != -1);
+        }
     }
 
+    if (initialize)
+        kprintf("[hal][processor] allocating virtual clusters...");
+
     /* Attach virtual processor. */
     KASSERT((p = mmap(NULL,
                       clusters_sz,
                       PROT_READ | PROT_WRITE,
-                      MAP_SHARED,
+                      clusters.local ? (MAP_PRIVATE | MAP_ANONYMOUS)
+                                     : MAP_SHARED,
                       clusters.shm,
                       0)) != NULL);
     clusters.pids = p;
@@ -272,6 +322,13 @@ PUBLIC void linux64_processor_clusters_shutdown(void)
     size_t clusters_sz = PROCESSOR_CLUSTERS_NUM * sizeof(pid_t);
 
     KASSERT(munmap(clusters.pids, clusters_sz) != -1);
+
+    /* Process-local virtual processor. */
+    if (clusters.local) {
+        KASSERT(sem_destroy(clusters.lock) != -1);
+        return;
+    }
+
     KASSERT(close(clusters.shm) != -1);
     KASSERT(sem_close(clusters.lock) != -1);
 
@@ -44,6 +44,50 @@
  */
 #define UNIX64_NOC_LOCK_NAME "nanvix-unix64-noc-lock"
 
+/**
+ * @brief Name for the shared arena of the virtual NoC.
+ */
+#define UNIX64_NOC_ARENA_NAME "nanvix-unix64-noc-arena"
+
+/**
+ * @brief Cache line size (in bytes).
+ */
+#define UNIX64_NOC_ARENA_ALIGN 64
+
+/**
+ * @brief Size (in bytes) of a huge page of the host.
+ */
+#define UNIX64_NOC_ARENA_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+/**
+ * @brief Number of slots in the shared arena.
+ *
+ * There is one slot for each ordered pair of NoC nodes, followed by
+ * one multicast slot for each NoC node and a slot of doorbells and
+ * credit blocks.
+ */
+#define UNIX64_NOC_ARENA_SLOTS_NUM                                             \
+    (PROCESSOR_NOC_NODES_NUM * PROCESSOR_NOC_NODES_NUM +                       \
+     PROCESSOR_NOC_NODES_NUM + 1)
+
+#if ((LINUX64_PROCESSOR_NOC_ARENA_BELL_SIZE +                                  \
+      LINUX64_PROCESSOR_NOC_ARENA_CREDIT_SIZE) *                               \
+         PROCESSOR_NOC_NODES_NUM >                                             \
+     LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE)
+#error "doorbells and credit blocks do not fit in a slot"
+#endif
+
+/**
+ * @brief Size (in bytes) of the shared arena.
+ *
+ * The size is rounded up to a huge page boundary, so that the whole
+ * arena may be backed by huge pages.
+ */
+#define UNIX64_NOC_ARENA_SIZE                                                  \
+    ((UNIX64_NOC_ARENA_SLOTS_NUM * LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE +     \
+      UNIX64_NOC_ARENA_HUGE_PAGE_SIZE - 1) &                                   \
+     ~(UNIX64_NOC_ARENA_HUGE_PAGE_SIZE - 1))
+
 /**
  * @brief NoC node.
  */
@@ -66,12 +110,23 @@ struct {
      */
     int shm;
 
+    /**
+     * @brief Shared arena file descriptor.
+     */
+    int arena_shm;
+
     sem_t *lock;                               /* Lock          */
+    int local;                                 /* Process-local */
+    sem_t local_lock;                          /* Local lock    */
     struct noc_node *nodes;                    /* Nodes         */
+    char *arena;                               /* Shared arena  */
     int configuration[PROCESSOR_CLUSTERS_NUM]; /* Configuration */
 } noc = {.shm = -1,
+         .arena_shm = -1,
          .lock = NULL,
+         .local = 0,
          .nodes = NULL,
+         .arena = NULL,
 
          /* TODO check if sums up number of nodes */
          .configuration = {/* IO clusters. */
@@ -174,14 +229,148 @@ PUBLIC int linux64_processor_noc_is_cnode(int nodenum)
     return (linux64_cluster_is_compute(clusternum));
 }
 
+/*============================================================================*
+ * linux64_processor_noc_arena_slot()                                         *
+ *============================================================================*/
+
+/**
+ * The linux64_processor_noc_arena_slot() function returns the slot of
+ * the shared arena that is assigned to the pair of NoC nodes @p local
+ * and @p remote. Slots are laid out in receiver-major order, thus all
+ * the slots of a receiver are contiguous.
+ */
+PUBLIC void *linux64_processor_noc_arena_slot(int local, int remote)
+{
+    KASSERT((local >= 0) && (local < PROCESSOR_NOC_NODES_NUM));
+    KASSERT((remote >= 0) && (remote < PROCESSOR_NOC_NODES_NUM));
+
+    return (noc.arena + (local * PROCESSOR_NOC_NODES_NUM + remote) *
+                            LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE);
+}
+
+/*============================================================================*
+ * linux64_processor_noc_arena_mslot()                                        *
+ *============================================================================*/
+
+/**
+ * The linux64_processor_noc_arena_mslot() function returns the
+ * multicast slot of the shared arena that is assigned to the NoC node
+ * @p nodenum. Multicast slots come after all the slots of pairs of
+ * NoC nodes.
+ */
+PUBLIC void *linux64_processor_noc_arena_mslot(int nodenum)
+{
+    KASSERT((nodenum >= 0) && (nodenum < PROCESSOR_NOC_NODES_NUM));
+
+    return (noc.arena +
+            (PROCESSOR_NOC_NODES_NUM * PROCESSOR_NOC_NODES_NUM + nodenum) *
+                LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE);
+}
+
+/*============================================================================*
+ * linux64_processor_noc_arena_bell()                                         *
+ *============================================================================*/
+
+/**
+ * The linux64_processor_noc_arena_bell() function returns the
+ * doorbell of the NoC node @p nodenum. Doorbells are packed into the
+ * last slot of the shared arena.
+ */
+PUBLIC void *linux64_processor_noc_arena_bell(int nodenum)
+{
+    KASSERT((nodenum >= 0) && (nodenum < PROCESSOR_NOC_NODES_NUM));
+
+    return (noc.arena +
+            (PROCESSOR_NOC_NODES_NUM * PROCESSOR_NOC_NODES_NUM +
+             PROCESSOR_NOC_NODES_NUM) *
+                LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE +
+            nodenum * LINUX64_PROCESSOR_NOC_ARENA_BELL_SIZE);
+}
+
+/*============================================================================*
+ * linux64_processor_noc_arena_credit()                                       *
+ *============================================================================*/
+
+/**
+ * The linux64_processor_noc_arena_credit() function returns the
+ * credit block of the NoC node @p nodenum. Credit blocks are packed
+ * into the last slot of the shared arena, right after the doorbells.
+ */
+PUBLIC void *linux64_processor_noc_arena_credit(int nodenum)
+{
+    KASSERT((nodenum >= 0) && (nodenum < PROCESSOR_NOC_NODES_NUM));
+
+    return (noc.arena +
+            (PROCESSOR_NOC_NODES_NUM * PROCESSOR_NOC_NODES_NUM +
+             PROCESSOR_NOC_NODES_NUM) *
+                LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE +
+            PROCESSOR_NOC_NODES_NUM * LINUX64_PROCESSOR_NOC_ARENA_BELL_SIZE +
+            nodenum * LINUX64_PROCESSOR_NOC_ARENA_CREDIT_SIZE);
+}
+
+/*============================================================================*
+ * linux64_processor_noc_arena_boot()                                         *
+ *============================================================================*/
+
+/**
+ * @brief Maps the shared arena of the virtual NoC.
+ *
+ * The arena is created by the first cluster that boots. A freshly
+ * created arena is zero-filled by the kernel, thus it requires no
+ * further initialization. A process-local arena is anonymous memory,
+ * which is zero-filled as well.
+ *
+ * @note The caller must hold the lock of the virtual NoC.
+ */
+PRIVATE void linux64_processor_noc_arena_boot(void)
+{
+    void *p;
+    struct stat st;
+
+    KASSERT((LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE %
+             UNIX64_NOC_ARENA_ALIGN) == 0);
+
+    /* Open shared arena. */
+    if (!noc.local) {
+        KASSERT((noc.arena_shm = shm_open(UNIX64_NOC_ARENA_NAME,
+                                          O_RDWR | O_CREAT,
+                                          S_IRUSR | S_IWUSR)) != -1);
+
+        /* Allocate shared arena. */
+        KASSERT(fstat(noc.arena_shm, &st) != -1);
+        if (st.st_size == 0)
+            KASSERT(ftruncate(noc.arena_shm, UNIX64_NOC_ARENA_SIZE) != -1);
+    }
+
+    KASSERT((p = mmap(NULL,
+                      UNIX64_NOC_ARENA_SIZE,
+                      PROT_READ | PROT_WRITE,
+                      noc.local ? (MAP_PRIVATE | MAP_ANONYMOUS) : MAP_SHARED,
+                      noc.arena_shm,
+                      0)) != MAP_FAILED);
+    noc.arena = p;
+
+#if (__LINUX64_PROCESSOR_NOC_ARENA_USES_HUGEPAGES) && defined(MADV_HUGEPAGE)
+    /*
+     * This is only a hint. Whether shared memory is
+     * backed by huge pages is up to the host kernel.
+     */
+    madvise(noc.arena, UNIX64_NOC_ARENA_SIZE, MADV_HUGEPAGE);
+#endif
+}
+
 /*============================================================================*
  * linux64_processor_noc_boot()                                               *
  *============================================================================*/
 
 /**
  * @todo TODO: Provide a detailed description to this function.
+ *
+ * @note If @p flags has LINUX64_PROCESSOR_LOCAL set, the virtual NoC
+ * and its arena live in the memory of the calling process, and no
+ * POSIX IPC object backs them.
  */
-PUBLIC void linux64_processor_noc_boot(void)
+PUBLIC void linux64_processor_noc_boot(unsigned flags)
 {
     void *p;
     int nnodes;
@@ -195,29 +384,46 @@ PUBLIC void linux64_processor_noc_boot(void)
         nnodes += noc.configuration[i];
     KASSERT(nnodes == PROCESSOR_NOC_NODES_NUM);
 
-    KASSERT(
-        (noc.lock = sem_open(
-             UNIX64_NOC_LOCK_NAME, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR, 1)) !=
-        NULL);
-
-    /* Open virtual NoC. */
-    KASSERT((noc.shm = shm_open(
-                 UNIX64_NOC_NAME, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR)) != -1);
+    noc.local = ((flags & LINUX64_PROCESSOR_LOCAL) != 0);
+
+    /* Process-local virtual NoC. */
+    if (noc.local) {
+        KASSERT(sem_init(&noc.local_lock, 0, 1) != -1);
+        noc.lock = &noc.local_lock;
+    } else {
+        KASSERT((noc.lock = sem_open(UNIX64_NOC_LOCK_NAME,
+                                     O_RDWR | O_CREAT,
+                                     S_IRUSR | S_IWUSR,
+                                     1)) != NULL);
+
+        /* Open virtual NoC. */
+        KASSERT((noc.shm = shm_open(UNIX64_NOC_NAME,
+                                    O_RDWR | O_CREAT,
+                                    S_IRUSR | S_IWUSR)) != -1);
+    }
 
     linux64_processor_noc_lock();
 
     /* Allocate virtual NoC. */
-    KASSERT(fstat(noc.shm, &st) != -1);
-    if (st.st_size == 0) {
-        kprintf("[hal][processor] allocating virtual network-on-chip...");
+    if (noc.local)
         initialize = 1;
-        KASSERT(ftruncate(noc.shm, nodes_sz) != -1);
+    else {
+        KASSERT(fstat(noc.shm, &st) != -1);
+        if (st.st_size == 0) {
+            initialize = 1;
+            KASSERT(ftruncate(noc.shm, nodes_sz) != -1);
+        }
     }
 
-    KASSERT(
-        (p = mmap(
-             NULL, nodes_sz, PROT_READ | PROT_WRITE, MAP_SHARED, noc.shm, 0)) !=
-        NULL);
+    if (initialize)
+        kprintf("[hal][processor] allocating virtual network-on-chip...");
+
+    KASSERT((p = mmap(NULL,
+                      nodes_sz,
+                      PROT_READ | PROT_WRITE,
+                      noc.local ? (MAP_PRIVATE | MAP_ANONYMOUS) : MAP_SHARED,
+                      noc.shm,
+                      0)) != NULL);
     noc.nodes = p;
 
     /* Initialize nodes. */
@@ -228,6 +434,8 @@ PUBLIC void linux64_processor_noc_boot(void)
         }
     }
 
+    linux64_processor_noc_arena_boot();
+
     linux64_processor_noc_unlock();
 }
 
@@ -242,12 +450,22 @@ PUBLIC void linux64_processor_noc_shutdown(void)
 {
     size_t nodes_sz = PROCESSOR_NOC_NODES_NUM * sizeof(struct noc_node);
 
+    KASSERT(munmap(noc.arena, UNIX64_NOC_ARENA_SIZE) != -1);
     KASSERT(munmap(noc.nodes, nodes_sz) != -1);
+
+    /* Process-local virtual NoC. */
+    if (noc.local) {
+        KASSERT(sem_destroy(noc.lock) != -1);
+        return;
+    }
+
+    KASSERT(close(noc.arena_shm) != -1);
     KASSERT(close(noc.shm) != -1);
     KASSERT(sem_close(noc.lock) != -1);
 
     /* Unlink virtual NoC. */
     if (cluster_get_num() == PROCESSOR_CLUSTERNUM_MASTER) {
+        KASSERT(shm_unlink(UNIX64_NOC_ARENA_NAME) != -1);
         KASSERT(shm_unlink(UNIX64_NOC_NAME) != -1);
         KASSERT(sem_unlink(UNIX64_NOC_LOCK_NAME) != -1);
     }
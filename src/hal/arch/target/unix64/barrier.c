@@ -0,0 +1,261 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <arch/target/unix64/unix64/barrier.h>
+#include <arch/target/unix64/unix64/loopback.h>
+#include <arch/target/unix64/unix64/transport.h>
+#include <fcntl.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*============================================================================*
+ * unix64_barrier_map()                                                       *
+ *============================================================================*/
+
+/**
+ * The unix64_barrier_map() function maps the table of barriers that
+ * lives in the shared memory segment named @p name, creating it if
+ * needed. A freshly created segment is zero-filled, which is a table
+ * of free barriers, thus no further initialization is required and
+ * concurrent creators do not race. If the selected transport is
+ * process-local, the table lives in a loopback segment instead.
+ */
+PUBLIC struct unix64_barrier_table *unix64_barrier_map(const char *name)
+{
+    int fd;
+    void *p;
+
+    /* Process-local table. */
+    if (unix64_transport_get()->flags & UNIX64_TRANSPORT_LOCAL)
+        return (unix64_loopback_map(name, sizeof(struct unix64_barrier_table)));
+
+    /* Open shared memory segment. */
+    if ((fd = shm_open(name, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR)) == -1)
+        goto error0;
+
+    /* Resizing to the same size keeps the contents. */
+    if (ftruncate(fd, sizeof(struct unix64_barrier_table)) == -1)
+        goto error1;
+
+    if ((p = mmap(NULL,
+                  sizeof(struct unix64_barrier_table),
+                  PROT_READ | PROT_WRITE,
+                  MAP_SHARED,
+                  fd,
+                  0)) == MAP_FAILED)
+        goto error1;
+
+    KASSERT(close(fd) != -1);
+
+    return (p);
+
+error1:
+    KASSERT(close(fd) != -1);
+error0:
+    return (NULL);
+}
+
+/*============================================================================*
+ * unix64_barrier_unmap()                                                     *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC void unix64_barrier_unmap(struct unix64_barrier_table *table)
+{
+    /* Process-local table. */
+    if (unix64_transport_get()->flags & UNIX64_TRANSPORT_LOCAL) {
+        unix64_loopback_unmap(table);
+        return;
+    }
+
+    KASSERT(munmap(table, sizeof(struct unix64_barrier_table)) != -1);
+}
+
+/*============================================================================*
+ * unix64_barrier_unlink()                                                    *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int unix64_barrier_unlink(const char *name)
+{
+    /* Process-local table. */
+    if (unix64_transport_get()->flags & UNIX64_TRANSPORT_LOCAL)
+        return (unix64_loopback_unlink(name));
+
+    return ((shm_unlink(name) == -1) ? -EAGAIN : 0);
+}
+
+/*============================================================================*
+ * unix64_barrier_get()                                                       *
+ *============================================================================*/
+
+/**
+ * The unix64_barrier_get() function looks up the barrier of key @p
+ * key in the table @p table, probing linearly from the home slot of
+ * the key. If the key is not found, the first free barrier on the way
+ * is claimed with an atomic compare-and-swap, so that processes that
+ * race for the same key end up with the same barrier.
+ */
+PUBLIC struct unix64_barrier *
+unix64_barrier_get(struct unix64_barrier_table *table, uint64_t key)
+{
+    uint64_t expected;
+    struct unix64_barrier *barrier;
+
+    KASSERT(key != 0);
+
+    for (int i = 0; i < UNIX64_BARRIER_TABLE_SIZE; i++) {
+        barrier = &table->barriers[(key + i) % UNIX64_BARRIER_TABLE_SIZE];
+
+        expected = __atomic_load_n(&barrier->key, __ATOMIC_ACQUIRE);
+
+        /* Claim free barrier. */
+        if (expected == 0) {
+            if (__atomic_compare_exchange_n(&barrier->key,
+                                            &expected,
+                                            key,
+                                            0,
+                                            __ATOMIC_ACQ_REL,
+                                            __ATOMIC_ACQUIRE))
+                return (barrier);
+        }
+
+        /* Found. */
+        if (expected == key)
+            return (barrier);
+    }
+
+    return (NULL);
+}
+
+/*============================================================================*
+ * unix64_barrier_round()                                                     *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC uint32_t unix64_barrier_round(struct unix64_barrier *barrier)
+{
+    return (unix64_event_counter(&barrier->done));
+}
+
+/*============================================================================*
+ * unix64_barrier_arrive()                                                    *
+ *============================================================================*/
+
+/**
+ * The unix64_barrier_arrive() function counts the arrival of the
+ * caller at the barrier @p barrier. If the caller is ahead of the
+ * others, it first sleeps until the round that it last arrived at
+ * completes. The last of @p nsenders senders to arrive resets the
+ * count and reverses the sense of the barrier, waking up all waiters.
+ */
+PUBLIC int unix64_barrier_arrive(struct unix64_barrier *barrier,
+                                 uint32_t *round, uint32_t nsenders,
+                                 const struct unix64_deadline *deadline)
+{
+    uint32_t counter;
+
+    do {
+        counter = unix64_event_counter(&barrier->done);
+
+        /* Previous round is complete. */
+        if ((int32_t)(*round - counter) <= 0)
+            break;
+
+        if (unix64_event_wait(&barrier->done, counter, deadline) < 0)
+            return (-ETIMEDOUT);
+    } while (1);
+
+    /*
+     * The current round cannot complete without us, thus we
+     * arrive at it. The last sender reverses the sense, which
+     * publishes the reset count to senders of the next round.
+     */
+    if (__atomic_add_fetch(&barrier->count, 1, __ATOMIC_ACQ_REL) == nsenders) {
+        __atomic_store_n(&barrier->count, 0, __ATOMIC_RELAXED);
+        unix64_event_notify(&barrier->done);
+    }
+
+    *round = counter + 1;
+
+    return (0);
+}
+
+/*============================================================================*
+ * unix64_barrier_wait()                                                      *
+ *============================================================================*/
+
+/**
+ * The unix64_barrier_wait() function consumes a completed round of
+ * the barrier @p barrier on behalf of the NoC node @p nodenum. If
+ * there are no completed rounds left to consume, the caller sleeps
+ * until one completes or the deadline @p deadline expires.
+ */
+PUBLIC int unix64_barrier_wait(struct unix64_barrier *barrier, int nodenum,
+                               const struct unix64_deadline *deadline)
+{
+    uint32_t counter;
+    uint32_t consumed;
+
+    consumed = __atomic_load_n(&barrier->consumed[nodenum], __ATOMIC_RELAXED);
+
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&barrier->done);
+
+        /* Round completed. */
+        if (counter != consumed) {
+            __atomic_store_n(
+                &barrier->consumed[nodenum], consumed + 1, __ATOMIC_RELAXED);
+            return (0);
+        }
+
+    } while (unix64_event_wait(&barrier->done, counter, deadline) == 0);
+
+    return (-ETIMEDOUT);
+}
+
+/*============================================================================*
+ * unix64_barrier_is_complete()                                               *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int unix64_barrier_is_complete(struct unix64_barrier *barrier,
+                                      int nodenum)
+{
+    return (unix64_event_counter(&barrier->done) !=
+            __atomic_load_n(&barrier->consumed[nodenum], __ATOMIC_RELAXED));
+}
@@ -25,6 +25,7 @@
 /* Must come fist. */
 #define __NEED_HAL_TARGET
 
+#include <arch/target/unix64/unix64/transport.h>
 #include <nanvix/const.h>
 #include <nanvix/hal/target.h>
 #include <nanvix/hlib.h>
@@ -36,8 +37,9 @@
  * @brief Boot arguments.
  */
 PRIVATE struct {
-    int nclusters; /**< Number of Clusters */
-} boot_args = {1};
+    int nclusters;         /**< Number of Clusters */
+    const char *transport; /**< IKC Transport      */
+} boot_args = {1, NULL};
 
 /**
  * @brief Parses boot arguments.
@@ -48,15 +50,21 @@ PRIVATE struct {
 PRIVATE void unix64_parse_boot_args(int argc, const char **argv)
 {
     for (int i = 1; i < argc; /* noop*/) {
-        /* Unkonwn argument. */
-        if (strcmp(argv[i], "--nclusters"))
-            exit(-EINVAL);
-
         /* Missing argument. */
-        if ((i + 1) > argc)
+        if ((i + 1) >= argc)
             exit(-EINVAL);
 
-        sscanf(argv[i + 1], "%d", &boot_args.nclusters);
+        /* Number of clusters. */
+        if (!strcmp(argv[i], "--nclusters"))
+            sscanf(argv[i + 1], "%d", &boot_args.nclusters);
+
+        /* IKC transport. */
+        else if (!strcmp(argv[i], "--transport"))
+            boot_args.transport = argv[i + 1];
+
+        /* Unknown argument. */
+        else
+            exit(-EINVAL);
 
         fprintf(stderr, "[unix64] argv[%d]: %s %s\n", i, argv[i], argv[i + 1]);
 
@@ -67,15 +75,30 @@ PRIVATE void unix64_parse_boot_args(int argc, const char **argv)
     if ((boot_args.nclusters < 1) ||
         (boot_args.nclusters > PROCESSOR_CLUSTERS_NUM))
         exit(-EINVAL);
+
+    /* Unknown transport. */
+    if ((boot_args.transport != NULL) &&
+        (unix64_transport_select(boot_args.transport) < 0))
+        exit(-EINVAL);
+
+    /* Transport does not reach other clusters. */
+    if ((unix64_transport_get()->flags & UNIX64_TRANSPORT_LOCAL) &&
+        (boot_args.nclusters > 1))
+        exit(-EINVAL);
 }
 
 /**
  * @brief Powers on the underlying target.
  *
  * @param nclusters Number of clusters to power on.
+ *
+ * @note A process-local transport reaches no other process, thus the
+ * processor is kept in the memory of the calling process as well.
  */
 PRIVATE int unix64_boot(int nclusters)
 {
+    unsigned flags = 0;
+
     /*
      * Early initialization of Virtual
      * TTY device to help us debugging.
@@ -84,7 +107,10 @@ PRIVATE int unix64_boot(int nclusters)
 
     kprintf("[hal][target] powering on...");
 
-    return (linux64_processor_boot(nclusters));
+    if (unix64_transport_get()->flags & UNIX64_TRANSPORT_LOCAL)
+        flags |= LINUX64_PROCESSOR_LOCAL;
+
+    return (linux64_processor_boot(nclusters, flags));
 }
 
 /**
@@ -95,6 +121,8 @@ PUBLIC NORETURN void unix64_poweroff(void)
     if (cluster_get_num() == PROCESSOR_CLUSTERNUM_MASTER)
         kprintf("[hal][target] powering off...");
 
+    spinwait_report();
+
     unix64_mailbox_shutdown();
 #if !__NANVIX_IKC_USES_ONLY_MAILBOX
     unix64_sync_shutdown();
@@ -0,0 +1,262 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Must come first, because the core
+ * redefines constants of <limits.h>.
+ */
+#include <nanvix/hal/core/spinwait.h>
+
+#include <arch/target/unix64/unix64/futex.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+#include <syscall.h>
+#include <unistd.h>
+
+/**
+ * @brief Number of nanoseconds in a second.
+ */
+#define UNIX64_NSEC_PER_SEC 1000000000L
+
+/*============================================================================*
+ * unix64_timespec_add()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Adds nanoseconds to a time value.
+ *
+ * @param tm   Target time value.
+ * @param nsec Number of nanoseconds to add.
+ */
+PRIVATE void unix64_timespec_add(struct timespec *tm, long long nsec)
+{
+    tm->tv_sec += nsec / UNIX64_NSEC_PER_SEC;
+    tm->tv_nsec += nsec % UNIX64_NSEC_PER_SEC;
+
+    if (tm->tv_nsec >= UNIX64_NSEC_PER_SEC) {
+        tm->tv_sec++;
+        tm->tv_nsec -= UNIX64_NSEC_PER_SEC;
+    }
+}
+
+/*============================================================================*
+ * unix64_timespec_diff()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Computes the difference between two time values.
+ *
+ * @param t1 First time value.
+ * @param t0 Second time value.
+ *
+ * @returns The number of nanoseconds from @p t0 to @p t1.
+ */
+PRIVATE long long unix64_timespec_diff(const struct timespec *t1,
+                                       const struct timespec *t0)
+{
+    return ((long long)(t1->tv_sec - t0->tv_sec) * UNIX64_NSEC_PER_SEC +
+            (t1->tv_nsec - t0->tv_nsec));
+}
+
+/*============================================================================*
+ * unix64_deadline_set()                                                      *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC void unix64_deadline_set(struct unix64_deadline *deadline, int timeout)
+{
+    deadline->infinite = (timeout < 0);
+
+    KASSERT(clock_gettime(CLOCK_MONOTONIC, &deadline->tm) == 0);
+
+    if (!deadline->infinite)
+        unix64_timespec_add(&deadline->tm, (long long)timeout * 1000000LL);
+}
+
+/*============================================================================*
+ * unix64_deadline_expired()                                                  *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int unix64_deadline_expired(const struct unix64_deadline *deadline)
+{
+    struct timespec now;
+
+    if (deadline->infinite)
+        return (0);
+
+    KASSERT(clock_gettime(CLOCK_MONOTONIC, &now) == 0);
+
+    return (unix64_timespec_diff(&deadline->tm, &now) <= 0);
+}
+
+/*============================================================================*
+ * unix64_deadline_slice()                                                    *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC void unix64_deadline_slice(const struct unix64_deadline *deadline,
+                                  struct timespec *tm)
+{
+    long long left;
+    struct timespec now;
+
+    left = UNIX64_NSEC_PER_SEC;
+
+    if (!deadline->infinite) {
+        KASSERT(clock_gettime(CLOCK_MONOTONIC, &now) == 0);
+
+        left = unix64_timespec_diff(&deadline->tm, &now);
+
+        /* Expired. */
+        if (left < 0)
+            left = 0;
+
+        /* Cap slice. */
+        if (left > UNIX64_NSEC_PER_SEC)
+            left = UNIX64_NSEC_PER_SEC;
+    }
+
+    KASSERT(clock_gettime(CLOCK_REALTIME, tm) == 0);
+    unix64_timespec_add(tm, left);
+}
+
+/*============================================================================*
+ * unix64_futex_wait()                                                        *
+ *============================================================================*/
+
+/**
+ * The unix64_futex_wait() function sleeps on the futex word pointed
+ * to by @p addr as long as it holds @p val. The futex is not private,
+ * so it works across processes that share the underlying memory, and
+ * the deadline is measured against CLOCK_MONOTONIC.
+ */
+PUBLIC int unix64_futex_wait(uint32_t *addr, uint32_t val,
+                             const struct unix64_deadline *deadline)
+{
+    if (syscall(__NR_futex,
+                addr,
+                FUTEX_WAIT_BITSET,
+                val,
+                deadline->infinite ? NULL : &deadline->tm,
+                NULL,
+                FUTEX_BITSET_MATCH_ANY) == 0)
+        return (0);
+
+    return ((errno == ETIMEDOUT) ? -ETIMEDOUT : -EAGAIN);
+}
+
+/*============================================================================*
+ * unix64_futex_wake()                                                        *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC void unix64_futex_wake(uint32_t *addr)
+{
+    KASSERT(syscall(__NR_futex, addr, FUTEX_WAKE, INT_MAX, NULL, NULL, 0) !=
+            -1);
+}
+
+/*============================================================================*
+ * unix64_event_counter()                                                     *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC uint32_t unix64_event_counter(struct unix64_event *event)
+{
+    return (__atomic_load_n(&event->counter, __ATOMIC_SEQ_CST));
+}
+
+/*============================================================================*
+ * unix64_event_notify()                                                      *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC void unix64_event_notify(struct unix64_event *event)
+{
+    __atomic_add_fetch(&event->counter, 1, __ATOMIC_SEQ_CST);
+
+    /* Fast path: nobody is sleeping. */
+    if (__atomic_load_n(&event->nwaiters, __ATOMIC_SEQ_CST) == 0)
+        return;
+
+    unix64_futex_wake(&event->counter);
+}
+
+/*============================================================================*
+ * unix64_event_wait()                                                        *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int unix64_event_wait(struct unix64_event *event, uint32_t counter,
+                             const struct unix64_deadline *deadline)
+{
+    int ret;
+
+    __atomic_add_fetch(&event->nwaiters, 1, __ATOMIC_SEQ_CST);
+    ret = unix64_futex_wait(&event->counter, counter, deadline);
+    __atomic_sub_fetch(&event->nwaiters, 1, __ATOMIC_SEQ_CST);
+
+    return ((ret == -ETIMEDOUT) ? ret : 0);
+}
+
+/*============================================================================*
+ * unix64_event_spinwait()                                                    *
+ *============================================================================*/
+
+/**
+ * The unix64_event_spinwait() function spends a round of the waiter
+ * @p waiter. Rounds that are not spent spinning or yielding are spent
+ * parked on the event @p event, until it is notified past @p counter
+ * or #UNIX64_SPINWAIT_PARK_TIMEOUT expires.
+ */
+PUBLIC void unix64_event_spinwait(struct unix64_event *event,
+                                  uint32_t counter, struct spinwait *waiter)
+{
+    struct unix64_deadline deadline;
+
+    /* Spinning or yielding. */
+    if (!spinwait_once(waiter))
+        return;
+
+    unix64_deadline_set(&deadline, UNIX64_SPINWAIT_PARK_TIMEOUT);
+    unix64_event_wait(event, counter, &deadline);
+}
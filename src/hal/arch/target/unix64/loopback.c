@@ -0,0 +1,186 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <arch/target/unix64/unix64/loopback.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+/**
+ * @brief Table of loopback segments.
+ *
+ * A segment is released when it has no name and it is no longer
+ * mapped, which mirrors the lifetime of a shared memory segment.
+ */
+PRIVATE struct {
+    pthread_mutex_t lock; /**< Table lock. */
+
+    /**
+     * @brief Loopback segments.
+     */
+    struct {
+        char name[UNIX64_LOOPBACK_NAME_LENGTH]; /**< Name (empty if none). */
+        void *addr;   /**< Underlying memory (NULL if free). */
+        size_t size;  /**< Size (in bytes).                  */
+        int refcount; /**< Number of mappings.               */
+    } entries[UNIX64_LOOPBACK_SEGMENTS_MAX];
+} loopbacks = {
+    .lock = PTHREAD_MUTEX_INITIALIZER,
+};
+
+/*============================================================================*
+ * unix64_loopback_release()                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Releases a loopback segment that is no longer used.
+ *
+ * @param i Index of the target segment.
+ *
+ * @note The caller must hold the table lock.
+ */
+PRIVATE void unix64_loopback_release(int i)
+{
+    /* Still in use. */
+    if ((loopbacks.entries[i].refcount > 0) ||
+        (loopbacks.entries[i].name[0] != '\0'))
+        return;
+
+    free(loopbacks.entries[i].addr);
+    loopbacks.entries[i].addr = NULL;
+}
+
+/*============================================================================*
+ * unix64_loopback_map()                                                      *
+ *============================================================================*/
+
+/**
+ * The unix64_loopback_map() function maps the loopback segment named
+ * @p name, creating it with @p size bytes if needed. A freshly created
+ * segment is zero-filled, just like a fresh shared memory segment.
+ */
+PUBLIC void *unix64_loopback_map(const char *name, size_t size)
+{
+    int i;
+    void *p;
+
+    /* Name too long. */
+    if (kstrlen(name) >= UNIX64_LOOPBACK_NAME_LENGTH)
+        return (NULL);
+
+    KASSERT(pthread_mutex_lock(&loopbacks.lock) == 0);
+
+    /* Existing segment. */
+    for (i = 0; i < UNIX64_LOOPBACK_SEGMENTS_MAX; i++) {
+        if ((loopbacks.entries[i].addr != NULL) &&
+            !kstrcmp(loopbacks.entries[i].name, name)) {
+            /* Segment is too small. */
+            if (loopbacks.entries[i].size < size)
+                goto error;
+
+            loopbacks.entries[i].refcount++;
+            goto found;
+        }
+    }
+
+    /* Free entry. */
+    for (i = 0; i < UNIX64_LOOPBACK_SEGMENTS_MAX; i++) {
+        if (loopbacks.entries[i].addr == NULL)
+            break;
+    }
+
+    /* Table is full. */
+    if (i == UNIX64_LOOPBACK_SEGMENTS_MAX)
+        goto error;
+
+    if (posix_memalign(&p, UNIX64_LOOPBACK_ALIGN, size))
+        goto error;
+
+    kmemset(p, 0, size);
+    kstrncpy(loopbacks.entries[i].name, name, UNIX64_LOOPBACK_NAME_LENGTH);
+    loopbacks.entries[i].addr = p;
+    loopbacks.entries[i].size = size;
+    loopbacks.entries[i].refcount = 1;
+
+found:
+    KASSERT(pthread_mutex_unlock(&loopbacks.lock) == 0);
+    return (loopbacks.entries[i].addr);
+
+error:
+    KASSERT(pthread_mutex_unlock(&loopbacks.lock) == 0);
+    return (NULL);
+}
+
+/*============================================================================*
+ * unix64_loopback_unmap()                                                    *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC void unix64_loopback_unmap(void *addr)
+{
+    KASSERT(pthread_mutex_lock(&loopbacks.lock) == 0);
+
+    for (int i = 0; i < UNIX64_LOOPBACK_SEGMENTS_MAX; i++) {
+        if (loopbacks.entries[i].addr == addr) {
+            KASSERT(loopbacks.entries[i].refcount > 0);
+            loopbacks.entries[i].refcount--;
+            unix64_loopback_release(i);
+            break;
+        }
+    }
+
+    KASSERT(pthread_mutex_unlock(&loopbacks.lock) == 0);
+}
+
+/*============================================================================*
+ * unix64_loopback_unlink()                                                   *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int unix64_loopback_unlink(const char *name)
+{
+    int ret = -ENOENT;
+
+    KASSERT(pthread_mutex_lock(&loopbacks.lock) == 0);
+
+    for (int i = 0; i < UNIX64_LOOPBACK_SEGMENTS_MAX; i++) {
+        if ((loopbacks.entries[i].addr != NULL) &&
+            !kstrcmp(loopbacks.entries[i].name, name)) {
+            loopbacks.entries[i].name[0] = '\0';
+            unix64_loopback_release(i);
+            ret = 0;
+            break;
+        }
+    }
+
+    KASSERT(pthread_mutex_unlock(&loopbacks.lock) == 0);
+
+    return (ret);
+}
@@ -24,9 +24,12 @@
 #define __NEED_HAL_PROCESSOR
 #define __NEED_RESOURCE
 
+#include <arch/target/unix64/unix64/futex.h>
 #include <arch/target/unix64/unix64/mailbox.h>
+#include <arch/target/unix64/unix64/poll.h>
+#include <arch/target/unix64/unix64/ring.h>
+#include <arch/target/unix64/unix64/transport.h>
 #include <fcntl.h>
-#include <mqueue.h>
 #include <nanvix/const.h>
 #include <nanvix/hal/processor.h>
 #include <nanvix/hal/resource.h>
@@ -34,8 +37,6 @@
 #include <posix/errno.h>
 #include <pthread.h>
 #include <stdio.h>
-#include <sys/stat.h>
-#include <time.h>
 
 /**
  * @brief Length of mailbox name.
@@ -56,11 +57,47 @@ struct mailbox {
      */
     struct resource resource; /**< Generic resource information. */
 
-    mqd_t fd; /**< Underlying file descriptor.   */
-    char pathname[UNIX64_MAILBOX_NAME_LENGTH]; /**< Name of underlying mqueue.
-                                                */
+    pthread_mutex_t lock; /**< Endpoint lock.                */
+    struct unix64_event idle; /**< Endpoint no longer busy. */
+    union unix64_connector conn; /**< Underlying NoC connector. */
+    char pathname[UNIX64_MAILBOX_NAME_LENGTH]; /**< Name of NoC connector. */
     int nodenum;  /**< ID of underlying node.        */
     int refcount; /**< Reference counter.            */
+    int timeout;  /**< Timeout (in milliseconds).    */
+    int priority; /**< Priority class of messages.   */
+    void *slot;   /**< Reserved or peeked message.   */
+    int lane;     /**< Priority class of slot.       */
+    uint64_t pos; /**< Position of reserved slot.    */
+    char staging[UNIX64_MAILBOX_MSG_SIZE_MAX]; /**< Staging buffer. */
+    size_t pending; /**< Size of message left in staging buffer. */
+    int error;      /**< Error deferred by a partial batch.       */
+};
+
+#if (UNIX64_MAILBOX_PRIORITY_NUM > UNIX64_RING_LANES_NUM)
+#error "not enough ring lanes for mailbox priority classes"
+#endif
+#if (UNIX64_MAILBOX_MSG_SIZE_MAX > UNIX64_RING_DATA_SIZE)
+#error "ring slots are too small for mailbox messages"
+#endif
+
+/**
+ * @brief Depth (in messages) of the NoC connector of a mailbox.
+ */
+#define UNIX64_MAILBOX_DEPTH (unix64_transport_get()->depth)
+
+/**
+ * @brief Send credits of a NoC node.
+ *
+ * A sender holds a credit of a priority class for each message of that
+ * class that it has in flight to the NoC node, and the receiver hands
+ * the credit back when it consumes the message. The receiver grants
+ * UNIX64_MAILBOX_DEPTH credits per class, except for the ones that it
+ * withholds. Thus a zero-filled block grants all credits.
+ */
+struct unix64_mailbox_credits {
+    struct unix64_event returned; /**< Credit handed back.       */
+    uint32_t withheld ALIGN(UNIX64_EVENT_ALIGN); /**< Withheld credits. */
+    uint32_t inflight[UNIX64_MAILBOX_PRIORITY_NUM]; /**< Held credits.  */
 };
 
 /**
@@ -80,14 +117,27 @@ PRIVATE struct {
     .rxs[0 ... UNIX64_MAILBOX_CREATE_MAX - 1] =
         {
             .resource = {0},
+            .lock = PTHREAD_MUTEX_INITIALIZER,
         },
 
     .txs[0 ... UNIX64_MAILBOX_OPEN_MAX - 1] =
         {
             .resource = {0},
+            .lock = PTHREAD_MUTEX_INITIALIZER,
         },
 };
 
+/**
+ * @brief Mailboxes indexed by NoC node.
+ */
+PRIVATE struct {
+    int rxs[PROCESSOR_NOC_NODES_NUM]; /**< Input mailbox (-1 if none).  */
+    int txs[PROCESSOR_NOC_NODES_NUM]; /**< Output mailbox (-1 if none). */
+} mailboxnodes = {
+    .rxs[0 ... PROCESSOR_NOC_NODES_NUM - 1] = -1,
+    .txs[0 ... PROCESSOR_NOC_NODES_NUM - 1] = -1,
+};
+
 /**
  * @brief Resource pool for mailboxes.
  */
@@ -100,224 +150,1413 @@ PRIVATE struct {
 };
 
 /**
- * @brief Sync module lock.
+ * @brief Mailbox table lock.
+ *
+ * It guards the allocation of mailboxes, the table of mailboxes
+ * indexed by NoC node, reference counters and the cache of NoC
+ * connectors. Everything else in a mailbox is guarded by the lock of
+ * the mailbox itself, which is taken after the table lock whenever
+ * both are needed.
  */
 PRIVATE pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
 
 /**
- * @brief Default message queue attribute.
+ * @brief Cache of idle NoC connectors.
+ *
+ * The NoC connector of an output mailbox only depends on the remote
+ * NoC node, thus it is the key of the cache.
  */
-PRIVATE struct mq_attr mq_attr = {.mq_maxmsg = PROCESSOR_NOC_NODES_NUM,
-                                  .mq_msgsize = UNIX64_MAILBOX_MSG_SIZE};
+PRIVATE struct {
+    unsigned long clock; /**< Logical clock. */
+
+    /**
+     * @brief Cached NoC connectors.
+     */
+    struct {
+        int nodenum; /**< Remote NoC node (-1 if invalid). */
+        union unix64_connector conn; /**< Underlying NoC connector. */
+        unsigned long age; /**< Time of last use.                 */
+    } entries[UNIX64_MAILBOX_CACHE_SIZE];
+} mailboxcache = {
+    .clock = 0,
+    .entries[0 ... UNIX64_MAILBOX_CACHE_SIZE - 1] =
+        {
+            .nodenum = -1,
+        },
+};
 
 /*============================================================================*
- * unix64_mailbox_lock()                                                      *
+ * unix64_mailbox_table_lock()                                                *
  *============================================================================*/
 
 /**
- * @brief Locks Unix mailbox module.
+ * @brief Locks the table of mailboxes.
  */
-PRIVATE void unix64_mailbox_lock(void)
+PRIVATE void unix64_mailbox_table_lock(void)
 {
     pthread_mutex_lock(&lock);
 }
 
 /*============================================================================*
- * unix64_mailbox_unlock()                                                    *
+ * unix64_mailbox_table_unlock()                                              *
  *============================================================================*/
 
 /**
- * @brief Unlocks Unix mailbox module.
+ * @brief Unlocks the table of mailboxes.
  */
-PRIVATE void unix64_mailbox_unlock(void)
+PRIVATE void unix64_mailbox_table_unlock(void)
 {
     pthread_mutex_unlock(&lock);
 }
 
 /*============================================================================*
- * unix64_mailbox_create()                                                    *
+ * unix64_mailbox_lock()                                                      *
  *============================================================================*/
 
 /**
- * @brief See unix64_mailbox_create().
+ * @brief Locks a mailbox.
+ *
+ * @param mbx Target mailbox.
  */
-PRIVATE int do_unix64_mailbox_create(int nodenum)
+PRIVATE void unix64_mailbox_lock(struct mailbox *mbx)
 {
-    int mbxid;      /* Mailbox ID.         */
-    int fd;         /* NoC connector.      */
-    char *pathname; /* NoC connector name. */
+    pthread_mutex_lock(&mbx->lock);
+}
 
-    /* Check if input mailbox was already created. */
-    for (int i = 0; i < UNIX64_MAILBOX_CREATE_MAX; i++) {
-        /* Skip invalid entries. */
-        if (!resource_is_used(&mailboxtab.rxs[i].resource))
+/*============================================================================*
+ * unix64_mailbox_unlock()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Unlocks a mailbox.
+ *
+ * @param mbx Target mailbox.
+ */
+PRIVATE void unix64_mailbox_unlock(struct mailbox *mbx)
+{
+    pthread_mutex_unlock(&mbx->lock);
+}
+
+/*============================================================================*
+ * unix64_mailbox_set_notbusy()                                               *
+ *============================================================================*/
+
+/**
+ * @brief Clears the busy flag of a mailbox.
+ *
+ * @param mbx Target mailbox.
+ *
+ * Threads that wait for the mailbox to become idle are woken up.
+ */
+PRIVATE void unix64_mailbox_set_notbusy(struct mailbox *mbx)
+{
+    resource_set_notbusy(&mbx->resource);
+    unix64_event_notify(&mbx->idle);
+}
+
+/*============================================================================*
+ * unix64_mailbox_error_take()                                                *
+ *============================================================================*/
+
+/**
+ * @brief Takes the error that a partial batch deferred on a mailbox.
+ *
+ * @param mbx Target mailbox.
+ *
+ * @returns The deferred error, or zero if there is none.
+ *
+ * @note The caller must hold the lock of @p mbx.
+ */
+PRIVATE int unix64_mailbox_error_take(struct mailbox *mbx)
+{
+    int err;
+
+    err = mbx->error;
+    mbx->error = 0;
+
+    return (err);
+}
+
+/*============================================================================*
+ * unix64_mailbox_credits_get()                                               *
+ *============================================================================*/
+
+/**
+ * @brief Gets the send credits of a NoC node.
+ *
+ * @param nodenum Target NoC node.
+ *
+ * @returns The send credits of @p nodenum.
+ */
+PRIVATE inline struct unix64_mailbox_credits *
+unix64_mailbox_credits_get(int nodenum)
+{
+    return (linux64_processor_noc_arena_credit(nodenum));
+}
+
+/*============================================================================*
+ * unix64_mailbox_credits_available()                                         *
+ *============================================================================*/
+
+/**
+ * @brief Counts the available send credits of a priority class.
+ *
+ * @param nodenum  Target NoC node.
+ * @param priority Target priority class.
+ *
+ * @returns The number of messages of class @p priority that may be
+ * sent to @p nodenum right now.
+ */
+PRIVATE int unix64_mailbox_credits_available(int nodenum, int priority)
+{
+    uint32_t granted;
+    uint32_t inflight;
+    struct unix64_mailbox_credits *credits;
+
+    credits = unix64_mailbox_credits_get(nodenum);
+
+    granted = UNIX64_MAILBOX_DEPTH -
+              __atomic_load_n(&credits->withheld, __ATOMIC_RELAXED);
+    inflight = __atomic_load_n(&credits->inflight[priority], __ATOMIC_RELAXED);
+
+    return ((inflight < granted) ? (int)(granted - inflight) : 0);
+}
+
+/*============================================================================*
+ * unix64_mailbox_credit_acquire()                                            *
+ *============================================================================*/
+
+/**
+ * @brief Acquires a send credit of a priority class.
+ *
+ * @param nodenum  Target NoC node.
+ * @param priority Target priority class.
+ * @param deadline Deadline for waiting on a credit.
+ *
+ * @returns Upon successful completion, one is returned. If the
+ * deadline expires, zero is returned instead.
+ *
+ * @note This function is lock-free.
+ */
+PRIVATE int unix64_mailbox_credit_acquire(
+    int nodenum, int priority, const struct unix64_deadline *deadline)
+{
+    uint32_t granted;
+    uint32_t counter;
+    uint32_t inflight;
+    struct unix64_mailbox_credits *credits;
+
+    credits = unix64_mailbox_credits_get(nodenum);
+
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&credits->returned);
+
+        inflight =
+            __atomic_load_n(&credits->inflight[priority], __ATOMIC_RELAXED);
+
+        do {
+            granted = UNIX64_MAILBOX_DEPTH -
+                      __atomic_load_n(&credits->withheld, __ATOMIC_RELAXED);
+
+            /* No credits left. */
+            if (inflight >= granted)
+                break;
+
+            if (__atomic_compare_exchange_n(&credits->inflight[priority],
+                                            &inflight,
+                                            inflight + 1,
+                                            1,
+                                            __ATOMIC_ACQUIRE,
+                                            __ATOMIC_RELAXED))
+                return (1);
+        } while (1);
+
+    } while (unix64_event_wait(&credits->returned, counter, deadline) == 0);
+
+    return (0);
+}
+
+/*============================================================================*
+ * unix64_mailbox_credit_return()                                             *
+ *============================================================================*/
+
+/**
+ * @brief Hands a send credit of a priority class back to senders.
+ *
+ * @param nodenum  Target NoC node.
+ * @param priority Target priority class.
+ *
+ * @note Out of range classes, which do not come from this module, are
+ * ignored.
+ */
+PRIVATE void unix64_mailbox_credit_return(int nodenum, int priority)
+{
+    uint32_t inflight;
+    struct unix64_mailbox_credits *credits;
+
+    /* Foreign message. */
+    if (!WITHIN(priority, 0, UNIX64_MAILBOX_PRIORITY_NUM))
+        return;
+
+    credits = unix64_mailbox_credits_get(nodenum);
+
+    inflight = __atomic_load_n(&credits->inflight[priority], __ATOMIC_RELAXED);
+
+    do {
+        /* Nothing to hand back. */
+        if (inflight == 0)
+            return;
+    } while (!__atomic_compare_exchange_n(&credits->inflight[priority],
+                                          &inflight,
+                                          inflight - 1,
+                                          1,
+                                          __ATOMIC_RELEASE,
+                                          __ATOMIC_RELAXED));
+
+    unix64_event_notify(&credits->returned);
+}
+
+/*============================================================================*
+ * unix64_mailbox_credits_grant()                                             *
+ *============================================================================*/
+
+/**
+ * @brief Sets the number of send credits that a NoC node grants.
+ *
+ * @param nodenum Target NoC node.
+ * @param ncredits Number of credits granted per priority class.
+ *
+ * @note Credits that are in flight are not revoked, so senders only
+ * notice a smaller grant as messages are consumed.
+ */
+PRIVATE void unix64_mailbox_credits_grant(int nodenum, int ncredits)
+{
+    struct unix64_mailbox_credits *credits;
+
+    KASSERT(WITHIN(ncredits, 1, UNIX64_MAILBOX_DEPTH + 1));
+
+    credits = unix64_mailbox_credits_get(nodenum);
+
+    __atomic_store_n(
+        &credits->withheld, UNIX64_MAILBOX_DEPTH - ncredits, __ATOMIC_RELAXED);
+
+    /* Senders may have more credits now. */
+    unix64_event_notify(&credits->returned);
+}
+
+/*============================================================================*
+ * unix64_mailbox_connect()                                                   *
+ *============================================================================*/
+
+/**
+ * @brief Opens the NoC connector of a mailbox.
+ *
+ * @param mbx   Target mailbox.
+ * @param flags Access mode of the NoC connector.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative number is returned instead.
+ */
+PRIVATE int unix64_mailbox_connect(struct mailbox *mbx, int flags)
+{
+    return (unix64_transport_get()->connect(&mbx->conn, mbx->pathname, flags));
+}
+
+/*============================================================================*
+ * unix64_mailbox_disconnect()                                                *
+ *============================================================================*/
+
+/**
+ * @brief Closes the NoC connector of a mailbox.
+ *
+ * @param mbx   Target mailbox.
+ * @param drain Drop pending messages?
+ *
+ * @note The NoC connector is not removed from the system, because
+ * other processes may have cached it. Pending messages are dropped
+ * instead, so that they are not delivered to the next input mailbox
+ * of the same NoC node.
+ */
+PRIVATE void unix64_mailbox_disconnect(struct mailbox *mbx, int drain)
+{
+    int lane;
+    char msg[UNIX64_MAILBOX_MSG_SIZE_MAX];
+    struct unix64_deadline deadline;
+    const struct unix64_transport *transport;
+
+    transport = unix64_transport_get();
+
+    if (drain) {
+        /* Do not block. */
+        unix64_deadline_set(&deadline, 0);
+
+        while (transport->recv(
+                   &mbx->conn, msg, sizeof(msg), &lane, &deadline) >= 0)
+            unix64_mailbox_credit_return(mbx->nodenum, lane);
+        mbx->pending = 0;
+    }
+
+    transport->disconnect(&mbx->conn);
+}
+
+/*============================================================================*
+ * unix64_mailbox_cache_get()                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Gets the NoC connector of an output mailbox from the cache.
+ *
+ * @param mbx Target mailbox.
+ *
+ * @returns If the NoC connector is cached, zero is returned.
+ * Otherwise, a negative number is returned instead.
+ *
+ * @note The caller must hold the mailbox table lock.
+ */
+PRIVATE int unix64_mailbox_cache_get(struct mailbox *mbx)
+{
+    for (int i = 0; i < UNIX64_MAILBOX_CACHE_SIZE; i++) {
+        /* Not this node ID. */
+        if (mailboxcache.entries[i].nodenum != mbx->nodenum)
             continue;
 
-        /* Found. */
-        if (mailboxtab.rxs[i].nodenum == nodenum)
-            return (-EEXIST);
+        mbx->conn = mailboxcache.entries[i].conn;
+        mailboxcache.entries[i].nodenum = -1;
+
+        return (0);
     }
 
-    /* Allocate a mailbox. */
-    if ((mbxid = resource_alloc(&pool.rx)) < 0)
-        goto error0;
+    return (-1);
+}
 
-    pathname = mailboxtab.rxs[mbxid].pathname;
+/*============================================================================*
+ * unix64_mailbox_cache_put()                                                 *
+ *============================================================================*/
 
-    /* Build pathname for NoC connector. */
-    sprintf(pathname, "/%s-%d", UNIX64_MAILBOX_BASENAME, nodenum);
+/**
+ * @brief Hands the idle NoC connector of an output mailbox to the
+ * cache.
+ *
+ * @param mbx     Target mailbox.
+ * @param evicted Place where the evicted NoC connector should be
+ * stored.
+ *
+ * @returns If the cache is full, the least recently used NoC connector
+ * is evicted to @p evicted and non-zero is returned. Otherwise, zero
+ * is returned instead.
+ *
+ * @note The caller must hold the mailbox table lock, and it should
+ * close the evicted NoC connector after releasing it.
+ */
+PRIVATE int unix64_mailbox_cache_put(struct mailbox *mbx,
+                                     struct mailbox *evicted)
+{
+    int victim = 0;
+    int nevicted = 0;
+
+    for (int i = 0; i < UNIX64_MAILBOX_CACHE_SIZE; i++) {
+        /* Free entry. */
+        if (mailboxcache.entries[i].nodenum < 0) {
+            victim = i;
+            break;
+        }
 
-    /* Open NoC connector. */
-    if ((fd = mq_open(pathname,
-                      O_RDONLY | O_CREAT | O_NONBLOCK,
-                      S_IRUSR | S_IWUSR,
-                      &mq_attr)) == -1)
-        goto error1;
+        /* Least recently used entry. */
+        if (mailboxcache.entries[i].age < mailboxcache.entries[victim].age)
+            victim = i;
+    }
 
-    /* Initialize mailbox. */
-    mailboxtab.rxs[mbxid].fd = fd;
-    mailboxtab.rxs[mbxid].nodenum = nodenum;
-    mailboxtab.rxs[mbxid].refcount = 1;
-    resource_set_rdonly(&mailboxtab.rxs[mbxid].resource);
-    resource_set_notbusy(&mailboxtab.rxs[mbxid].resource);
+    /* Evict. */
+    if (mailboxcache.entries[victim].nodenum >= 0) {
+        evicted->conn = mailboxcache.entries[victim].conn;
+        nevicted = 1;
+    }
 
-    return (mbxid);
+    mailboxcache.entries[victim].nodenum = mbx->nodenum;
+    mailboxcache.entries[victim].conn = mbx->conn;
+    mailboxcache.entries[victim].age = ++mailboxcache.clock;
 
-error1:
-    resource_free(&pool.rx, mbxid);
-error0:
-    return (-EAGAIN);
+    return (nevicted);
 }
 
+/*============================================================================*
+ * unix64_mailbox_cache_flush()                                               *
+ *============================================================================*/
+
 /**
- * @todo TODO: provide a detailed description for this function.
- *
- * @note This function is blocking.
- * @note This function is thread-safe.
- * @note This function is reentrant.
+ * The unix64_mailbox_cache_flush() function closes all NoC connectors
+ * that are cached by the calling process. NoC connectors of
+ * mailboxes that are still open are not affected. Each NoC connector
+ * is closed after it leaves the cache, with no lock held.
  */
-PUBLIC int unix64_mailbox_create(int nodenum)
+PUBLIC void unix64_mailbox_cache_flush(void)
 {
-    int mbxid;
+    int nevicted;
+    struct mailbox evicted;
 
-    unix64_mailbox_lock();
-    mbxid = do_unix64_mailbox_create(nodenum);
-    unix64_mailbox_unlock();
+    for (int i = 0; i < UNIX64_MAILBOX_CACHE_SIZE; i++) {
+        unix64_mailbox_table_lock();
 
-    return (mbxid);
+        /* Take valid entry. */
+        if ((nevicted = (mailboxcache.entries[i].nodenum >= 0))) {
+            evicted.conn = mailboxcache.entries[i].conn;
+            mailboxcache.entries[i].nodenum = -1;
+        }
+
+        unix64_mailbox_table_unlock();
+
+        if (nevicted)
+            unix64_mailbox_disconnect(&evicted, 0);
+    }
 }
 
 /*============================================================================*
- * unix64_mailbox_open()                                                      *
+ * unix64_mailbox_push()                                                      *
  *============================================================================*/
 
 /**
- * @brief See unix64_mailbox_open().
+ * @brief Pushes a message into the NoC connector of a mailbox.
+ *
+ * @param mbx      Target mailbox.
+ * @param priority Priority class of the message.
+ * @param buf      Message.
+ * @param n        Size of the message.
+ * @param deadline Deadline for waiting on a full NoC connector.
+ *
+ * @returns Upon successful completion, one is returned. If the
+ * deadline expires, zero is returned. Upon failure, a negative error
+ * code is returned instead.
+ *
+ * @note The caller must hold a send credit of class @p priority.
  */
-PRIVATE int do_unix64_mailbox_open(int nodenum)
+PRIVATE int unix64_mailbox_push(struct mailbox *mbx, int priority,
+                                const void *buf, size_t n,
+                                const struct unix64_deadline *deadline)
 {
-    int mbxid;      /* Mailbox ID.         */
-    int fd;         /* NoC connector.      */
-    char *pathname; /* NoC connector name. */
+    int ret;
 
-    /* Allocate a mailbox. */
-    if ((mbxid = resource_alloc(&pool.tx)) < 0)
-        goto error0;
+    if ((ret = unix64_transport_get()->send(
+             &mbx->conn, priority, buf, n, deadline)) == -ETIMEDOUT)
+        return (0);
 
-    pathname = mailboxtab.txs[mbxid].pathname;
+    if (ret < 0)
+        return (ret);
 
-    /* Build pathname for NoC connector. */
-    sprintf(pathname, "/%s-%d", UNIX64_MAILBOX_BASENAME, nodenum);
+    unix64_doorbell_ring(mbx->nodenum);
 
-    /* Open NoC connector. */
-    if ((fd = mq_open(pathname,
-                      O_WRONLY | O_CREAT | O_NONBLOCK,
-                      S_IRUSR | S_IWUSR,
-                      &mq_attr)) == -1)
-        goto error1;
+    return (1);
+}
 
-    /* Initialize mailbox. */
-    mailboxtab.txs[mbxid].fd = fd;
-    mailboxtab.txs[mbxid].nodenum = nodenum;
-    mailboxtab.txs[mbxid].refcount = 1;
-    resource_set_wronly(&mailboxtab.txs[mbxid].resource);
-    resource_set_notbusy(&mailboxtab.txs[mbxid].resource);
+/*============================================================================*
+ * unix64_mailbox_send()                                                      *
+ *============================================================================*/
 
-    return (mbxid);
+/**
+ * @brief Sends a message through the NoC connector of a mailbox.
+ *
+ * @param mbx      Target mailbox.
+ * @param buf      Message.
+ * @param n        Size of the message.
+ * @param deadline Deadline for waiting on a send credit or a full NoC
+ * connector.
+ *
+ * @returns Upon successful completion, one is returned. If the
+ * deadline expires, zero is returned. Upon failure, a negative error
+ * code is returned instead.
+ */
+PRIVATE int unix64_mailbox_send(struct mailbox *mbx, const void *buf, size_t n,
+                                const struct unix64_deadline *deadline)
+{
+    int ret;
+    int priority;
 
-error1:
-    resource_free(&pool.tx, mbxid);
-error0:
-    return (-EAGAIN);
+    priority = mbx->priority;
+
+    if (!unix64_mailbox_credit_acquire(mbx->nodenum, priority, deadline))
+        return (0);
+
+    if ((ret = unix64_mailbox_push(mbx, priority, buf, n, deadline)) <= 0)
+        unix64_mailbox_credit_return(mbx->nodenum, priority);
+
+    return (ret);
 }
 
+/*============================================================================*
+ * unix64_mailbox_recv()                                                      *
+ *============================================================================*/
+
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Receives a message from the NoC connector of a mailbox.
  *
- * @note This function is blocking.
- * @note This function is thread-safe.
- * @note This function is reentrant.
+ * @param mbx      Target mailbox.
+ * @param buf      Target buffer.
+ * @param n        Size of the target buffer.
+ * @param deadline Deadline for waiting on an empty NoC connector.
+ *
+ * @returns Upon successful completion, the number of bytes received
+ * is returned. If the deadline expires, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note If the message does not fit in @p buf, -EMSGSIZE is returned
+ * and the message is left in the NoC connector. Transports that do
+ * not feature UNIX64_TRANSPORT_INPLACE do not allow that, thus a short
+ * buffer receives through the staging buffer of the mailbox, where an
+ * oversized message is kept until a subsequent receive.
  */
-PUBLIC int unix64_mailbox_open(int nodenum)
+PRIVATE ssize_t unix64_mailbox_recv(struct mailbox *mbx, void *buf, size_t n,
+                                    const struct unix64_deadline *deadline)
 {
-    int mbxid;
+    char *p;
+    int lane;
+    size_t len;
+    ssize_t nread;
+    const struct unix64_transport *transport;
+
+    transport = unix64_transport_get();
+
+    /* Deliver message left over by a previous receive. */
+    if (mbx->pending > 0) {
+        if ((nread = mbx->pending) > (ssize_t)n)
+            return (-EMSGSIZE);
+
+        if (buf != mbx->staging)
+            kmemcpy(buf, mbx->staging, nread);
+        mbx->pending = 0;
+
+        return (nread);
+    }
+
+    /* Transport does not receive into short buffers. */
+    p = buf;
+    len = n;
+    if (!(transport->flags & UNIX64_TRANSPORT_INPLACE) &&
+        (n < UNIX64_MAILBOX_MSG_SIZE_MAX)) {
+        p = mbx->staging;
+        len = UNIX64_MAILBOX_MSG_SIZE_MAX;
+    }
+
+    if ((nread = transport->recv(&mbx->conn, p, len, &lane, deadline)) ==
+        -ETIMEDOUT)
+        return (0);
+
+    if (nread < 0)
+        return (nread);
+
+    unix64_mailbox_credit_return(mbx->nodenum, lane);
+
+    if (p != buf) {
+        /* Keep oversized message for a subsequent receive. */
+        if (nread > (ssize_t)n) {
+            mbx->pending = nread;
+            return (-EMSGSIZE);
+        }
+
+        kmemcpy(buf, p, nread);
+    }
+
+    return (nread);
+}
+
+/*============================================================================*
+ * unix64_mailbox_claim()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Claims room for a message in the NoC connector of a mailbox.
+ *
+ * @param mbx      Target mailbox.
+ * @param buf      Place where the claimed room should be stored.
+ * @param deadline Deadline for waiting on a full NoC connector.
+ *
+ * @returns Upon successful completion, one is returned. If the
+ * deadline expires, zero is returned instead.
+ *
+ * @note A send credit is acquired for the message.
+ * @note If the transport does not feature UNIX64_TRANSPORT_INPLACE,
+ * the staging buffer of the mailbox is handed out instead.
+ */
+PRIVATE int unix64_mailbox_claim(struct mailbox *mbx, void **buf,
+                                 const struct unix64_deadline *deadline)
+{
+    const struct unix64_transport *transport;
+
+    transport = unix64_transport_get();
+
+    /* Stick to this class, even if the priority changes meanwhile. */
+    mbx->lane = mbx->priority;
+
+    if (!unix64_mailbox_credit_acquire(mbx->nodenum, mbx->lane, deadline))
+        return (0);
+
+    if (!(transport->flags & UNIX64_TRANSPORT_INPLACE)) {
+        *buf = mbx->staging;
+        return (1);
+    }
+
+    if ((*buf = transport->reserve(
+             &mbx->conn, mbx->lane, &mbx->pos, deadline)) == NULL) {
+        unix64_mailbox_credit_return(mbx->nodenum, mbx->lane);
+        return (0);
+    }
+
+    return (1);
+}
+
+/*============================================================================*
+ * unix64_mailbox_publish()                                                   *
+ *============================================================================*/
+
+/**
+ * @brief Publishes a message claimed with unix64_mailbox_claim().
+ *
+ * @param mbx      Target mailbox.
+ * @param deadline Deadline for waiting on a full NoC connector.
+ *
+ * @returns Upon successful completion, one is returned. If the
+ * deadline expires, zero is returned. Upon failure, a negative error
+ * code is returned instead.
+ */
+PRIVATE int unix64_mailbox_publish(struct mailbox *mbx,
+                                   const struct unix64_deadline *deadline)
+{
+    int ret;
+    const struct unix64_transport *transport;
+
+    transport = unix64_transport_get();
+
+    if (transport->flags & UNIX64_TRANSPORT_INPLACE) {
+        transport->commit(
+            &mbx->conn, mbx->lane, mbx->pos, UNIX64_MAILBOX_MSG_SIZE);
+        unix64_doorbell_ring(mbx->nodenum);
+        return (1);
+    }
+
+    if ((ret = unix64_mailbox_push(mbx,
+                                   mbx->lane,
+                                   mbx->staging,
+                                   UNIX64_MAILBOX_MSG_SIZE,
+                                   deadline)) <= 0)
+        unix64_mailbox_credit_return(mbx->nodenum, mbx->lane);
+
+    return (ret);
+}
+
+/*============================================================================*
+ * unix64_mailbox_front()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Gets the oldest message of the NoC connector of a mailbox.
+ *
+ * @param mbx      Target mailbox.
+ * @param buf      Place where the message should be stored.
+ * @param deadline Deadline for waiting on an empty NoC connector.
+ *
+ * @returns Upon successful completion, the size of the message is
+ * returned. If the deadline expires, zero is returned. Upon failure,
+ * a negative error code is returned instead.
+ *
+ * @note If the transport does not feature UNIX64_TRANSPORT_INPLACE,
+ * the message is received in the staging buffer of the mailbox, and
+ * its send credit is handed back right away.
+ */
+PRIVATE ssize_t unix64_mailbox_front(struct mailbox *mbx, void **buf,
+                                     const struct unix64_deadline *deadline)
+{
+    size_t n;
+    const struct unix64_transport *transport;
+
+    transport = unix64_transport_get();
+
+    if (!(transport->flags & UNIX64_TRANSPORT_INPLACE)) {
+        *buf = mbx->staging;
+
+        return (unix64_mailbox_recv(
+            mbx, mbx->staging, UNIX64_MAILBOX_MSG_SIZE_MAX, deadline));
+    }
+
+    if ((*buf = transport->peek(&mbx->conn, &n, &mbx->lane, deadline)) ==
+        NULL)
+        return (0);
+
+    return (n);
+}
+
+/*============================================================================*
+ * unix64_mailbox_retire()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Consumes a message got with unix64_mailbox_front().
+ *
+ * @param mbx Target mailbox.
+ */
+PRIVATE void unix64_mailbox_retire(struct mailbox *mbx)
+{
+    const struct unix64_transport *transport;
+
+    transport = unix64_transport_get();
+
+    /* Credit was handed back on receive. */
+    if (!(transport->flags & UNIX64_TRANSPORT_INPLACE))
+        return;
+
+    transport->release(&mbx->conn, mbx->lane);
+    unix64_mailbox_credit_return(mbx->nodenum, mbx->lane);
+}
+
+/*============================================================================*
+ * unix64_mailbox_create()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief See unix64_mailbox_create().
+ */
+PRIVATE int do_unix64_mailbox_create(int nodenum)
+{
+    int mbxid;           /* Mailbox ID.         */
+    struct mailbox *mbx; /* Mailbox.            */
+
+    unix64_mailbox_table_lock();
+
+    /* Check if input mailbox was already created. */
+    if (mailboxnodes.rxs[nodenum] >= 0) {
+        unix64_mailbox_table_unlock();
+        return (-EEXIST);
+    }
+
+    /* Allocate a mailbox. */
+    if ((mbxid = resource_alloc(&pool.rx)) < 0) {
+        unix64_mailbox_table_unlock();
+        return (-EAGAIN);
+    }
+
+    mbx = &mailboxtab.rxs[mbxid];
+
+    /*
+     * Set mailbox as busy, before releasing the lock,
+     * because we may sleep below.
+     */
+    unix64_mailbox_lock(mbx);
+    resource_set_busy(&mbx->resource);
+    unix64_mailbox_unlock(mbx);
+
+    mailboxnodes.rxs[nodenum] = mbxid;
+
+    unix64_mailbox_table_unlock();
+
+    /* Build pathname for NoC connector. */
+    sprintf(mbx->pathname, "/%s-%d", UNIX64_MAILBOX_BASENAME, nodenum);
+
+    /* Open NoC connector. */
+    if (unix64_mailbox_connect(mbx, O_RDONLY) < 0)
+        goto error;
+
+    /* Initialize mailbox. */
+    unix64_mailbox_lock(mbx);
+    mbx->nodenum = nodenum;
+    mbx->refcount = 1;
+    mbx->timeout = UNIX64_MAILBOX_TIMEOUT;
+    mbx->slot = NULL;
+    mbx->pending = 0;
+    mbx->error = 0;
+    resource_set_rdonly(&mbx->resource);
+    unix64_mailbox_set_notbusy(mbx);
+    unix64_mailbox_unlock(mbx);
+
+    return (mbxid);
+
+error:
+    unix64_mailbox_table_lock();
+    mailboxnodes.rxs[nodenum] = -1;
+    unix64_mailbox_lock(mbx);
+    resource_free(&pool.rx, mbxid);
+    unix64_mailbox_unlock(mbx);
+    unix64_mailbox_table_unlock();
+    return (-EAGAIN);
+}
+
+/**
+ * The unix64_mailbox_create() function creates an input mailbox in the
+ * NoC node @p nodenum. The NoC connector of the mailbox is opened with
+ * no lock held, and the mailbox stays busy meanwhile.
+ *
+ * @note This function is blocking.
+ * @note This function is thread-safe.
+ * @note This function is reentrant.
+ */
+PUBLIC int unix64_mailbox_create(int nodenum)
+{
+    return (do_unix64_mailbox_create(nodenum));
+}
+
+/*============================================================================*
+ * unix64_mailbox_open()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief See unix64_mailbox_open().
+ *
+ * @note The caller must hold the mailbox table lock, which is released
+ * by this function.
+ */
+PRIVATE int do_unix64_mailbox_open(int nodenum)
+{
+    int mbxid;           /* Mailbox ID.         */
+    struct mailbox *mbx; /* Mailbox.            */
+
+    /* Allocate a mailbox. */
+    if ((mbxid = resource_alloc(&pool.tx)) < 0) {
+        unix64_mailbox_table_unlock();
+        return (-EAGAIN);
+    }
+
+    mbx = &mailboxtab.txs[mbxid];
+
+    /*
+     * Set mailbox as busy, before releasing the lock,
+     * because we may sleep below.
+     */
+    unix64_mailbox_lock(mbx);
+    resource_set_busy(&mbx->resource);
+    unix64_mailbox_unlock(mbx);
+
+    mbx->nodenum = nodenum;
+    mbx->refcount = 1;
+    mailboxnodes.txs[nodenum] = mbxid;
+
+    /* Build pathname for NoC connector. */
+    sprintf(mbx->pathname, "/%s-%d", UNIX64_MAILBOX_BASENAME, nodenum);
+
+    /* Open NoC connector, unless it is cached. */
+    if (unix64_mailbox_cache_get(mbx) < 0) {
+        unix64_mailbox_table_unlock();
+
+        if (unix64_mailbox_connect(mbx, O_WRONLY) < 0)
+            goto error;
+    } else
+        unix64_mailbox_table_unlock();
+
+    /* Initialize mailbox. */
+    unix64_mailbox_lock(mbx);
+    mbx->timeout = UNIX64_MAILBOX_TIMEOUT;
+    mbx->priority = UNIX64_MAILBOX_PRIORITY_NORMAL;
+    mbx->slot = NULL;
+    mbx->error = 0;
+    resource_set_wronly(&mbx->resource);
+    unix64_mailbox_set_notbusy(mbx);
+    unix64_mailbox_unlock(mbx);
+
+    return (mbxid);
+
+error:
+    unix64_mailbox_table_lock();
+    mailboxnodes.txs[nodenum] = -1;
+    unix64_mailbox_lock(mbx);
+    resource_free(&pool.tx, mbxid);
+    unix64_mailbox_unlock(mbx);
+    unix64_mailbox_table_unlock();
+    return (-EAGAIN);
+}
+
+/**
+ * @brief Spin wait counters of unix64_mailbox_open().
+ */
+PRIVATE struct spinwait_stats mailbox_open_stats =
+    SPINWAIT_STATS_INITIALIZER("unix64_mailbox_open");
+
+/**
+ * The unix64_mailbox_open() function opens an output mailbox to the
+ * NoC node @p nodenum. Output mailboxes are looked up by NoC node, and
+ * an output mailbox that is already open to @p nodenum is shared.
+ *
+ * @note This function is blocking.
+ * @note This function is thread-safe.
+ * @note This function is reentrant.
+ */
+PUBLIC int unix64_mailbox_open(int nodenum)
+{
+    int mbxid;
+    struct mailbox *mbx;
+    uint32_t counter;
+    struct spinwait waiter;
+
+    spinwait_init(&waiter, &mailbox_open_stats);
+
+again:
+
+    unix64_mailbox_table_lock();
+
+    /* Open a new mailbox. */
+    if ((mbxid = mailboxnodes.txs[nodenum]) < 0)
+        return (do_unix64_mailbox_open(nodenum));
+
+    mbx = &mailboxtab.txs[mbxid];
+
+    unix64_mailbox_lock(mbx);
+
+    /*
+     * Found, but mailbox is busy
+     * We have to wait a bit more.
+     */
+    if (resource_is_busy(&mbx->resource)) {
+        counter = unix64_event_counter(&mbx->idle);
+        unix64_mailbox_unlock(mbx);
+        unix64_mailbox_table_unlock();
+        unix64_event_spinwait(&mbx->idle, counter, &waiter);
+        goto again;
+    }
+
+    /* Duplicate the underlying NoC connector. */
+    mbx->refcount++;
+
+    unix64_mailbox_unlock(mbx);
+    unix64_mailbox_table_unlock();
+
+    return (mbxid);
+}
+
+/*============================================================================*
+ * unix64_mailbox_unlink()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Spin wait counters of unix64_mailbox_unlink().
+ */
+PRIVATE struct spinwait_stats mailbox_unlink_stats =
+    SPINWAIT_STATS_INITIALIZER("unix64_mailbox_unlink");
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ *
+ * @note This function is blocking.
+ * @note This function is thread-safe.
+ * @note This function is reentrant.
+ */
+PRIVATE int do_unix64_mailbox_unlink(int mbxid)
+{
+    struct mailbox *mbx;
+    uint32_t counter;
+    struct spinwait waiter;
+
+    mbx = &mailboxtab.rxs[mbxid];
+
+    spinwait_init(&waiter, &mailbox_unlink_stats);
+
+again:
+
+    unix64_mailbox_lock(mbx);
+
+    /* Bad mailbox. */
+    if (!resource_is_used(&mbx->resource)) {
+        unix64_mailbox_unlock(mbx);
+        return (-EBADF);
+    }
+
+    /* Busy mailbox. */
+    if (resource_is_busy(&mbx->resource)) {
+        counter = unix64_event_counter(&mbx->idle);
+        unix64_mailbox_unlock(mbx);
+        unix64_event_spinwait(&mbx->idle, counter, &waiter);
+        goto again;
+    }
+
+    /*
+     * Set mailbox as busy, before releasing the lock,
+     * because we may sleep below.
+     */
+    resource_set_busy(&mbx->resource);
+
+    unix64_mailbox_unlock(mbx);
+
+    /* Release underlying NoC connector. */
+    unix64_mailbox_disconnect(mbx, 1);
+
+    /* Grant all credits to the next input mailbox. */
+    unix64_mailbox_credits_grant(mbx->nodenum, UNIX64_MAILBOX_DEPTH);
+
+    unix64_mailbox_table_lock();
+    mailboxnodes.rxs[mbx->nodenum] = -1;
+    unix64_mailbox_lock(mbx);
+    unix64_mailbox_set_notbusy(mbx);
+    resource_free(&pool.rx, mbxid);
+    unix64_mailbox_unlock(mbx);
+    unix64_mailbox_table_unlock();
+
+    return (0);
+}
+
+/**
+ * @see do_unix64_mailbox_unlink().
+ */
+PUBLIC int unix64_mailbox_unlink(int mbxid)
+{
+    return (do_unix64_mailbox_unlink(mbxid));
+}
+
+/*============================================================================*
+ * unix64_mailbox_close()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Spin wait counters of unix64_mailbox_close().
+ */
+PRIVATE struct spinwait_stats mailbox_close_stats =
+    SPINWAIT_STATS_INITIALIZER("unix64_mailbox_close");
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ *
+ * @note This function is blocking.
+ * @note This function is thread-safe.
+ * @note This function is reentrant.
+ */
+PRIVATE int do_unix64_mailbox_close(int mbxid)
+{
+    int nevicted;
+    struct mailbox *mbx;
+    struct mailbox evicted;
+    uint32_t counter;
+    struct spinwait waiter;
+
+    mbx = &mailboxtab.txs[mbxid];
+
+    spinwait_init(&waiter, &mailbox_close_stats);
+
+again:
+
+    unix64_mailbox_table_lock();
+    unix64_mailbox_lock(mbx);
+
+    /* Bad mailbox. */
+    if (!resource_is_used(&mbx->resource)) {
+        unix64_mailbox_unlock(mbx);
+        unix64_mailbox_table_unlock();
+        return (-EBADF);
+    }
+
+    /* Busy mailbox. */
+    if (resource_is_busy(&mbx->resource)) {
+        counter = unix64_event_counter(&mbx->idle);
+        unix64_mailbox_unlock(mbx);
+        unix64_mailbox_table_unlock();
+        unix64_event_spinwait(&mbx->idle, counter, &waiter);
+        goto again;
+    }
+
+    /*
+     * Decrement reference counter and hand
+     * the underlying NoC connector to the cache.
+     */
+    nevicted = 0;
+    if (mbx->refcount-- == 1) {
+        mailboxnodes.txs[mbx->nodenum] = -1;
+        nevicted = unix64_mailbox_cache_put(mbx, &evicted);
+        resource_free(&pool.tx, mbxid);
+    }
+
+    unix64_mailbox_unlock(mbx);
+    unix64_mailbox_table_unlock();
+
+    /* Close evicted NoC connector with no lock held. */
+    if (nevicted)
+        unix64_mailbox_disconnect(&evicted, 0);
+
+    return (0);
+}
+
+/**
+ * @see do_unix64_mailbox_close().
+ */
+PUBLIC int unix64_mailbox_close(int mbxid)
+{
+    return (do_unix64_mailbox_close(mbxid));
+}
+
+/*============================================================================*
+ * unix64_mailbox_awrite()                                                    *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ *
+ * @note This function is thread-safe.
+ */
+PRIVATE ssize_t do_unix64_mailbox_awrite(int mbxid, const void *buf, size_t n)
+{
+    int err;
+    struct unix64_deadline deadline;
+
+    unix64_mailbox_lock(&mailboxtab.txs[mbxid]);
+
+    /* Bad mailbox. */
+    if (!resource_is_used(&mailboxtab.txs[mbxid].resource)) {
+        err = -EBADF;
+        goto error1;
+    }
+
+    /* Busy mailbox. */
+    if (resource_is_busy(&mailboxtab.txs[mbxid].resource)) {
+        err = -EBUSY;
+        goto error1;
+    }
+
+    /* Error deferred by a partial batch. */
+    if ((err = unix64_mailbox_error_take(&mailboxtab.txs[mbxid])) < 0)
+        goto error1;
+
+    /* Set mailbox as busy. */
+    resource_set_busy(&mailboxtab.txs[mbxid].resource);
+
+    unix64_deadline_set(&deadline, mailboxtab.txs[mbxid].timeout);
+
+    /*
+     * Release lock, since we may sleep below.
+     */
+    unix64_mailbox_unlock(&mailboxtab.txs[mbxid]);
+
+    err = unix64_mailbox_send(&mailboxtab.txs[mbxid], buf, n, &deadline);
+
+    /* Deadline expired. */
+    if (err == 0)
+        err = -ETIMEDOUT;
+
+    if (err < 0)
+        goto error2;
+
+    unix64_mailbox_lock(&mailboxtab.txs[mbxid]);
+    unix64_mailbox_set_notbusy(&mailboxtab.txs[mbxid]);
+    unix64_mailbox_unlock(&mailboxtab.txs[mbxid]);
+
+    return (n);
+
+error2:
+    unix64_mailbox_lock(&mailboxtab.txs[mbxid]);
+    unix64_mailbox_set_notbusy(&mailboxtab.txs[mbxid]);
+error1:
+    unix64_mailbox_unlock(&mailboxtab.txs[mbxid]);
+    return (err);
+}
+
+/**
+ * @see do_unix64_mailbox_awrite().
+ */
+PUBLIC ssize_t unix64_mailbox_awrite(int mbxid, const void *buf, size_t n)
+{
+    return (do_unix64_mailbox_awrite(mbxid, buf, n));
+}
+
+/*============================================================================*
+ * unix64_mailbox_aread()                                                     *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ *
+ * @note This function is thread-safe.
+ */
+PRIVATE ssize_t do_unix64_mailbox_aread(int mbxid, void *buf, size_t n)
+{
+    int err;
+    ssize_t nread;
+    struct unix64_deadline deadline;
+
+    unix64_mailbox_lock(&mailboxtab.rxs[mbxid]);
+
+    /* Bad mailbox. */
+    if (!resource_is_used(&mailboxtab.rxs[mbxid].resource)) {
+        err = -EBADF;
+        goto error1;
+    }
+
+    /* Busy mailbox. */
+    if (resource_is_busy(&mailboxtab.rxs[mbxid].resource)) {
+        err = -EBUSY;
+        goto error1;
+    }
+
+    /* Error deferred by a partial batch. */
+    if ((err = unix64_mailbox_error_take(&mailboxtab.rxs[mbxid])) < 0)
+        goto error1;
+
+    /* Set mailbox as busy. */
+    resource_set_busy(&mailboxtab.rxs[mbxid].resource);
+
+    unix64_deadline_set(&deadline, mailboxtab.rxs[mbxid].timeout);
+
+    /*
+     * Release lock, since we may sleep below.
+     */
+    unix64_mailbox_unlock(&mailboxtab.rxs[mbxid]);
+
+    nread = unix64_mailbox_recv(&mailboxtab.rxs[mbxid], buf, n, &deadline);
+
+    /* Deadline expired. */
+    if (nread == 0)
+        nread = -ETIMEDOUT;
+
+    if (nread < 0) {
+        err = nread;
+        goto error2;
+    }
+
+    unix64_mailbox_lock(&mailboxtab.rxs[mbxid]);
+    unix64_mailbox_set_notbusy(&mailboxtab.rxs[mbxid]);
+    unix64_mailbox_unlock(&mailboxtab.rxs[mbxid]);
+
+    return (nread);
+
+error2:
+    unix64_mailbox_lock(&mailboxtab.rxs[mbxid]);
+    unix64_mailbox_set_notbusy(&mailboxtab.rxs[mbxid]);
+error1:
+    unix64_mailbox_unlock(&mailboxtab.rxs[mbxid]);
+    return (err);
+}
+
+/**
+ * @see do_unix64_mailbox_aread().
+ */
+PUBLIC ssize_t unix64_mailbox_aread(int mbxid, void *buf, size_t n)
+{
+    return (do_unix64_mailbox_aread(mbxid, buf, n));
+}
+
+/*============================================================================*
+ * unix64_mailbox_awritev()                                                   *
+ *============================================================================*/
+
+/**
+ * @brief Writes a batch of messages to a mailbox.
+ *
+ * The mailbox is marked busy once for the whole batch, and the caller
+ * only waits for the first message. If the send credits run out or
+ * the underlying NoC connector fills up after that, the batch is cut
+ * short and the partial count is returned.
+ *
+ * @note If sending fails after some messages were sent, the partial
+ * count is returned, and the error is reported by the next read or
+ * write on the mailbox.
+ * @note This function is thread-safe.
+ */
+PRIVATE int do_unix64_mailbox_awritev(int mbxid, const void *buf, int nmsgs)
+{
+    int err;
+    int nsent;
+    const char *msg;
+    struct unix64_deadline deadline;
+
+    unix64_mailbox_lock(&mailboxtab.txs[mbxid]);
+
+    /* Bad mailbox. */
+    if (!resource_is_used(&mailboxtab.txs[mbxid].resource)) {
+        err = -EBADF;
+        goto error1;
+    }
 
-again:
+    /* Busy mailbox. */
+    if (resource_is_busy(&mailboxtab.txs[mbxid].resource)) {
+        err = -EBUSY;
+        goto error1;
+    }
+
+    /* Error deferred by a partial batch. */
+    if ((err = unix64_mailbox_error_take(&mailboxtab.txs[mbxid])) < 0)
+        goto error1;
 
-    unix64_mailbox_lock();
+    /* Set mailbox as busy. */
+    resource_set_busy(&mailboxtab.txs[mbxid].resource);
+
+    unix64_deadline_set(&deadline, mailboxtab.txs[mbxid].timeout);
 
     /*
-     * Check if we should just duplicate
-     * the underlying file descriptor.
+     * Release lock, since we may sleep below.
      */
-    for (int i = 0; i < UNIX64_MAILBOX_OPEN_MAX; i++) {
-        /* Skip unused mailboxes. */
-        if (!resource_is_used(&mailboxtab.txs[i].resource))
-            continue;
+    unix64_mailbox_unlock(&mailboxtab.txs[mbxid]);
 
-        /* Not this node ID. */
-        if (nodenum != mailboxtab.txs[i].nodenum)
-            continue;
+    nsent = 0;
+    msg = buf;
+    do {
+        /* Out of credits or room, or failed, so hand back the rest. */
+        if ((err = unix64_mailbox_send(&mailboxtab.txs[mbxid],
+                                       msg,
+                                       UNIX64_MAILBOX_MSG_SIZE,
+                                       &deadline)) <= 0)
+            break;
 
-        /*
-         * Found, but mailbox is busy
-         * We have to wait a bit more.
-         */
-        if (resource_is_busy(&mailboxtab.txs[i].resource)) {
-            unix64_mailbox_unlock();
-            goto again;
-        }
+        msg += UNIX64_MAILBOX_MSG_SIZE;
+        nsent++;
+
+        /* Do not wait for the remaining messages. */
+        unix64_deadline_set(&deadline, 0);
+
+    } while (nsent < nmsgs);
 
-        mbxid = i;
-        mailboxtab.txs[i].refcount++;
-        goto out;
+    if (nsent == 0) {
+        /* Deadline expired. */
+        if (err == 0)
+            err = -ETIMEDOUT;
+
+        goto error2;
     }
 
-    mbxid = do_unix64_mailbox_open(nodenum);
+    unix64_mailbox_lock(&mailboxtab.txs[mbxid]);
 
-out:
-    unix64_mailbox_unlock();
-    return (mbxid);
+    /* Report the error on the next call. */
+    if (err < 0)
+        mailboxtab.txs[mbxid].error = err;
+
+    unix64_mailbox_set_notbusy(&mailboxtab.txs[mbxid]);
+    unix64_mailbox_unlock(&mailboxtab.txs[mbxid]);
+
+    return (nsent);
+
+error2:
+    unix64_mailbox_lock(&mailboxtab.txs[mbxid]);
+    unix64_mailbox_set_notbusy(&mailboxtab.txs[mbxid]);
+error1:
+    unix64_mailbox_unlock(&mailboxtab.txs[mbxid]);
+    return (err);
+}
+
+/**
+ * @see do_unix64_mailbox_awritev().
+ */
+PUBLIC int unix64_mailbox_awritev(int mbxid, const void *buf, int nmsgs)
+{
+    return (do_unix64_mailbox_awritev(mbxid, buf, nmsgs));
 }
 
 /*============================================================================*
- * unix64_mailbox_unlink()                                                    *
+ * unix64_mailbox_areadv()                                                    *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Reads a batch of messages from a mailbox.
  *
- * @note This function is blocking.
+ * The mailbox is marked busy once for the whole batch, and the caller
+ * only waits for the first message. After that, the call returns as
+ * soon as the underlying NoC connector is drained.
+ *
+ * @note If receiving fails after some messages were received, the
+ * partial count is returned, and the error is reported by the next
+ * read on the mailbox.
+ * @note Messages are laid out with a fixed stride, thus a message
+ * shorter than UNIX64_MAILBOX_MSG_SIZE ends the batch. It is kept in
+ * the staging buffer of the mailbox, -EMSGSIZE is returned if it is
+ * the first one, and unix64_mailbox_aread() should receive it.
  * @note This function is thread-safe.
- * @note This function is reentrant.
  */
-PRIVATE int do_unix64_mailbox_unlink(int mbxid)
+PRIVATE int do_unix64_mailbox_areadv(int mbxid, void *buf, int nmsgs)
 {
     int err;
+    int nrecv;
+    char *msg;
+    ssize_t nread;
+    struct unix64_deadline deadline;
 
-again:
-
-    unix64_mailbox_lock();
+    unix64_mailbox_lock(&mailboxtab.rxs[mbxid]);
 
     /* Bad mailbox. */
     if (!resource_is_used(&mailboxtab.rxs[mbxid].resource)) {
@@ -327,62 +1566,102 @@ again:
 
     /* Busy mailbox. */
     if (resource_is_busy(&mailboxtab.rxs[mbxid].resource)) {
-        unix64_mailbox_unlock();
-        goto again;
+        err = -EBUSY;
+        goto error1;
     }
 
+    /* Error deferred by a partial batch. */
+    if ((err = unix64_mailbox_error_take(&mailboxtab.rxs[mbxid])) < 0)
+        goto error1;
+
+    /* Set mailbox as busy. */
+    resource_set_busy(&mailboxtab.rxs[mbxid].resource);
+
+    unix64_deadline_set(&deadline, mailboxtab.rxs[mbxid].timeout);
+
     /*
-     * Set mailbox as busy, before releasing the lock,
-     * because we may sleep below.
+     * Release lock, since we may sleep below.
      */
-    resource_set_busy(&mailboxtab.rxs[mbxid].resource);
+    unix64_mailbox_unlock(&mailboxtab.rxs[mbxid]);
 
-    unix64_mailbox_unlock();
+    nrecv = 0;
+    msg = buf;
+    do {
+        /* NoC connector is empty, or failed, so hand back the rest. */
+        if ((nread = unix64_mailbox_recv(&mailboxtab.rxs[mbxid],
+                                         msg,
+                                         UNIX64_MAILBOX_MSG_SIZE,
+                                         &deadline)) <= 0)
+            break;
+
+        /* Keep short message for a subsequent read. */
+        if (nread < UNIX64_MAILBOX_MSG_SIZE) {
+            kmemcpy(mailboxtab.rxs[mbxid].staging, msg, nread);
+            mailboxtab.rxs[mbxid].pending = nread;
+            nread = -EMSGSIZE;
+            break;
+        }
 
-    /* Release underlying message queue. */
-    KASSERT(mq_close(mailboxtab.rxs[mbxid].fd) == 0);
-    KASSERT(mq_unlink(mailboxtab.rxs[mbxid].pathname) == 0);
+        msg += UNIX64_MAILBOX_MSG_SIZE;
+        nrecv++;
 
-    unix64_mailbox_lock();
+        /* Do not wait for the remaining messages. */
+        unix64_deadline_set(&deadline, 0);
 
-    resource_set_notbusy(&mailboxtab.rxs[mbxid].resource);
-    resource_free(&pool.rx, mbxid);
+    } while (nrecv < nmsgs);
 
-    unix64_mailbox_unlock();
+    if (nrecv == 0) {
+        /* Deadline expired. */
+        err = (nread == 0) ? -ETIMEDOUT : nread;
 
-    return (0);
+        goto error2;
+    }
+
+    unix64_mailbox_lock(&mailboxtab.rxs[mbxid]);
+
+    /* Report the error on the next call. A short message reports itself. */
+    if ((nread < 0) && (nread != -EMSGSIZE))
+        mailboxtab.rxs[mbxid].error = nread;
+
+    unix64_mailbox_set_notbusy(&mailboxtab.rxs[mbxid]);
+    unix64_mailbox_unlock(&mailboxtab.rxs[mbxid]);
 
+    return (nrecv);
+
+error2:
+    unix64_mailbox_lock(&mailboxtab.rxs[mbxid]);
+    unix64_mailbox_set_notbusy(&mailboxtab.rxs[mbxid]);
 error1:
-    unix64_mailbox_unlock();
+    unix64_mailbox_unlock(&mailboxtab.rxs[mbxid]);
     return (err);
 }
 
 /**
- * @see do_unix64_mailbox_unlink().
+ * @see do_unix64_mailbox_areadv().
  */
-PUBLIC int unix64_mailbox_unlink(int mbxid)
+PUBLIC int unix64_mailbox_areadv(int mbxid, void *buf, int nmsgs)
 {
-    return (do_unix64_mailbox_unlink(mbxid));
+    return (do_unix64_mailbox_areadv(mbxid, buf, nmsgs));
 }
 
 /*============================================================================*
- * unix64_mailbox_close()                                                     *
+ * unix64_mailbox_reserve()                                                   *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Reserves room for a message in a mailbox.
+ *
+ * The mailbox is kept busy until the message is handed to
+ * unix64_mailbox_commit().
  *
- * @note This function is blocking.
  * @note This function is thread-safe.
- * @note This function is reentrant.
  */
-PRIVATE int do_unix64_mailbox_close(int mbxid)
+PRIVATE int do_unix64_mailbox_reserve(int mbxid, void **buf)
 {
     int err;
+    struct unix64_deadline deadline;
 
-again:
-
-    unix64_mailbox_lock();
+    unix64_mailbox_lock(&mailboxtab.txs[mbxid]);
 
     /* Bad mailbox. */
     if (!resource_is_used(&mailboxtab.txs[mbxid].resource)) {
@@ -392,66 +1671,67 @@ again:
 
     /* Busy mailbox. */
     if (resource_is_busy(&mailboxtab.txs[mbxid].resource)) {
-        unix64_mailbox_unlock();
-        goto again;
+        err = -EBUSY;
+        goto error1;
     }
 
-    /*
-     * Decrement reference counter and release
-     * the underlying file descriptor if we can.
-     */
-    if (mailboxtab.txs[mbxid].refcount-- == 1) {
-        /*
-         * Set mailbox as busy, before releasing the lock,
-         * because we may sleep below.
-         */
-        resource_set_busy(&mailboxtab.txs[mbxid].resource);
+    /* Error deferred by a partial batch. */
+    if ((err = unix64_mailbox_error_take(&mailboxtab.txs[mbxid])) < 0)
+        goto error1;
 
-        unix64_mailbox_unlock();
+    /* Set mailbox as busy. */
+    resource_set_busy(&mailboxtab.txs[mbxid].resource);
 
-        /* Release underlying message queue. */
-        KASSERT(mq_close(mailboxtab.txs[mbxid].fd) == 0);
+    unix64_deadline_set(&deadline, mailboxtab.txs[mbxid].timeout);
 
-        /* Re-acquire lock. */
-        unix64_mailbox_lock();
+    /*
+     * Release lock, since we may sleep below.
+     */
+    unix64_mailbox_unlock(&mailboxtab.txs[mbxid]);
 
-        resource_set_notbusy(&mailboxtab.txs[mbxid].resource);
-        resource_free(&pool.tx, mbxid);
+    /* Deadline expired. */
+    if (unix64_mailbox_claim(&mailboxtab.txs[mbxid], buf, &deadline) == 0) {
+        err = -ETIMEDOUT;
+        goto error2;
     }
 
-    unix64_mailbox_unlock();
+    unix64_mailbox_lock(&mailboxtab.txs[mbxid]);
+    mailboxtab.txs[mbxid].slot = *buf;
+    unix64_mailbox_unlock(&mailboxtab.txs[mbxid]);
 
     return (0);
 
+error2:
+    unix64_mailbox_lock(&mailboxtab.txs[mbxid]);
+    unix64_mailbox_set_notbusy(&mailboxtab.txs[mbxid]);
 error1:
-    unix64_mailbox_unlock();
+    unix64_mailbox_unlock(&mailboxtab.txs[mbxid]);
     return (err);
 }
 
 /**
- * @see do_unix64_mailbox_close().
+ * @see do_unix64_mailbox_reserve().
  */
-PUBLIC int unix64_mailbox_close(int mbxid)
+PUBLIC int unix64_mailbox_reserve(int mbxid, void **buf)
 {
-    return (do_unix64_mailbox_close(mbxid));
+    return (do_unix64_mailbox_reserve(mbxid, buf));
 }
 
 /*============================================================================*
- * unix64_mailbox_awrite()                                                    *
+ * unix64_mailbox_commit()                                                    *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Sends the message reserved with unix64_mailbox_reserve().
  *
  * @note This function is thread-safe.
  */
-PRIVATE ssize_t do_unix64_mailbox_awrite(int mbxid, const void *buf, size_t n)
+PRIVATE int do_unix64_mailbox_commit(int mbxid)
 {
     int err;
-    ssize_t nwritten;
-    int ntries = 5;
+    struct unix64_deadline deadline;
 
-    unix64_mailbox_lock();
+    unix64_mailbox_lock(&mailboxtab.txs[mbxid]);
 
     /* Bad mailbox. */
     if (!resource_is_used(&mailboxtab.txs[mbxid].resource)) {
@@ -459,82 +1739,65 @@ PRIVATE ssize_t do_unix64_mailbox_awrite(int mbxid, const void *buf, size_t n)
         goto error1;
     }
 
-    /* Busy mailbox. */
-    if (resource_is_busy(&mailboxtab.txs[mbxid].resource)) {
-        err = -EBUSY;
+    /* No reserved message. */
+    if (mailboxtab.txs[mbxid].slot == NULL) {
+        err = -EINVAL;
         goto error1;
     }
 
-    /* Set mailbox as busy. */
-    resource_set_busy(&mailboxtab.txs[mbxid].resource);
+    mailboxtab.txs[mbxid].slot = NULL;
+
+    unix64_deadline_set(&deadline, mailboxtab.txs[mbxid].timeout);
 
     /*
      * Release lock, since we may sleep below.
      */
-    unix64_mailbox_unlock();
-
-    do {
-        struct timespec tm;
-
-        if (ntries-- == 0) {
-            err = -ETIMEDOUT;
-            goto error2;
-        }
-
-        clock_gettime(CLOCK_REALTIME, &tm);
-        tm.tv_sec += 1;
-
-        if ((nwritten = mq_timedsend(
-                 mailboxtab.txs[mbxid].fd, buf, n, 1, &tm)) == -1) {
-            if (errno == EAGAIN)
-                continue;
-
-            err = -EAGAIN;
-            goto error2;
-        }
+    unix64_mailbox_unlock(&mailboxtab.txs[mbxid]);
 
-        break;
+    err = unix64_mailbox_publish(&mailboxtab.txs[mbxid], &deadline);
 
-    } while (1);
+    /* Deadline expired. */
+    if (err == 0)
+        err = -ETIMEDOUT;
 
-    unix64_mailbox_lock();
-    resource_set_notbusy(&mailboxtab.txs[mbxid].resource);
-    unix64_mailbox_unlock();
+    unix64_mailbox_lock(&mailboxtab.txs[mbxid]);
+    unix64_mailbox_set_notbusy(&mailboxtab.txs[mbxid]);
+    unix64_mailbox_unlock(&mailboxtab.txs[mbxid]);
 
-    return (n);
+    return ((err < 0) ? err : 0);
 
-error2:
-    unix64_mailbox_lock();
-    resource_set_notbusy(&mailboxtab.txs[mbxid].resource);
 error1:
-    unix64_mailbox_unlock();
+    unix64_mailbox_unlock(&mailboxtab.txs[mbxid]);
     return (err);
 }
 
 /**
- * @see do_unix64_mailbox_awrite().
+ * @see do_unix64_mailbox_commit().
  */
-PUBLIC ssize_t unix64_mailbox_awrite(int mbxid, const void *buf, size_t n)
+PUBLIC int unix64_mailbox_commit(int mbxid)
 {
-    return (do_unix64_mailbox_awrite(mbxid, buf, n));
+    return (do_unix64_mailbox_commit(mbxid));
 }
 
 /*============================================================================*
- * unix64_mailbox_aread()                                                     *
+ * unix64_mailbox_peek()                                                      *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Gets the oldest message of a mailbox in place.
+ *
+ * The mailbox is kept busy until the message is handed to
+ * unix64_mailbox_release().
  *
  * @note This function is thread-safe.
  */
-PRIVATE ssize_t do_unix64_mailbox_aread(int mbxid, void *buf, size_t n)
+PRIVATE ssize_t do_unix64_mailbox_peek(int mbxid, void **buf)
 {
     int err;
     ssize_t nread;
-    int ntries = 5;
+    struct unix64_deadline deadline;
 
-    unix64_mailbox_lock();
+    unix64_mailbox_lock(&mailboxtab.rxs[mbxid]);
 
     /* Bad mailbox. */
     if (!resource_is_used(&mailboxtab.rxs[mbxid].resource)) {
@@ -548,58 +1811,220 @@ PRIVATE ssize_t do_unix64_mailbox_aread(int mbxid, void *buf, size_t n)
         goto error1;
     }
 
+    /* Error deferred by a partial batch. */
+    if ((err = unix64_mailbox_error_take(&mailboxtab.rxs[mbxid])) < 0)
+        goto error1;
+
     /* Set mailbox as busy. */
     resource_set_busy(&mailboxtab.rxs[mbxid].resource);
 
+    unix64_deadline_set(&deadline, mailboxtab.rxs[mbxid].timeout);
+
     /*
      * Release lock, since we may sleep below.
      */
-    unix64_mailbox_unlock();
+    unix64_mailbox_unlock(&mailboxtab.rxs[mbxid]);
 
-    do {
-        struct timespec tm;
+    nread = unix64_mailbox_front(&mailboxtab.rxs[mbxid], buf, &deadline);
 
-        if (ntries-- == 0) {
-            err = -ETIMEDOUT;
-            goto error2;
-        }
+    /* Deadline expired. */
+    if (nread == 0)
+        nread = -ETIMEDOUT;
 
-        clock_gettime(CLOCK_REALTIME, &tm);
-        tm.tv_sec += 1;
+    if (nread < 0) {
+        err = nread;
+        goto error2;
+    }
 
-        if ((nread = mq_timedreceive(
-                 mailboxtab.rxs[mbxid].fd, buf, n, NULL, &tm)) == -1) {
-            if (errno == EAGAIN)
-                continue;
+    unix64_mailbox_lock(&mailboxtab.rxs[mbxid]);
+    mailboxtab.rxs[mbxid].slot = *buf;
+    unix64_mailbox_unlock(&mailboxtab.rxs[mbxid]);
 
-            err = -EAGAIN;
-            goto error2;
-        }
+    return (nread);
 
-        break;
+error2:
+    unix64_mailbox_lock(&mailboxtab.rxs[mbxid]);
+    unix64_mailbox_set_notbusy(&mailboxtab.rxs[mbxid]);
+error1:
+    unix64_mailbox_unlock(&mailboxtab.rxs[mbxid]);
+    return (err);
+}
 
-    } while (1);
+/**
+ * @see do_unix64_mailbox_peek().
+ */
+PUBLIC ssize_t unix64_mailbox_peek(int mbxid, void **buf)
+{
+    return (do_unix64_mailbox_peek(mbxid, buf));
+}
 
-    unix64_mailbox_lock();
-    resource_set_notbusy(&mailboxtab.rxs[mbxid].resource);
-    unix64_mailbox_unlock();
+/*============================================================================*
+ * unix64_mailbox_release()                                                   *
+ *============================================================================*/
 
-    return (nread);
+/**
+ * @brief Consumes the message got with unix64_mailbox_peek().
+ *
+ * @note This function is thread-safe.
+ */
+PRIVATE int do_unix64_mailbox_release(int mbxid)
+{
+    int err;
+
+    unix64_mailbox_lock(&mailboxtab.rxs[mbxid]);
+
+    /* Bad mailbox. */
+    if (!resource_is_used(&mailboxtab.rxs[mbxid].resource)) {
+        err = -EBADF;
+        goto error1;
+    }
+
+    /* No peeked message. */
+    if (mailboxtab.rxs[mbxid].slot == NULL) {
+        err = -EINVAL;
+        goto error1;
+    }
+
+    mailboxtab.rxs[mbxid].slot = NULL;
+
+    unix64_mailbox_retire(&mailboxtab.rxs[mbxid]);
+
+    unix64_mailbox_set_notbusy(&mailboxtab.rxs[mbxid]);
+    unix64_mailbox_unlock(&mailboxtab.rxs[mbxid]);
+
+    return (0);
 
-error2:
-    unix64_mailbox_lock();
-    resource_set_notbusy(&mailboxtab.rxs[mbxid].resource);
 error1:
-    unix64_mailbox_unlock();
+    unix64_mailbox_unlock(&mailboxtab.rxs[mbxid]);
     return (err);
 }
 
 /**
- * @see do_unix64_mailbox_aread().
+ * @see do_unix64_mailbox_release().
  */
-PUBLIC ssize_t unix64_mailbox_aread(int mbxid, void *buf, size_t n)
+PUBLIC int unix64_mailbox_release(int mbxid)
 {
-    return (do_unix64_mailbox_aread(mbxid, buf, n));
+    return (do_unix64_mailbox_release(mbxid));
+}
+
+/*============================================================================*
+ * unix64_mailbox_poll()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether or not the NoC connector of an input mailbox
+ * has a message to read.
+ *
+ * @param mbx Target mailbox.
+ *
+ * @returns Non-zero if the mailbox may be read and zero otherwise.
+ */
+PRIVATE int unix64_mailbox_is_readable(struct mailbox *mbx)
+{
+    /* Message left over by a previous receive. */
+    if (mbx->pending > 0)
+        return (1);
+
+    return (unix64_transport_get()->is_readable(&mbx->conn));
+}
+
+/**
+ * @brief Asserts whether or not the NoC connector of an output mailbox
+ * has room for a message.
+ *
+ * @param mbx Target mailbox.
+ *
+ * @returns Non-zero if the mailbox may be written and zero otherwise.
+ */
+PRIVATE int unix64_mailbox_is_writable(struct mailbox *mbx)
+{
+    /* No send credits left. */
+    if (unix64_mailbox_credits_available(mbx->nodenum, mbx->priority) == 0)
+        return (0);
+
+    return (unix64_transport_get()->is_writable(&mbx->conn, mbx->priority));
+}
+
+/**
+ * @brief Counts the messages that an output mailbox may send without
+ * blocking.
+ *
+ * @param mbx Target mailbox.
+ *
+ * @returns The number of messages that @p mbx may send right away.
+ */
+PRIVATE int unix64_mailbox_room(struct mailbox *mbx)
+{
+    int room;
+    int ncredits;
+
+    ncredits = unix64_mailbox_credits_available(mbx->nodenum, mbx->priority);
+
+    /* Priority classes may share the NoC connector. */
+    if ((room = unix64_transport_get()->room(&mbx->conn)) < ncredits)
+        ncredits = room;
+
+    return (ncredits);
+}
+
+/**
+ * The unix64_mailbox_poll() function checks the input mailbox @p
+ * mbxid for a message to read, if @p events has UNIX64_IKC_POLLIN set,
+ * and the output mailbox @p mbxid for room to write, if @p events has
+ * UNIX64_IKC_POLLOUT set. A busy input mailbox is not reported as
+ * readable, since its owner is about to drain it.
+ *
+ * @note This function is thread-safe.
+ */
+PUBLIC int unix64_mailbox_poll(int mbxid, unsigned events)
+{
+    int revents = 0;
+    struct mailbox *mbx;
+
+    if (events & UNIX64_IKC_POLLIN) {
+        /* Bad mailbox. */
+        if (mbxid >= UNIX64_MAILBOX_CREATE_MAX)
+            return (-EBADF);
+
+        mbx = &mailboxtab.rxs[mbxid];
+
+        unix64_mailbox_lock(mbx);
+
+        /* Bad mailbox. */
+        if (!resource_is_used(&mbx->resource)) {
+            unix64_mailbox_unlock(mbx);
+            return (-EBADF);
+        }
+
+        if (!resource_is_busy(&mbx->resource) &&
+            unix64_mailbox_is_readable(mbx))
+            revents |= UNIX64_IKC_POLLIN;
+
+        unix64_mailbox_unlock(mbx);
+    }
+
+    if (events & UNIX64_IKC_POLLOUT) {
+        /* Bad mailbox. */
+        if (mbxid >= UNIX64_MAILBOX_OPEN_MAX)
+            return (-EBADF);
+
+        mbx = &mailboxtab.txs[mbxid];
+
+        unix64_mailbox_lock(mbx);
+
+        /* Bad mailbox. */
+        if (!resource_is_used(&mbx->resource)) {
+            unix64_mailbox_unlock(mbx);
+            return (-EBADF);
+        }
+
+        if (unix64_mailbox_is_writable(mbx))
+            revents |= UNIX64_IKC_POLLOUT;
+
+        unix64_mailbox_unlock(mbx);
+    }
+
+    return (revents);
 }
 
 /*============================================================================*
@@ -619,11 +2044,12 @@ PUBLIC ssize_t unix64_mailbox_aread(int mbxid, void *buf, size_t n)
 PUBLIC int unix64_mailbox_ioctl(int mbxid, unsigned request, va_list args)
 {
     int ret = (-EINVAL); /* Return value. */
+    struct mailbox *rx;  /* Input mailbox.  */
+    struct mailbox *tx;  /* Output mailbox. */
 
-    UNUSED(mbxid);
-    UNUSED(args);
-
-    unix64_mailbox_lock();
+    /* Input and output mailboxes share the same IDs. */
+    rx = (mbxid < UNIX64_MAILBOX_CREATE_MAX) ? &mailboxtab.rxs[mbxid] : NULL;
+    tx = (mbxid < UNIX64_MAILBOX_OPEN_MAX) ? &mailboxtab.txs[mbxid] : NULL;
 
     switch (request) {
     case UNIX64_MAILBOX_IOCTL_SET_ASYNC_BEHAVIOR: {
@@ -634,15 +2060,98 @@ PUBLIC int unix64_mailbox_ioctl(int mbxid, unsigned request, va_list args)
         ret = (0);
     } break;
 
+    case UNIX64_MAILBOX_IOCTL_SET_TIMEOUT: {
+        int timeout = va_arg(args, int);
+
+        /* Bad timeout. */
+        if (timeout < UNIX64_MAILBOX_TIMEOUT_INFINITE)
+            break;
+
+        ret = (-EBADF);
+
+        if (rx != NULL) {
+            unix64_mailbox_lock(rx);
+            if (resource_is_used(&rx->resource)) {
+                rx->timeout = timeout;
+                ret = (0);
+            }
+            unix64_mailbox_unlock(rx);
+        }
+
+        if (tx != NULL) {
+            unix64_mailbox_lock(tx);
+            if (resource_is_used(&tx->resource)) {
+                tx->timeout = timeout;
+                ret = (0);
+            }
+            unix64_mailbox_unlock(tx);
+        }
+    } break;
+
+    case UNIX64_MAILBOX_IOCTL_SET_PRIORITY: {
+        int priority = va_arg(args, int);
+
+        /* Bad priority class. */
+        if (!WITHIN(priority, 0, UNIX64_MAILBOX_PRIORITY_NUM))
+            break;
+
+        ret = (-EBADF);
+
+        /* Only output mailboxes send messages. */
+        if (tx != NULL) {
+            unix64_mailbox_lock(tx);
+            if (resource_is_used(&tx->resource)) {
+                tx->priority = priority;
+                ret = (0);
+            }
+            unix64_mailbox_unlock(tx);
+        }
+    } break;
+
+    case UNIX64_MAILBOX_IOCTL_SET_CREDITS: {
+        int ncredits = va_arg(args, int);
+
+        /* Bad number of credits. */
+        if (!WITHIN(ncredits, 1, UNIX64_MAILBOX_DEPTH + 1))
+            break;
+
+        ret = (-EBADF);
+
+        /* Only input mailboxes grant credits. */
+        if (rx != NULL) {
+            unix64_mailbox_lock(rx);
+            if (resource_is_used(&rx->resource)) {
+                unix64_mailbox_credits_grant(rx->nodenum, ncredits);
+                ret = (0);
+            }
+            unix64_mailbox_unlock(rx);
+        }
+    } break;
+
+    case UNIX64_MAILBOX_IOCTL_GET_CREDITS: {
+        int *ncredits = va_arg(args, int *);
+
+        /* Bad place to store credits. */
+        if (ncredits == NULL)
+            break;
+
+        ret = (-EBADF);
+
+        /* Only output mailboxes spend credits. */
+        if (tx != NULL) {
+            unix64_mailbox_lock(tx);
+            if (resource_is_used(&tx->resource)) {
+                *ncredits = unix64_mailbox_room(tx);
+                ret = (0);
+            }
+            unix64_mailbox_unlock(tx);
+        }
+    } break;
+
     default:
         break;
     }
 
-    /*
-     * Release lock, since we may sleep below.
-     */
-    unix64_mailbox_unlock();
-
     return (ret);
 }
 
@@ -655,7 +2164,8 @@ PUBLIC int unix64_mailbox_ioctl(int mbxid, unsigned request, va_list args)
  */
 PUBLIC void unix64_mailbox_setup(void)
 {
-    noop();
+    KASSERT(sizeof(struct unix64_mailbox_credits) <=
+            LINUX64_PROCESSOR_NOC_ARENA_CREDIT_SIZE);
 }
 
 /*============================================================================*
@@ -667,5 +2177,16 @@ PUBLIC void unix64_mailbox_setup(void)
  */
 PUBLIC void unix64_mailbox_shutdown(void)
 {
-    noop();
+    /* Idle mailboxes. */
+    unix64_mailbox_cache_flush();
+
+    /* Unlink mailboxes. */
+    if (cluster_get_num() == PROCESSOR_CLUSTERNUM_MASTER) {
+        for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++) {
+            char pathname[UNIX64_MAILBOX_NAME_LENGTH];
+
+            sprintf(pathname, "/%s-%d", UNIX64_MAILBOX_BASENAME, i);
+            unix64_transport_get()->unlink(pathname);
+        }
+    }
 }
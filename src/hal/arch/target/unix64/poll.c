@@ -0,0 +1,206 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __NEED_HAL_PROCESSOR
+
+#include <arch/target/unix64/unix64/mailbox.h>
+#include <arch/target/unix64/unix64/poll.h>
+#include <arch/target/unix64/unix64/portal.h>
+#include <arch/target/unix64/unix64/sync.h>
+#include <nanvix/const.h>
+#include <nanvix/hal/processor.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+
+/*============================================================================*
+ * unix64_doorbell_get()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Gets the doorbell of a NoC node.
+ *
+ * @param nodenum Target NoC node.
+ *
+ * @returns The doorbell of @p nodenum.
+ */
+PRIVATE inline struct unix64_doorbell *unix64_doorbell_get(int nodenum)
+{
+    return (linux64_processor_noc_arena_bell(nodenum));
+}
+
+/*============================================================================*
+ * unix64_doorbell_ring()                                                     *
+ *============================================================================*/
+
+/**
+ * The unix64_doorbell_ring() function wakes up the threads of the NoC
+ * node @p nodenum that are polling. Pollers register themselves before
+ * they scan their endpoints and the caller publishes its progress
+ * before it checks for pollers, thus either the poller sees the
+ * progress or the caller sees the poller. When nobody polls, ringing
+ * costs a fence and a load.
+ */
+PUBLIC void unix64_doorbell_ring(int nodenum)
+{
+    struct unix64_doorbell *bell;
+
+    bell = unix64_doorbell_get(nodenum);
+
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    /* Nobody is polling. */
+    if (__atomic_load_n(&bell->npollers, __ATOMIC_RELAXED) == 0)
+        return;
+
+    unix64_event_notify(&bell->event);
+}
+
+/*============================================================================*
+ * unix64_ikc_poll_scan()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Checks the readiness of IKC endpoints.
+ *
+ * @param fds  Target endpoints.
+ * @param nfds Number of target endpoints.
+ *
+ * @returns Upon successful completion, the number of ready endpoints
+ * is returned. Upon failure, a negative error code is returned
+ * instead.
+ */
+PRIVATE int unix64_ikc_poll_scan(struct ikc_pollfd *fds, int nfds)
+{
+    int nready = 0;
+    int revents;
+
+    for (int i = 0; i < nfds; i++) {
+        switch (fds[i].type) {
+        case UNIX64_IKC_MAILBOX:
+            revents = unix64_mailbox_poll(fds[i].id, fds[i].events);
+            break;
+
+#if !__NANVIX_IKC_USES_ONLY_MAILBOX
+        case UNIX64_IKC_PORTAL:
+            revents = unix64_portal_poll(fds[i].id, fds[i].events);
+            break;
+
+        case UNIX64_IKC_SYNC:
+            revents = unix64_sync_poll(fds[i].id, fds[i].events);
+            break;
+#endif
+
+        default:
+            revents = -EINVAL;
+            break;
+        }
+
+        if (revents < 0)
+            return (revents);
+
+        if ((fds[i].revents = revents) != 0)
+            nready++;
+    }
+
+    return (nready);
+}
+
+/*============================================================================*
+ * unix64_ikc_poll_is_sliced()                                                *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether or not a poll should rescan periodically.
+ *
+ * @param fds  Target endpoints.
+ * @param nfds Number of target endpoints.
+ *
+ * @returns Non-zero if some endpoint may become ready without a
+ * doorbell ring, and zero otherwise.
+ */
+PRIVATE int unix64_ikc_poll_is_sliced(const struct ikc_pollfd *fds, int nfds)
+{
+    for (int i = 0; i < nfds; i++) {
+        if ((fds[i].type == UNIX64_IKC_MAILBOX) &&
+            (fds[i].events & UNIX64_IKC_POLLOUT))
+            return (1);
+    }
+
+    return (0);
+}
+
+/*============================================================================*
+ * unix64_ikc_poll()                                                          *
+ *============================================================================*/
+
+/**
+ * The unix64_ikc_poll() function scans the endpoints in @p fds and, if
+ * none of them is ready, sleeps on the doorbell of the local NoC node
+ * until some writer rings it or the timeout @p timeout expires. Then
+ * it scans again. Output mailboxes are rescanned every
+ * UNIX64_IKC_POLL_SLICE milliseconds, because their readers do not
+ * ring doorbells, thus the timeout may be overrun by one slice.
+ *
+ * @note This function is thread-safe.
+ */
+PUBLIC int unix64_ikc_poll(struct ikc_pollfd *fds, int nfds, int timeout)
+{
+    int ret;                         /* Return value.    */
+    int sliced;                      /* Rescan?          */
+    uint32_t counter;                /* Event counter.   */
+    struct unix64_doorbell *bell;    /* Local doorbell.  */
+    struct unix64_deadline deadline; /* Deadline.        */
+    struct unix64_deadline slice;    /* Rescan deadline. */
+
+    bell = unix64_doorbell_get(processor_node_get_num());
+    sliced = unix64_ikc_poll_is_sliced(fds, nfds);
+
+    unix64_deadline_set(&deadline, timeout);
+
+    __atomic_add_fetch(&bell->npollers, 1, __ATOMIC_SEQ_CST);
+
+    do {
+        /* Snapshot the event before scanning, to not miss a ring. */
+        counter = unix64_event_counter(&bell->event);
+
+        /* Some endpoint is ready or bad. */
+        if ((ret = unix64_ikc_poll_scan(fds, nfds)) != 0)
+            break;
+
+        if (unix64_deadline_expired(&deadline))
+            break;
+
+        if (sliced) {
+            unix64_deadline_set(&slice, UNIX64_IKC_POLL_SLICE);
+            unix64_event_wait(&bell->event, counter, &slice);
+        } else
+            unix64_event_wait(&bell->event, counter, &deadline);
+
+    } while (1);
+
+    __atomic_sub_fetch(&bell->npollers, 1, __ATOMIC_SEQ_CST);
+
+    return (ret);
+}
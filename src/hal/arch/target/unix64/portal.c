@@ -24,39 +24,72 @@
 #define __NEED_HAL_PROCESSOR
 #define __NEED_RESOURCE
 
+#include <arch/target/unix64/unix64/futex.h>
+#include <arch/target/unix64/unix64/poll.h>
 #include <arch/target/unix64/unix64/portal.h>
-#include <fcntl.h>
 #include <nanvix/const.h>
 #include <nanvix/hal/processor.h>
 #include <nanvix/hal/resource.h>
 #include <nanvix/hlib.h>
 #include <posix/errno.h>
 #include <pthread.h>
-#include <semaphore.h>
-#include <stdio.h>
-#include <sys/mman.h>
-#include <sys/stat.h>
-#include <unistd.h>
 
 #if !__NANVIX_IKC_USES_ONLY_MAILBOX
 
 /**
- * @brief Length of portal name.
+ * @brief Cache line size (in bytes).
  */
-#define UNIX64_PORTAL_NAME_LENGTH 128
+#define UNIX64_PORTAL_ALIGN 64
 
 /**
- * @brief Base name for a portal
+ * @name Links to multicast slots.
  */
-#define UNIX64_PORTAL_BASENAME "nanvix-portal"
+/**@{*/
+#define UNIX64_PORTAL_LINK_NONE (-1) /**< Data is inline. */
+#define UNIX64_PORTAL_LINK(nodenum, slot)                                      \
+    ((int64_t)(nodenum)*UNIX64_PORTAL_SLOTS_NUM + (slot)) /**< Link.      */
+#define UNIX64_PORTAL_LINK_NODE(link)                                          \
+    ((int)((link) / UNIX64_PORTAL_SLOTS_NUM)) /**< Writer of a link.      */
+#define UNIX64_PORTAL_LINK_SLOT(link)                                          \
+    ((int)((link) % UNIX64_PORTAL_SLOTS_NUM)) /**< Slot of a link.        */
+/**@}*/
 
 /**
  * @brief Portal buffer.
+ *
+ * The buffer is a single-producer single-consumer ring of
+ * UNIX64_PORTAL_SLOTS_NUM slots. Only the writer advances @p head and
+ * only the reader advances @p tail. Each side sleeps on an event of
+ * the buffer until its peer makes progress. A slot either holds its
+ * data inline or links to a slot of a multicast buffer.
  */
 struct portal_buffer {
-    volatile int busy;                 /**< Busy?  */
-    volatile int ready;                /**< Ready? */
-    char data[UNIX64_PORTAL_MAX_SIZE]; /**< Data   */
+    uint64_t head ALIGN(UNIX64_PORTAL_ALIGN); /**< Next slot to write. */
+    uint64_t tail ALIGN(UNIX64_PORTAL_ALIGN); /**< Next slot to read.  */
+    struct unix64_event readable;             /**< Slot filled.        */
+    struct unix64_event writable;             /**< Slot drained.       */
+    uint64_t size[UNIX64_PORTAL_SLOTS_NUM] ALIGN(
+        UNIX64_PORTAL_ALIGN); /**< Size of slots. */
+    int64_t link[UNIX64_PORTAL_SLOTS_NUM]; /**< Linked multicast slots. */
+    char data[UNIX64_PORTAL_SLOTS_NUM][UNIX64_PORTAL_MAX_SIZE] ALIGN(
+        UNIX64_PORTAL_ALIGN); /**< Slots. */
+};
+
+/**
+ * @brief Multicast portal buffer.
+ *
+ * The buffer is a ring of UNIX64_PORTAL_SLOTS_NUM slots that is filled
+ * by a single writer and linked into the portal buffers of many
+ * readers. Each slot counts the readers that did not drain it yet,
+ * and the writer only reuses a slot once that count drops to zero.
+ */
+struct portal_mbuffer {
+    uint64_t head ALIGN(UNIX64_PORTAL_ALIGN); /**< Next slot to write. */
+    struct unix64_event released;             /**< Slot released.      */
+    uint32_t refcount[UNIX64_PORTAL_SLOTS_NUM] ALIGN(
+        UNIX64_PORTAL_ALIGN); /**< Pending readers of slots. */
+    char data[UNIX64_PORTAL_SLOTS_NUM][UNIX64_PORTAL_MAX_SIZE] ALIGN(
+        UNIX64_PORTAL_ALIGN); /**< Slots. */
 };
 
 /**
@@ -68,16 +101,17 @@ struct portal {
      */
     struct resource resource; /**< Generic resource information.  */
 
+    pthread_mutex_t mutex;    /**< Endpoint lock.                  */
+    struct unix64_event idle; /**< Endpoint no longer busy.        */
     int remote;  /**< Remote NoC node ID.            */
     int local;   /**< Local NoC node ID.             */
-    sem_t *lock; /**< Portal lock.                   */
-    char portalname[UNIX64_PORTAL_NAME_LENGTH]; /**< Name of shared memory
-                                                   region.  */
-    char lockname[UNIX64_PORTAL_NAME_LENGTH]; /**< Name of shared memory region.
-                                               */
+    pthread_mutex_t lock; /**< Portal lock.          */
     struct portal_buffer
         *buffers[PROCESSOR_NOC_NODES_NUM]; /**< Portal buffers. */
-    int fd[PROCESSOR_NOC_NODES_NUM]; /**< Underlying file descriptors.   */
+    struct portal_mbuffer *mbuffer;        /**< Multicast buffer. */
+    void *slot;  /**< Peeked slot.                   */
+    int timeout; /**< Timeout (in milliseconds).     */
+    size_t offset; /**< Progress of a failed large read. */
 };
 
 /**
@@ -97,16 +131,41 @@ PRIVATE struct {
     .rxs[0 ... UNIX64_PORTAL_CREATE_MAX - 1] =
         {
             .resource = {0},
+            .mutex = PTHREAD_MUTEX_INITIALIZER,
         },
 
     .txs[0 ... UNIX64_PORTAL_OPEN_MAX - 1] =
         {
             .resource = {0},
+            .mutex = PTHREAD_MUTEX_INITIALIZER,
         },
 };
 
 /**
- * @brief Sync module lock.
+ * @brief Portals indexed by NoC node.
+ *
+ * A multicast portal is also indexed as an output portal to each of
+ * its remote NoC nodes.
+ */
+PRIVATE struct {
+    int rxs[PROCESSOR_NOC_NODES_NUM]; /**< Input portal of a local node. */
+    int txs[PROCESSOR_NOC_NODES_NUM]
+           [PROCESSOR_NOC_NODES_NUM];  /**< Output portal of a pair.     */
+    int mtxs[PROCESSOR_NOC_NODES_NUM]; /**< Multicast portal of a node.  */
+} portalnodes = {
+    .rxs[0 ... PROCESSOR_NOC_NODES_NUM - 1] = -1,
+    .txs[0 ... PROCESSOR_NOC_NODES_NUM - 1][0 ... PROCESSOR_NOC_NODES_NUM - 1] =
+        -1,
+    .mtxs[0 ... PROCESSOR_NOC_NODES_NUM - 1] = -1,
+};
+
+/**
+ * @brief Portal table lock.
+ *
+ * It guards the allocation of portals and the table of portals indexed
+ * by NoC node. Everything else in a portal is guarded by the endpoint
+ * lock of the portal itself, which is taken after the table lock
+ * whenever both are needed.
  */
 PRIVATE pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
 
@@ -126,7 +185,7 @@ PRIVATE struct {
  *============================================================================*/
 
 /**
- * @brief Locks Unix portal module.
+ * @brief Locks the table of portals.
  */
 PRIVATE void unix64_portals_lock(void)
 {
@@ -138,7 +197,7 @@ PRIVATE void unix64_portals_lock(void)
  *============================================================================*/
 
 /**
- * @brief Unlocks Unix portal module.
+ * @brief Unlocks the table of portals.
  */
 PRIVATE void unix64_portals_unlock(void)
 {
@@ -146,80 +205,78 @@ PRIVATE void unix64_portals_unlock(void)
 }
 
 /*============================================================================*
- * unix64_portal_buffer_open()                                                *
+ * unix64_portal_mutex_lock()                                                 *
  *============================================================================*/
 
 /**
- * @brief Opens a portal buffer.
+ * @brief Takes the endpoint lock of a portal.
  *
  * @param portal Target portal.
- * @param local  Target local NoC node.
- * @param remote Target remote NoC node.
  */
-PRIVATE int unix64_portal_buffer_open(struct portal *portal, int local,
-                                      int remote)
+PRIVATE void unix64_portal_mutex_lock(struct portal *portal)
 {
-    int shm;
-    struct stat st;
-    int initialize = 0;
-
-    /* Build portal name. */
-    sprintf(
-        portal->portalname, "%s-%d-%d", UNIX64_PORTAL_BASENAME, local, remote);
-
-    /* Create portal buffers. */
-    KASSERT((shm = shm_open(portal->portalname,
-                            O_RDWR | O_CREAT,
-                            S_IRUSR | S_IWUSR)) != -1);
+    pthread_mutex_lock(&portal->mutex);
+}
 
-    /* Allocate portal buffer. */
-    KASSERT(fstat(shm, &st) != -1);
-    if (st.st_size == 0) {
-        initialize = 1;
-        KASSERT(ftruncate(shm, sizeof(struct portal_buffer)) != -1);
-    }
+/*============================================================================*
+ * unix64_portal_mutex_unlock()                                               *
+ *============================================================================*/
 
-    /* Attach portal buffer. */
-    KASSERT((portal->buffers[remote] =
-                 mmap(NULL,
-                      PROCESSOR_NOC_NODES_NUM * sizeof(struct portal_buffer),
-                      PROT_READ | PROT_WRITE,
-                      MAP_SHARED,
-                      shm,
-                      0)) != NULL);
+/**
+ * @brief Releases the endpoint lock of a portal.
+ *
+ * @param portal Target portal.
+ */
+PRIVATE void unix64_portal_mutex_unlock(struct portal *portal)
+{
+    pthread_mutex_unlock(&portal->mutex);
+}
 
-    if (initialize) {
-        portal->buffers[remote]->busy = 0;
-        portal->buffers[remote]->ready = 0;
-    }
+/*============================================================================*
+ * unix64_portal_set_notbusy()                                                *
+ *============================================================================*/
 
-    return (shm);
+/**
+ * @brief Clears the busy flag of a portal.
+ *
+ * @param portal Target portal.
+ *
+ * Threads that wait for the portal to become idle are woken up.
+ */
+PRIVATE void unix64_portal_set_notbusy(struct portal *portal)
+{
+    resource_set_notbusy(&portal->resource);
+    unix64_event_notify(&portal->idle);
 }
 
+/*============================================================================*
+ * unix64_portal_buffer_open()                                                *
+ *============================================================================*/
+
 /**
- * @see unix64_portal_buffer_open()
+ * @brief Opens the buffer of an input portal.
+ *
+ * @param portal Target portal.
+ * @param local  Target local NoC node.
+ * @param remote Target remote NoC node.
  */
 PRIVATE void unix64_portal_buffer_rx_open(struct portal *portal, int local,
                                           int remote)
 {
-    int fd;
-
-    fd = unix64_portal_buffer_open(portal, local, remote);
-
-    portal->fd[remote] = fd;
+    portal->buffers[remote] = linux64_processor_noc_arena_slot(local, remote);
 }
 
 /**
- * @see unix64_portal_buffer_open()
+ * @brief Opens the buffer of an output portal.
+ *
+ * @param portal Target portal.
+ * @param local  Target local NoC node.
+ * @param remote Target remote NoC node.
  */
 PRIVATE void unix64_portal_buffer_tx_open(struct portal *portal, int local,
                                           int remote)
 {
-    int fd;
-
-    fd = unix64_portal_buffer_open(portal, remote, local);
-
-    portal->fd[remote] = fd;
+    portal->buffers[remote] = linux64_processor_noc_arena_slot(remote, local);
 }
 
 /*============================================================================*
@@ -234,12 +291,23 @@ PRIVATE void unix64_portal_buffer_tx_open(struct portal *portal, int local,
  */
 PRIVATE void unix64_portal_buffer_close(struct portal *portal, int bufferid)
 {
-    /* Detach portal buffer. */
-    KASSERT(munmap(portal->buffers[bufferid], sizeof(struct portal_buffer)) !=
-            -1);
+    portal->buffers[bufferid] = NULL;
+}
+
+/*============================================================================*
+ * unix64_portal_mbuffer_get()                                                *
+ *============================================================================*/
 
-    /* Destroy portal buffers. */
-    shm_unlink(portal->portalname);
+/**
+ * @brief Gets the multicast buffer of a NoC node.
+ *
+ * @param nodenum Target NoC node.
+ *
+ * @returns The multicast buffer that is written by @p nodenum.
+ */
+PRIVATE inline struct portal_mbuffer *unix64_portal_mbuffer_get(int nodenum)
+{
+    return (linux64_processor_noc_arena_mslot(nodenum));
 }
 
 /*============================================================================*
@@ -250,16 +318,15 @@ PRIVATE void unix64_portal_buffer_close(struct portal *portal, int bufferid)
  * @brief Initializes the lock of a portal.
  *
  * @param portal Target portal.
+ *
+ * @note The lock only guards the local NoC node, which lives in the
+ * calling process, thus no POSIX IPC object backs it.
  */
 PRIVATE void unix64_portal_lock_open(struct portal *portal, int local)
 {
-    /* Build portal name. */
-    sprintf(portal->lockname, "%s-%d", UNIX64_PORTAL_BASENAME, local);
+    UNUSED(local);
 
-    /* Create and initialize portal buffer lock. */
-    KASSERT((portal->lock = sem_open(
-                 portal->lockname, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR, 1)) !=
-            NULL);
+    KASSERT(pthread_mutex_init(&portal->lock, NULL) == 0);
 }
 
 /**
@@ -270,14 +337,6 @@ PRIVATE void unix64_portal_lock_rx_open(struct portal *portal, int local)
     unix64_portal_lock_open(portal, local);
 }
 
-/**
- * @see unix64_portal_lock_open()
- */
-PRIVATE void unix64_portal_lock_tx_open(struct portal *portal, int remote)
-{
-    unix64_portal_lock_open(portal, remote);
-}
-
 /*============================================================================*
  * unix64_portal_lock_close()                                                 *
  *============================================================================*/
@@ -289,8 +348,7 @@ PRIVATE void unix64_portal_lock_tx_open(struct portal *portal, int remote)
  */
 PRIVATE void unix64_portal_lock_close(struct portal *portal)
 {
-    KASSERT(sem_close(portal->lock) != -1);
-    sem_unlink(portal->lockname);
+    KASSERT(pthread_mutex_destroy(&portal->lock) == 0);
 }
 
 /*============================================================================*
@@ -304,7 +362,7 @@ PRIVATE void unix64_portal_lock_close(struct portal *portal)
  */
 PRIVATE inline void unix64_portal_lock(struct portal *portal)
 {
-    KASSERT(sem_wait(portal->lock) != -1);
+    KASSERT(pthread_mutex_lock(&portal->lock) == 0);
 }
 
 /*============================================================================*
@@ -318,7 +376,7 @@ PRIVATE inline void unix64_portal_lock(struct portal *portal)
  */
 PRIVATE inline void unix64_portal_unlock(struct portal *portal)
 {
-    KASSERT(sem_post(portal->lock) != -1);
+    KASSERT(pthread_mutex_unlock(&portal->lock) == 0);
 }
 
 /*============================================================================*
@@ -332,20 +390,12 @@ PRIVATE inline void unix64_portal_unlock(struct portal *portal)
  *
  * @returns One if an input portal exists for the target local NoC
  * node and zero otherwise.
+ *
+ * @note The caller must hold the portal table lock.
  */
 PRIVATE int unix64_portal_rx_exists(int local)
 {
-    for (int i = 0; i < UNIX64_PORTAL_CREATE_MAX; i++) {
-        /* Skip invalid portals. */
-        if (!resource_is_used(&portaltab.rxs[i].resource))
-            continue;
-
-        /* Exists. */
-        if (portaltab.rxs[i].local == local)
-            return (1);
-    }
-
-    return (0);
+    return (portalnodes.rxs[local] >= 0);
 }
 
 /**
@@ -378,10 +428,17 @@ PRIVATE int do_unix64_portal_create(int local)
     unix64_portal_lock_rx_open(&portaltab.rxs[portalid], local);
 
     /* Initialize portal. */
+    unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
     portaltab.rxs[portalid].local = local;
     portaltab.rxs[portalid].remote = -1;
+    portaltab.rxs[portalid].slot = NULL;
+    portaltab.rxs[portalid].timeout = UNIX64_PORTAL_TIMEOUT;
+    portaltab.rxs[portalid].offset = 0;
     resource_set_rdonly(&portaltab.rxs[portalid].resource);
-    resource_set_notbusy(&portaltab.rxs[portalid].resource);
+    unix64_portal_set_notbusy(&portaltab.rxs[portalid]);
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+
+    portalnodes.rxs[local] = portalid;
 
     unix64_portals_unlock();
 
@@ -404,6 +461,12 @@ PUBLIC int unix64_portal_create(int local)
  * unix64_portal_allow()                                                      *
  *============================================================================*/
 
+/**
+ * @brief Spin wait counters of unix64_portal_allow().
+ */
+PRIVATE struct spinwait_stats portal_allow_stats =
+    SPINWAIT_STATS_INITIALIZER("unix64_portal_allow");
+
 /**
  * @todo TODO: provide a detailed description for this function.
  *
@@ -413,35 +476,42 @@ PUBLIC int unix64_portal_create(int local)
  */
 PRIVATE int do_unix64_portal_allow(int portalid, int remote)
 {
+    uint32_t counter;
+    struct spinwait waiter;
+
+    spinwait_init(&waiter, &portal_allow_stats);
+
 again:
 
-    unix64_portals_lock();
+    unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
 
     /* Bad portal. */
     if (!resource_is_used(&portaltab.rxs[portalid].resource)) {
-        unix64_portals_unlock();
+        unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
         return (-EBADF);
     }
 
     /* Busy portal. */
     if (resource_is_busy(&portaltab.rxs[portalid].resource)) {
-        unix64_portals_unlock();
+        counter = unix64_event_counter(&portaltab.rxs[portalid].idle);
+        unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+        unix64_event_spinwait(&portaltab.rxs[portalid].idle, counter, &waiter);
         goto again;
     }
 
     /* Read operation is ongoing. */
     if (portaltab.rxs[portalid].remote != -1) {
-        unix64_portals_unlock();
+        unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
         return (-EBUSY);
     }
 
     /*
      * Set portal as busy, because we
-     * release the global lock below.
+     * release the endpoint lock below.
      */
     resource_set_busy(&portaltab.rxs[portalid].resource);
 
-    unix64_portals_unlock();
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
 
     unix64_portal_lock(&portaltab.rxs[portalid]);
 
@@ -450,25 +520,13 @@ again:
             &portaltab.rxs[portalid], portaltab.rxs[portalid].local, remote);
     }
 
-    /* Device is busy. */
-    if (portaltab.rxs[portalid].buffers[remote]->busy)
-        goto error0;
-
-    /* Device is ready. */
-    if (portaltab.rxs[portalid].buffers[remote]->ready)
-        goto error0;
-
     portaltab.rxs[portalid].remote = remote;
-    portaltab.rxs[portalid].buffers[remote]->ready = 1;
-    resource_set_notbusy(&portaltab.rxs[portalid].resource);
+    portaltab.rxs[portalid].offset = 0;
+    unix64_portal_set_notbusy(&portaltab.rxs[portalid]);
 
     unix64_portal_unlock(&portaltab.rxs[portalid]);
 
     return (0);
-
-error0:
-    unix64_portal_unlock(&portaltab.rxs[portalid]);
-    return (-EBUSY);
 }
 
 /**
@@ -491,24 +549,14 @@ PUBLIC int unix64_portal_allow(int portalid, int remote)
  *
  * @returns One if an output portal exists between the target local
  * and remote NoC nodes and zero otherwise.
+ *
+ * @note Multicast portals exist between the local NoC node and each
+ * of their remote NoC nodes.
+ * @note The caller must hold the portal table lock.
  */
 PRIVATE int unix64_portal_tx_exists(int local, int remote)
 {
-    for (int i = 0; i < UNIX64_PORTAL_OPEN_MAX; i++) {
-        /* Skip invalid portals. */
-        if (!resource_is_used(&portaltab.txs[i].resource))
-            continue;
-
-        /* Skip invalid remotes. */
-        if (portaltab.txs[i].remote != remote)
-            continue;
-
-        /* Exists. */
-        if (portaltab.txs[i].local == local)
-            return (1);
-    }
-
-    return (0);
+    return (portalnodes.txs[local][remote] >= 0);
 }
 
 /**
@@ -537,15 +585,22 @@ PRIVATE int do_unix64_portal_open(int local, int remote)
         goto error0;
     }
 
-    /* Open portal lock and buffer. */
-    unix64_portal_lock_tx_open(&portaltab.txs[portalid], remote);
+    unix64_portal_mutex_lock(&portaltab.txs[portalid]);
+
+    /* Open portal buffer. */
     unix64_portal_buffer_tx_open(&portaltab.txs[portalid], local, remote);
 
     /* Initialize portal. */
     portaltab.txs[portalid].local = local;
     portaltab.txs[portalid].remote = remote;
+    portaltab.txs[portalid].mbuffer = NULL;
+    portaltab.txs[portalid].timeout = UNIX64_PORTAL_TIMEOUT;
     resource_set_wronly(&portaltab.txs[portalid].resource);
-    resource_set_notbusy(&portaltab.txs[portalid].resource);
+    unix64_portal_set_notbusy(&portaltab.txs[portalid]);
+
+    unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
+
+    portalnodes.txs[local][remote] = portalid;
 
     unix64_portals_unlock();
 
@@ -565,221 +620,1208 @@ PUBLIC int unix64_portal_open(int local, int remote)
 }
 
 /*============================================================================*
- * unix64_portal_read()                                                       *
+ * unix64_portal_mopen()                                                      *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Asserts if a multicast output portal exists.
+ *
+ * @param local Target local NoC node.
+ *
+ * @returns One if a multicast output portal exists for the target
+ * local NoC node and zero otherwise.
+ *
+ * @note The caller must hold the portal table lock.
+ */
+PRIVATE int unix64_portal_mtx_exists(int local)
+{
+    return (portalnodes.mtxs[local] >= 0);
+}
+
+/**
+ * @brief Opens a multicast portal.
+ *
+ * The multicast buffer of the local NoC node is shared by all remote
+ * NoC nodes, thus there may be a single multicast portal per local
+ * NoC node.
  *
  * @note This function is blocking.
  * @note This function is thread-safe.
  * @note This function is reentrant.
  */
-PRIVATE ssize_t do_unix64_portal_read(int portalid, void *buf, size_t n)
+PRIVATE int do_unix64_portal_mopen(const int *nodes, int nnodes)
 {
-    int nread;
-    int remote;
-    int err;
+    int error;    /* Error.        */
+    int local;    /* Local node.   */
+    int portalid; /* ID of portal. */
 
-    err = -EBADF;
+    local = nodes[0];
 
     unix64_portals_lock();
 
-    /* Bad portal. */
-    if (!resource_is_used(&portaltab.rxs[portalid].resource))
+    /* Exists. */
+    if (unix64_portal_mtx_exists(local)) {
+        error = -EEXIST;
         goto error0;
+    }
 
-    /* Busy portal. */
-    if (resource_is_busy(&portaltab.rxs[portalid].resource)) {
-        err = -EBUSY;
-        goto error0;
+    /* Exists. */
+    for (int i = 1; i < nnodes; i++) {
+        if (unix64_portal_tx_exists(local, nodes[i])) {
+            error = -EEXIST;
+            goto error0;
+        }
     }
 
-    /* No read operation is ongoing. */
-    if (portaltab.rxs[portalid].remote == -1)
+    /* Allocate portal. */
+    if ((portalid = resource_alloc(&pool.tx)) < 0) {
+        error = -EAGAIN;
         goto error0;
+    }
 
-    /*
-     * Set portal as busy, because we
-     * release the global lock below.
-     */
-    resource_set_busy(&portaltab.rxs[portalid].resource);
-
-    unix64_portals_unlock();
-
-    unix64_portal_lock(&portaltab.rxs[portalid]);
-
-    remote = portaltab.rxs[portalid].remote;
+    unix64_portal_mutex_lock(&portaltab.txs[portalid]);
 
-    /* No data is available. */
-    if (!portaltab.rxs[portalid].buffers[remote]->busy) {
-        resource_set_notbusy(&portaltab.rxs[portalid].resource);
-        unix64_portal_unlock(&portaltab.rxs[portalid]);
-        return (-ENOMSG);
-    }
+    /* Open portal buffers. */
+    for (int i = 1; i < nnodes; i++)
+        unix64_portal_buffer_tx_open(&portaltab.txs[portalid], local, nodes[i]);
 
-    kmemcpy(buf, portaltab.rxs[portalid].buffers[remote]->data, nread = n);
+    /* Initialize portal. */
+    portaltab.txs[portalid].local = local;
+    portaltab.txs[portalid].remote = -1;
+    portaltab.txs[portalid].mbuffer = unix64_portal_mbuffer_get(local);
+    portaltab.txs[portalid].timeout = UNIX64_PORTAL_TIMEOUT;
+    resource_set_wronly(&portaltab.txs[portalid].resource);
+    unix64_portal_set_notbusy(&portaltab.txs[portalid]);
 
-    portaltab.rxs[portalid].remote = -1;
-    portaltab.rxs[portalid].buffers[remote]->busy = 0;
-    portaltab.rxs[portalid].buffers[remote]->ready = 0;
+    unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
 
-    resource_set_notbusy(&portaltab.rxs[portalid].resource);
+    for (int i = 1; i < nnodes; i++)
+        portalnodes.txs[local][nodes[i]] = portalid;
+    portalnodes.mtxs[local] = portalid;
 
-    unix64_portal_unlock(&portaltab.rxs[portalid]);
+    unix64_portals_unlock();
 
-    return (nread);
+    return (portalid);
 
 error0:
     unix64_portals_unlock();
-    return (err);
+    return (error);
 }
 
 /**
- * @see do_unix64_portal_read();
- *
- * @todo Check fixed size from microkernel.
+ * @see do_unix64_portal_mopen().
  */
-PUBLIC ssize_t unix64_portal_read(int portalid, void *buf, size_t n)
+PUBLIC int unix64_portal_mopen(const int *nodes, int nnodes)
 {
-    return (do_unix64_portal_read(portalid, buf, n));
+    return (do_unix64_portal_mopen(nodes, nnodes));
 }
 
 /*============================================================================*
- * unix64_portal_write()                                                      *
+ * unix64_portal_buffer_front()                                               *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Gets the oldest slot of a portal buffer.
  *
- * @note This function is blocking.
- * @note This function is thread-safe.
- * @note This function is reentrant.
+ * @param buffer Target portal buffer.
+ * @param size   Place where the size of the slot should be stored.
+ *
+ * @returns If data is available, a pointer to the oldest slot is
+ * returned. Otherwise, NULL is returned instead.
+ *
+ * @note The caller must be the only reader of the portal buffer.
  */
-PRIVATE ssize_t do_unix64_portal_write(int portalid, const void *buf, size_t n)
+PRIVATE void *unix64_portal_buffer_front(struct portal_buffer *buffer,
+                                         size_t *size)
 {
-    int nwrite;
-    int local;
-    int err;
+    int64_t link;
+    uint64_t tail;
+    struct portal_mbuffer *mbuffer;
 
-    unix64_portals_lock();
+    tail = __atomic_load_n(&buffer->tail, __ATOMIC_RELAXED);
 
-    /* Bad portal. */
-    if (!resource_is_used(&portaltab.txs[portalid].resource)) {
-        err = -EBADF;
-        goto error0;
-    }
+    /* No data is available. */
+    if (__atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE) == tail)
+        return (NULL);
 
-    /* Busy portal. */
-    if (resource_is_busy(&portaltab.txs[portalid].resource)) {
-        err = -EBUSY;
-        goto error0;
-    }
+    if (size != NULL)
+        *size = buffer->size[tail % UNIX64_PORTAL_SLOTS_NUM];
 
-    /*
-     * Set portal as busy, because we
-     * release the global lock below.
-     */
-    resource_set_busy(&portaltab.txs[portalid].resource);
+    /* Data is inline. */
+    if ((link = buffer->link[tail % UNIX64_PORTAL_SLOTS_NUM]) ==
+        UNIX64_PORTAL_LINK_NONE)
+        return (buffer->data[tail % UNIX64_PORTAL_SLOTS_NUM]);
 
-    unix64_portals_unlock();
+    mbuffer = unix64_portal_mbuffer_get(UNIX64_PORTAL_LINK_NODE(link));
 
-    unix64_portal_lock(&portaltab.txs[portalid]);
+    return (mbuffer->data[UNIX64_PORTAL_LINK_SLOT(link)]);
+}
 
-    local = portaltab.txs[portalid].local;
+/*============================================================================*
+ * unix64_portal_buffer_retire()                                              *
+ *============================================================================*/
 
-    /* Remote is not ready. */
-    if (!portaltab.txs[portalid].buffers[local]->ready) {
-        err = -EACCES;
-        goto error1;
+/**
+ * @brief Hands the oldest slot of a portal buffer back to the writer.
+ *
+ * If the slot links to a multicast slot, the latter is released too.
+ *
+ * @param buffer Target portal buffer.
+ *
+ * @note The caller must be the only reader of the portal buffer.
+ */
+PRIVATE void unix64_portal_buffer_retire(struct portal_buffer *buffer)
+{
+    int64_t link;
+    uint64_t tail;
+    struct portal_mbuffer *mbuffer;
+
+    tail = __atomic_load_n(&buffer->tail, __ATOMIC_RELAXED);
+
+    /* Release multicast slot. */
+    if ((link = buffer->link[tail % UNIX64_PORTAL_SLOTS_NUM]) !=
+        UNIX64_PORTAL_LINK_NONE) {
+        mbuffer = unix64_portal_mbuffer_get(UNIX64_PORTAL_LINK_NODE(link));
+
+        /* Last reader. */
+        if (__atomic_sub_fetch(&mbuffer->refcount[UNIX64_PORTAL_LINK_SLOT(link)],
+                               1,
+                               __ATOMIC_ACQ_REL) == 0)
+            unix64_event_notify(&mbuffer->released);
     }
 
-    /* On-going transter. */
-    if (portaltab.txs[portalid].buffers[local]->busy) {
-        err = -EBUSY;
-        goto error1;
-    }
+    __atomic_store_n(&buffer->tail, tail + 1, __ATOMIC_RELEASE);
 
-    kmemcpy(portaltab.txs[portalid].buffers[local]->data, buf, nwrite = n);
+    unix64_event_notify(&buffer->writable);
+}
 
-    portaltab.txs[portalid].buffers[local]->busy = 1;
+/*============================================================================*
+ * unix64_portal_buffer_pop()                                                 *
+ *============================================================================*/
 
-    resource_set_notbusy(&portaltab.txs[portalid].resource);
+/**
+ * @brief Drains the oldest slot of a portal buffer.
+ *
+ * @param buffer Target portal buffer.
+ * @param iov    Target segments.
+ * @param iovcnt Number of target segments.
+ *
+ * @returns Upon successful completion, the number of bytes scattered
+ * into @p iov is returned. If no data is available, -ENOMSG is
+ * returned instead.
+ *
+ * @note The caller must be the only reader of the portal buffer.
+ * @note No more than the size of the slot is scattered, and bytes of
+ * the slot that do not fit into @p iov are dropped.
+ */
+PRIVATE ssize_t unix64_portal_buffer_pop(struct portal_buffer *buffer,
+                                         const struct portal_iovec *iov,
+                                         int iovcnt)
+{
+    char *slot;
+    size_t len;
+    size_t size;
+    size_t n = 0;
 
-    unix64_portal_unlock(&portaltab.txs[portalid]);
+    /* No data is available. */
+    if ((slot = unix64_portal_buffer_front(buffer, &size)) == NULL)
+        return (-ENOMSG);
 
-    return (nwrite);
+    for (int i = 0; (i < iovcnt) && (n < size); i++) {
+        len = ((size - n) < iov[i].len) ? (size - n) : iov[i].len;
+        kmemcpy(iov[i].base, slot + n, len);
+        n += len;
+    }
 
-error1:
-    resource_set_notbusy(&portaltab.txs[portalid].resource);
-    unix64_portal_unlock(&portaltab.txs[portalid]);
-    return (err);
+    unix64_portal_buffer_retire(buffer);
 
-error0:
-    unix64_portals_unlock();
-    return (err);
+    return (n);
 }
 
+/*============================================================================*
+ * unix64_portal_buffer_push()                                                *
+ *============================================================================*/
+
 /**
- * @see unix64_do_portal_write().
+ * @brief Fills the next free slot of a portal buffer.
  *
- * @todo Check fixed size from microkernel.
+ * @param buffer Target portal buffer.
+ * @param iov    Source segments.
+ * @param iovcnt Number of source segments.
+ *
+ * @returns Upon successful completion, the number of bytes gathered
+ * from @p iov is returned. If all slots are in flight, -EBUSY is
+ * returned instead.
+ *
+ * @note The caller must be the only writer of the portal buffer.
  */
-PUBLIC ssize_t unix64_portal_write(int portalid, const void *buf, size_t n)
+PRIVATE ssize_t unix64_portal_buffer_push(struct portal_buffer *buffer,
+                                          const struct portal_iovec *iov,
+                                          int iovcnt)
 {
-    return (do_unix64_portal_write(portalid, buf, n));
+    char *slot;
+    uint64_t head;
+    size_t n = 0;
+
+    head = __atomic_load_n(&buffer->head, __ATOMIC_RELAXED);
+
+    /* All slots are in flight. */
+    if ((head - __atomic_load_n(&buffer->tail, __ATOMIC_ACQUIRE)) ==
+        UNIX64_PORTAL_SLOTS_NUM)
+        return (-EBUSY);
+
+    slot = buffer->data[head % UNIX64_PORTAL_SLOTS_NUM];
+
+    for (int i = 0; i < iovcnt; i++) {
+        kmemcpy(slot + n, iov[i].base, iov[i].len);
+        n += iov[i].len;
+    }
+
+    buffer->size[head % UNIX64_PORTAL_SLOTS_NUM] = n;
+    buffer->link[head % UNIX64_PORTAL_SLOTS_NUM] = UNIX64_PORTAL_LINK_NONE;
+
+    /* Publish the slot to the reader. */
+    __atomic_store_n(&buffer->head, head + 1, __ATOMIC_RELEASE);
+
+    unix64_event_notify(&buffer->readable);
+
+    return (n);
 }
 
 /*============================================================================*
- * unix64_portal_unlink()                                                     *
+ * unix64_portal_buffer_await()                                               *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Waits for the oldest slot of a portal buffer.
  *
- * @note This function is blocking.
- * @note This function is thread-safe.
- * @note This function is reentrant.
+ * @param buffer   Target portal buffer.
+ * @param size     Place where the size of the slot should be stored.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, a pointer to the oldest slot
+ * is returned. If the deadline expires, NULL is returned instead.
+ *
+ * @note The caller must be the only reader of the portal buffer.
  */
-PUBLIC int unix64_portal_unlink(int portalid)
+PRIVATE void *unix64_portal_buffer_await(struct portal_buffer *buffer,
+                                         size_t *size,
+                                         const struct unix64_deadline *deadline)
 {
-again:
+    void *slot;
+    uint32_t counter;
 
-    unix64_portals_lock();
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&buffer->readable);
 
-    /* Bad local NoC node. */
-    if (portaltab.rxs[portalid].local != processor_node_get_num()) {
-        unix64_portals_unlock();
-        return (-EPERM);
-    }
+        if ((slot = unix64_portal_buffer_front(buffer, size)) != NULL)
+            return (slot);
 
-    /* Bad portal. */
-    if (!resource_is_used(&portaltab.rxs[portalid].resource)) {
-        unix64_portals_unlock();
-        return (-EBADF);
-    }
+    } while (unix64_event_wait(&buffer->readable, counter, deadline) == 0);
 
-    /* Busy portal. */
+    return (NULL);
+}
+
+/*============================================================================*
+ * unix64_portal_buffer_recv()                                                *
+ *============================================================================*/
+
+/**
+ * @brief Drains the oldest slot of a portal buffer, waiting for it.
+ *
+ * @param buffer   Target portal buffer.
+ * @param iov      Target segments.
+ * @param iovcnt   Number of target segments.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, the number of bytes scattered
+ * into @p iov is returned. If the deadline expires, -ETIMEDOUT is
+ * returned instead.
+ *
+ * @note The caller must be the only reader of the portal buffer.
+ */
+PRIVATE ssize_t unix64_portal_buffer_recv(
+    struct portal_buffer *buffer, const struct portal_iovec *iov, int iovcnt,
+    const struct unix64_deadline *deadline)
+{
+    ssize_t ret;
+    uint32_t counter;
+
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&buffer->readable);
+
+        if ((ret = unix64_portal_buffer_pop(buffer, iov, iovcnt)) != -ENOMSG)
+            return (ret);
+
+    } while (unix64_event_wait(&buffer->readable, counter, deadline) == 0);
+
+    return (-ETIMEDOUT);
+}
+
+/*============================================================================*
+ * unix64_portal_buffer_send()                                                *
+ *============================================================================*/
+
+/**
+ * @brief Fills the next free slot of a portal buffer, waiting for it.
+ *
+ * @param buffer   Target portal buffer.
+ * @param iov      Source segments.
+ * @param iovcnt   Number of source segments.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, the number of bytes gathered
+ * from @p iov is returned. If the deadline expires, -ETIMEDOUT is
+ * returned instead.
+ *
+ * @note The caller must be the only writer of the portal buffer.
+ */
+PRIVATE ssize_t unix64_portal_buffer_send(
+    struct portal_buffer *buffer, const struct portal_iovec *iov, int iovcnt,
+    const struct unix64_deadline *deadline)
+{
+    ssize_t ret;
+    uint32_t counter;
+
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&buffer->writable);
+
+        if ((ret = unix64_portal_buffer_push(buffer, iov, iovcnt)) != -EBUSY)
+            return (ret);
+
+    } while (unix64_event_wait(&buffer->writable, counter, deadline) == 0);
+
+    return (-ETIMEDOUT);
+}
+
+/*============================================================================*
+ * unix64_portal_buffer_reserve()                                             *
+ *============================================================================*/
+
+/**
+ * @brief Waits for a free slot in a portal buffer.
+ *
+ * @param buffer   Target portal buffer.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, zero is returned. If the
+ * deadline expires, -ETIMEDOUT is returned instead.
+ *
+ * @note The caller must be the only writer of the portal buffer, thus
+ * the slot stays free until the caller fills it.
+ */
+PRIVATE int unix64_portal_buffer_reserve(struct portal_buffer *buffer,
+                                         const struct unix64_deadline *deadline)
+{
+    uint32_t counter;
+
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&buffer->writable);
+
+        if ((__atomic_load_n(&buffer->head, __ATOMIC_RELAXED) -
+             __atomic_load_n(&buffer->tail, __ATOMIC_ACQUIRE)) <
+            UNIX64_PORTAL_SLOTS_NUM)
+            return (0);
+
+    } while (unix64_event_wait(&buffer->writable, counter, deadline) == 0);
+
+    return (-ETIMEDOUT);
+}
+
+/*============================================================================*
+ * unix64_portal_buffer_link()                                                *
+ *============================================================================*/
+
+/**
+ * @brief Links the next free slot of a portal buffer to a multicast
+ * slot.
+ *
+ * @param buffer Target portal buffer.
+ * @param link   Target multicast slot.
+ * @param n      Number of bytes in the multicast slot.
+ *
+ * @note The caller must be the only writer of the portal buffer, and
+ * it must have reserved the slot with unix64_portal_buffer_reserve().
+ */
+PRIVATE void unix64_portal_buffer_link(struct portal_buffer *buffer,
+                                       int64_t link, size_t n)
+{
+    uint64_t head;
+
+    head = __atomic_load_n(&buffer->head, __ATOMIC_RELAXED);
+
+    buffer->size[head % UNIX64_PORTAL_SLOTS_NUM] = n;
+    buffer->link[head % UNIX64_PORTAL_SLOTS_NUM] = link;
+
+    /* Publish the slot to the reader. */
+    __atomic_store_n(&buffer->head, head + 1, __ATOMIC_RELEASE);
+
+    unix64_event_notify(&buffer->readable);
+}
+
+/*============================================================================*
+ * unix64_portal_mbuffer_await()                                              *
+ *============================================================================*/
+
+/**
+ * @brief Waits for the next slot of a multicast buffer to be released.
+ *
+ * @param mbuffer  Target multicast buffer.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, the index of the slot is
+ * returned. If the deadline expires, -ETIMEDOUT is returned instead.
+ *
+ * @note The caller must be the only writer of the multicast buffer.
+ */
+PRIVATE int unix64_portal_mbuffer_await(struct portal_mbuffer *mbuffer,
+                                        const struct unix64_deadline *deadline)
+{
+    int slot;
+    uint32_t counter;
+
+    slot = mbuffer->head % UNIX64_PORTAL_SLOTS_NUM;
+
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&mbuffer->released);
+
+        if (__atomic_load_n(&mbuffer->refcount[slot], __ATOMIC_ACQUIRE) == 0)
+            return (slot);
+
+    } while (unix64_event_wait(&mbuffer->released, counter, deadline) == 0);
+
+    return (-ETIMEDOUT);
+}
+
+/*============================================================================*
+ * unix64_portal_mbuffer_send()                                               *
+ *============================================================================*/
+
+/**
+ * @brief Fills the next slot of a multicast buffer and links it into
+ * the portal buffers of all readers, waiting for them.
+ *
+ * Data is copied once, no matter how many readers there are. Nothing
+ * is sent unless all readers have a free slot, thus either all of
+ * them or none of them get the data.
+ *
+ * @param portal   Target multicast portal.
+ * @param iov      Source segments.
+ * @param iovcnt   Number of source segments.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, the number of bytes gathered
+ * from @p iov is returned. If the deadline expires, -ETIMEDOUT is
+ * returned instead.
+ *
+ * @note The caller must be the only writer of the multicast portal.
+ */
+PRIVATE ssize_t unix64_portal_mbuffer_send(
+    struct portal *portal, const struct portal_iovec *iov, int iovcnt,
+    const struct unix64_deadline *deadline)
+{
+    int slot;
+    size_t n = 0;
+    uint32_t nreaders = 0;
+    struct portal_mbuffer *mbuffer;
+
+    mbuffer = portal->mbuffer;
+
+    /* Reserve a slot in the portal buffer of each reader. */
+    for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++) {
+        if (portal->buffers[i] == NULL)
+            continue;
+
+        if (unix64_portal_buffer_reserve(portal->buffers[i], deadline) < 0)
+            return (-ETIMEDOUT);
+
+        nreaders++;
+    }
+
+    if ((slot = unix64_portal_mbuffer_await(mbuffer, deadline)) < 0)
+        return (-ETIMEDOUT);
+
+    for (int i = 0; i < iovcnt; i++) {
+        kmemcpy(mbuffer->data[slot] + n, iov[i].base, iov[i].len);
+        n += iov[i].len;
+    }
+
+    __atomic_store_n(&mbuffer->refcount[slot], nreaders, __ATOMIC_RELAXED);
+    mbuffer->head++;
+
+    /* Publish the slot to all readers. */
+    for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++) {
+        if (portal->buffers[i] == NULL)
+            continue;
+
+        unix64_portal_buffer_link(
+            portal->buffers[i], UNIX64_PORTAL_LINK(portal->local, slot), n);
+    }
+
+    return (n);
+}
+
+/*============================================================================*
+ * unix64_portal_tx_send()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Sends data through an output portal, waiting for room.
+ *
+ * @param portal   Target output portal.
+ * @param iov      Source segments.
+ * @param iovcnt   Number of source segments.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, the number of bytes gathered
+ * from @p iov is returned. If the deadline expires, -ETIMEDOUT is
+ * returned instead.
+ *
+ * @note The caller must have set the portal as busy.
+ */
+PRIVATE ssize_t unix64_portal_tx_send(struct portal *portal,
+                                      const struct portal_iovec *iov,
+                                      int iovcnt,
+                                      const struct unix64_deadline *deadline)
+{
+    ssize_t ret;
+
+    /* Multicast portal. */
+    if (portal->mbuffer != NULL) {
+        ret = unix64_portal_mbuffer_send(portal, iov, iovcnt, deadline);
+
+        if (ret >= 0) {
+            for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++) {
+                if (portal->buffers[i] != NULL)
+                    unix64_doorbell_ring(i);
+            }
+        }
+
+        return (ret);
+    }
+
+    ret = unix64_portal_buffer_send(
+        portal->buffers[portal->remote], iov, iovcnt, deadline);
+
+    if (ret >= 0)
+        unix64_doorbell_ring(portal->remote);
+
+    return (ret);
+}
+
+/*============================================================================*
+ * unix64_portal_readv()                                                      *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ *
+ * @note This function is blocking.
+ * @note This function is thread-safe.
+ * @note This function is reentrant.
+ */
+PRIVATE ssize_t do_unix64_portal_readv(int portalid,
+                                       const struct portal_iovec *iov,
+                                       int iovcnt)
+{
+    int nread;
+    int remote;
+    int err;
+    struct portal_buffer *buffer;
+    struct unix64_deadline deadline;
+
+    err = -EBADF;
+
+    unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
+
+    /* Bad portal. */
+    if (!resource_is_used(&portaltab.rxs[portalid].resource))
+        goto error0;
+
+    /* Busy portal. */
+    if (resource_is_busy(&portaltab.rxs[portalid].resource)) {
+        err = -EBUSY;
+        goto error0;
+    }
+
+    /* No read operation is ongoing. */
+    if (portaltab.rxs[portalid].remote == -1)
+        goto error0;
+
+    /*
+     * Set portal as busy, because we
+     * release the endpoint lock below.
+     */
+    resource_set_busy(&portaltab.rxs[portalid].resource);
+
+    remote = portaltab.rxs[portalid].remote;
+    buffer = portaltab.rxs[portalid].buffers[remote];
+
+    unix64_deadline_set(&deadline, portaltab.rxs[portalid].timeout);
+
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+
+    /*
+     * We are the only reader of this buffer, thus
+     * we may drain a slot without the portal lock.
+     */
+    nread = unix64_portal_buffer_recv(buffer, iov, iovcnt, &deadline);
+
+    unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
+
+    if (nread >= 0)
+        portaltab.rxs[portalid].remote = -1;
+    unix64_portal_set_notbusy(&portaltab.rxs[portalid]);
+
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+
+    /* Writer may poll for room. */
+    if (nread >= 0)
+        unix64_doorbell_ring(remote);
+
+    return (nread);
+
+error0:
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+    return (err);
+}
+
+/**
+ * @see do_unix64_portal_readv().
+ */
+PUBLIC ssize_t unix64_portal_readv(int portalid,
+                                   const struct portal_iovec *iov, int iovcnt)
+{
+    return (do_unix64_portal_readv(portalid, iov, iovcnt));
+}
+
+/*============================================================================*
+ * unix64_portal_read()                                                       *
+ *============================================================================*/
+
+/**
+ * @see do_unix64_portal_readv().
+ *
+ * @todo Check fixed size from microkernel.
+ */
+PUBLIC ssize_t unix64_portal_read(int portalid, void *buf, size_t n)
+{
+    struct portal_iovec iov = {buf, n};
+
+    return (do_unix64_portal_readv(portalid, &iov, 1));
+}
+
+/*============================================================================*
+ * unix64_portal_writev()                                                     *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ *
+ * @note This function is blocking.
+ * @note This function is thread-safe.
+ * @note This function is reentrant.
+ */
+PRIVATE ssize_t do_unix64_portal_writev(int portalid,
+                                        const struct portal_iovec *iov,
+                                        int iovcnt)
+{
+    int nwrite;
+    int err;
+    struct unix64_deadline deadline;
+
+    unix64_portal_mutex_lock(&portaltab.txs[portalid]);
+
+    /* Bad portal. */
+    if (!resource_is_used(&portaltab.txs[portalid].resource)) {
+        err = -EBADF;
+        goto error0;
+    }
+
+    /* Busy portal. */
+    if (resource_is_busy(&portaltab.txs[portalid].resource)) {
+        err = -EBUSY;
+        goto error0;
+    }
+
+    /*
+     * Set portal as busy, because we
+     * release the endpoint lock below.
+     */
+    resource_set_busy(&portaltab.txs[portalid].resource);
+
+    unix64_deadline_set(&deadline, portaltab.txs[portalid].timeout);
+
+    unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
+
+    /*
+     * We are the only writer of this buffer, thus
+     * we may fill a slot without the portal lock.
+     */
+    nwrite =
+        unix64_portal_tx_send(&portaltab.txs[portalid], iov, iovcnt, &deadline);
+
+    unix64_portal_mutex_lock(&portaltab.txs[portalid]);
+    unix64_portal_set_notbusy(&portaltab.txs[portalid]);
+    unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
+
+    return (nwrite);
+
+error0:
+    unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
+    return (err);
+}
+
+/**
+ * @see do_unix64_portal_writev().
+ */
+PUBLIC ssize_t unix64_portal_writev(int portalid,
+                                    const struct portal_iovec *iov,
+                                    int iovcnt)
+{
+    return (do_unix64_portal_writev(portalid, iov, iovcnt));
+}
+
+/*============================================================================*
+ * unix64_portal_write()                                                      *
+ *============================================================================*/
+
+/**
+ * @see do_unix64_portal_writev().
+ *
+ * @todo Check fixed size from microkernel.
+ */
+PUBLIC ssize_t unix64_portal_write(int portalid, const void *buf, size_t n)
+{
+    struct portal_iovec iov = {(void *)buf, n};
+
+    return (do_unix64_portal_writev(portalid, &iov, 1));
+}
+
+/*============================================================================*
+ * unix64_portal_peek()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Gets the oldest message of a portal in place.
+ *
+ * The portal is kept busy until the message is handed back to the
+ * writer with unix64_portal_release().
+ *
+ * @note This function is blocking.
+ * @note This function is thread-safe.
+ */
+PRIVATE ssize_t do_unix64_portal_peek(int portalid, void **buf)
+{
+    int err;
+    int remote;
+    void *slot;
+    size_t size;
+    struct portal_buffer *buffer;
+    struct unix64_deadline deadline;
+
+    err = -EBADF;
+
+    unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
+
+    /* Bad portal. */
+    if (!resource_is_used(&portaltab.rxs[portalid].resource))
+        goto error0;
+
+    /* Busy portal. */
+    if (resource_is_busy(&portaltab.rxs[portalid].resource)) {
+        err = -EBUSY;
+        goto error0;
+    }
+
+    /* No read operation is ongoing. */
+    if (portaltab.rxs[portalid].remote == -1)
+        goto error0;
+
+    /*
+     * Set portal as busy, because we
+     * release the endpoint lock below.
+     */
+    resource_set_busy(&portaltab.rxs[portalid].resource);
+
+    remote = portaltab.rxs[portalid].remote;
+    buffer = portaltab.rxs[portalid].buffers[remote];
+
+    unix64_deadline_set(&deadline, portaltab.rxs[portalid].timeout);
+
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+
+    slot = unix64_portal_buffer_await(buffer, &size, &deadline);
+
+    unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
+
+    /* Deadline expired. */
+    if (slot == NULL) {
+        err = -ETIMEDOUT;
+        unix64_portal_set_notbusy(&portaltab.rxs[portalid]);
+        goto error0;
+    }
+
+    portaltab.rxs[portalid].slot = *buf = slot;
+
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+
+    return (size);
+
+error0:
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+    return (err);
+}
+
+/**
+ * @see do_unix64_portal_peek().
+ */
+PUBLIC ssize_t unix64_portal_peek(int portalid, void **buf)
+{
+    return (do_unix64_portal_peek(portalid, buf));
+}
+
+/*============================================================================*
+ * unix64_portal_release()                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Hands the message got with unix64_portal_peek() back to the
+ * writer.
+ *
+ * @note This function is non-blocking.
+ * @note This function is thread-safe.
+ */
+PRIVATE int do_unix64_portal_release(int portalid)
+{
+    int remote;
+
+    unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
+
+    /* Bad portal. */
+    if (!resource_is_used(&portaltab.rxs[portalid].resource)) {
+        unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+        return (-EBADF);
+    }
+
+    /* No peeked message. */
+    if (portaltab.rxs[portalid].slot == NULL) {
+        unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+        return (-EINVAL);
+    }
+
+    remote = portaltab.rxs[portalid].remote;
+    unix64_portal_buffer_retire(portaltab.rxs[portalid].buffers[remote]);
+
+    portaltab.rxs[portalid].slot = NULL;
+    portaltab.rxs[portalid].remote = -1;
+    unix64_portal_set_notbusy(&portaltab.rxs[portalid]);
+
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+
+    /* Writer may poll for room. */
+    unix64_doorbell_ring(remote);
+
+    return (0);
+}
+
+/**
+ * @see do_unix64_portal_release().
+ */
+PUBLIC int unix64_portal_release(int portalid)
+{
+    return (do_unix64_portal_release(portalid));
+}
+
+/*============================================================================*
+ * unix64_portal_read_large()                                                 *
+ *============================================================================*/
+
+/**
+ * @brief Reads a large amount of data from a portal.
+ *
+ * The data is drained in chunks of UNIX64_PORTAL_MAX_SIZE bytes, as
+ * soon as the writer publishes them. The transfer is enabled by a
+ * single call to unix64_portal_allow(), and it fails if the writer
+ * makes no progress within the timeout of the portal.
+ *
+ * @note If the transfer fails, the bytes drained so far are accounted
+ * in the portal, and the next call resumes the transfer from there,
+ * thus it should be given the same @p buf and @p n.
+ * @note This function is blocking.
+ * @note This function is thread-safe.
+ */
+PRIVATE ssize_t do_unix64_portal_read_large(int portalid, void *buf, size_t n)
+{
+    int err;
+    int timeout;
+    int remote;
+    size_t chunk;
+    ssize_t ret;
+    ssize_t nread;
+    struct portal_iovec iov;
+    struct portal_buffer *buffer;
+    struct unix64_deadline deadline;
+
+    err = -EBADF;
+
+    unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
+
+    /* Bad portal. */
+    if (!resource_is_used(&portaltab.rxs[portalid].resource))
+        goto error0;
+
+    /* Busy portal. */
+    if (resource_is_busy(&portaltab.rxs[portalid].resource)) {
+        err = -EBUSY;
+        goto error0;
+    }
+
+    /* No read operation is ongoing. */
+    if (portaltab.rxs[portalid].remote == -1)
+        goto error0;
+
+    /* Not the transfer that was interrupted. */
+    if (portaltab.rxs[portalid].offset > n) {
+        err = -EINVAL;
+        goto error0;
+    }
+
+    /*
+     * Set portal as busy, because we
+     * release the endpoint lock below.
+     */
+    resource_set_busy(&portaltab.rxs[portalid].resource);
+
+    remote = portaltab.rxs[portalid].remote;
+    buffer = portaltab.rxs[portalid].buffers[remote];
+
+    timeout = portaltab.rxs[portalid].timeout;
+
+    /* Resume a transfer that failed midway. */
+    nread = portaltab.rxs[portalid].offset;
+
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+
+    for (err = 0; nread < (ssize_t)n; nread += ret) {
+        chunk = n - nread;
+        if (chunk > UNIX64_PORTAL_MAX_SIZE)
+            chunk = UNIX64_PORTAL_MAX_SIZE;
+
+        iov.base = (char *)buf + nread;
+        iov.len = chunk;
+
+        /* Renew the deadline, as long as the writer makes progress. */
+        unix64_deadline_set(&deadline, timeout);
+
+        /* A short chunk is completed by the next one. */
+        ret = unix64_portal_buffer_recv(buffer, &iov, 1, &deadline);
+        if (ret < 0) {
+            err = ret;
+            break;
+        }
+    }
+
+    unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
+
+    /* Keep progress, so that the next call resumes from there. */
+    if (err < 0)
+        portaltab.rxs[portalid].offset = nread;
+    else {
+        portaltab.rxs[portalid].offset = 0;
+        portaltab.rxs[portalid].remote = -1;
+    }
+    unix64_portal_set_notbusy(&portaltab.rxs[portalid]);
+
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+
+    /* Writer may poll for room. */
+    unix64_doorbell_ring(remote);
+
+    return ((err < 0) ? err : nread);
+
+error0:
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+    return (err);
+}
+
+/**
+ * @see do_unix64_portal_read_large().
+ */
+PUBLIC ssize_t unix64_portal_read_large(int portalid, void *buf, size_t n)
+{
+    return (do_unix64_portal_read_large(portalid, buf, n));
+}
+
+/*============================================================================*
+ * unix64_portal_write_large()                                                *
+ *============================================================================*/
+
+/**
+ * @brief Writes a large amount of data to a portal.
+ *
+ * The data is streamed in chunks of UNIX64_PORTAL_MAX_SIZE bytes,
+ * keeping up to UNIX64_PORTAL_SLOTS_NUM chunks in flight. The transfer
+ * fails if the reader makes no progress within the timeout of the
+ * portal.
+ *
+ * @note This function is blocking.
+ * @note This function is thread-safe.
+ */
+PRIVATE ssize_t do_unix64_portal_write_large(int portalid, const void *buf,
+                                             size_t n)
+{
+    int err;
+    int timeout;
+    size_t chunk;
+    ssize_t nwrite;
+    struct portal_iovec iov;
+    struct unix64_deadline deadline;
+
+    unix64_portal_mutex_lock(&portaltab.txs[portalid]);
+
+    /* Bad portal. */
+    if (!resource_is_used(&portaltab.txs[portalid].resource)) {
+        err = -EBADF;
+        goto error0;
+    }
+
+    /* Busy portal. */
+    if (resource_is_busy(&portaltab.txs[portalid].resource)) {
+        err = -EBUSY;
+        goto error0;
+    }
+
+    /*
+     * Set portal as busy, because we
+     * release the endpoint lock below.
+     */
+    resource_set_busy(&portaltab.txs[portalid].resource);
+
+    timeout = portaltab.txs[portalid].timeout;
+
+    unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
+
+    for (nwrite = 0; nwrite < (ssize_t)n; nwrite += chunk) {
+        chunk = n - nwrite;
+        if (chunk > UNIX64_PORTAL_MAX_SIZE)
+            chunk = UNIX64_PORTAL_MAX_SIZE;
+
+        iov.base = (char *)buf + nwrite;
+        iov.len = chunk;
+
+        /* Renew the deadline, as long as the reader makes progress. */
+        unix64_deadline_set(&deadline, timeout);
+
+        if (unix64_portal_tx_send(
+                &portaltab.txs[portalid], &iov, 1, &deadline) < 0) {
+            nwrite = -ETIMEDOUT;
+            break;
+        }
+    }
+
+    unix64_portal_mutex_lock(&portaltab.txs[portalid]);
+    unix64_portal_set_notbusy(&portaltab.txs[portalid]);
+    unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
+
+    return (nwrite);
+
+error0:
+    unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
+    return (err);
+}
+
+/**
+ * @see do_unix64_portal_write_large().
+ */
+PUBLIC ssize_t unix64_portal_write_large(int portalid, const void *buf,
+                                         size_t n)
+{
+    return (do_unix64_portal_write_large(portalid, buf, n));
+}
+
+/*============================================================================*
+ * unix64_portal_unlink()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Spin wait counters of unix64_portal_unlink().
+ */
+PRIVATE struct spinwait_stats portal_unlink_stats =
+    SPINWAIT_STATS_INITIALIZER("unix64_portal_unlink");
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ *
+ * @note This function is blocking.
+ * @note This function is thread-safe.
+ * @note This function is reentrant.
+ */
+PUBLIC int unix64_portal_unlink(int portalid)
+{
+    uint32_t counter;
+    struct spinwait waiter;
+
+    spinwait_init(&waiter, &portal_unlink_stats);
+
+again:
+
+    unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
+
+    /* Bad local NoC node. */
+    if (portaltab.rxs[portalid].local != processor_node_get_num()) {
+        unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+        return (-EPERM);
+    }
+
+    /* Bad portal. */
+    if (!resource_is_used(&portaltab.rxs[portalid].resource)) {
+        unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+        return (-EBADF);
+    }
+
+    /* Busy portal. */
     if (resource_is_busy(&portaltab.rxs[portalid].resource)) {
-        unix64_portals_unlock();
+        counter = unix64_event_counter(&portaltab.rxs[portalid].idle);
+        unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+        unix64_event_spinwait(&portaltab.rxs[portalid].idle, counter, &waiter);
         goto again;
     }
 
+    /*
+     * Set portal as busy, because we
+     * release the endpoint lock below.
+     */
+    resource_set_busy(&portaltab.rxs[portalid].resource);
+
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+
     /* Release underlying resources. */
     for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++) {
         if (portaltab.rxs[portalid].buffers[i] != NULL) {
-            portaltab.rxs[portalid].buffers[i]->busy = 0;
-            portaltab.rxs[portalid].buffers[i]->ready = 0;
-            KASSERT(munmap(portaltab.rxs[portalid].buffers[i],
-                           sizeof(struct portal_buffer)) == 0);
-            KASSERT(close(portaltab.rxs[portalid].fd[i]) == 0);
-            portaltab.rxs[portalid].buffers[i] = NULL;
+            /* Drop in-flight data, releasing multicast slots. */
+            while (unix64_portal_buffer_front(
+                       portaltab.rxs[portalid].buffers[i], NULL) != NULL)
+                unix64_portal_buffer_retire(portaltab.rxs[portalid].buffers[i]);
+            unix64_portal_buffer_close(&portaltab.rxs[portalid], i);
         }
     }
-    KASSERT(sem_close(portaltab.rxs[portalid].lock) == 0);
+    unix64_portal_lock_close(&portaltab.rxs[portalid]);
+
+    unix64_portals_lock();
+    unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
+
+    portalnodes.rxs[portaltab.rxs[portalid].local] = -1;
 
+    unix64_portal_set_notbusy(&portaltab.rxs[portalid]);
     resource_free(&pool.rx, portalid);
 
+    unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
     unix64_portals_unlock();
 
     return (0);
@@ -789,6 +1831,12 @@ again:
  * unix64_portal_close()                                                      *
  *============================================================================*/
 
+/**
+ * @brief Spin wait counters of unix64_portal_close().
+ */
+PRIVATE struct spinwait_stats portal_close_stats =
+    SPINWAIT_STATS_INITIALIZER("unix64_portal_close");
+
 /**
  * @todo TODO: provide a detailed description for this function.
  *
@@ -798,38 +1846,177 @@ again:
  */
 PUBLIC int unix64_portal_close(int portalid)
 {
-    int remote;
+    int local;
+    uint32_t counter;
+    struct spinwait waiter;
+
+    spinwait_init(&waiter, &portal_close_stats);
 
 again:
 
-    unix64_portals_lock();
+    unix64_portal_mutex_lock(&portaltab.txs[portalid]);
 
     /* Bad portal. */
     if (!resource_is_used(&portaltab.txs[portalid].resource)) {
-        unix64_portals_unlock();
+        unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
         return (-EBADF);
     }
 
     /* Busy portal. */
     if (resource_is_busy(&portaltab.txs[portalid].resource)) {
-        unix64_portals_unlock();
+        counter = unix64_event_counter(&portaltab.txs[portalid].idle);
+        unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
+        unix64_event_spinwait(&portaltab.txs[portalid].idle, counter, &waiter);
         goto again;
     }
 
+    /*
+     * Set portal as busy, because we
+     * release the endpoint lock below.
+     */
+    resource_set_busy(&portaltab.txs[portalid].resource);
+
+    unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
+
     /* Close underlying resources. */
-    remote = portaltab.txs[portalid].remote;
-    KASSERT(munmap(portaltab.txs[portalid].buffers[remote],
-                   sizeof(struct portal_buffer)) == 0);
-    KASSERT(close(portaltab.txs[portalid].fd[remote]) == 0);
-    KASSERT(sem_close(portaltab.txs[portalid].lock) == 0);
+    for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++) {
+        if (portaltab.txs[portalid].buffers[i] != NULL)
+            unix64_portal_buffer_close(&portaltab.txs[portalid], i);
+    }
+    portaltab.txs[portalid].mbuffer = NULL;
+
+    unix64_portals_lock();
+    unix64_portal_mutex_lock(&portaltab.txs[portalid]);
+
+    local = portaltab.txs[portalid].local;
+    for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++) {
+        if (portalnodes.txs[local][i] == portalid)
+            portalnodes.txs[local][i] = -1;
+    }
+    if (portalnodes.mtxs[local] == portalid)
+        portalnodes.mtxs[local] = -1;
 
+    unix64_portal_set_notbusy(&portaltab.txs[portalid]);
     resource_free(&pool.tx, portalid);
 
+    unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
     unix64_portals_unlock();
 
     return (0);
 }
 
+/*============================================================================*
+ * unix64_portal_poll()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether or not a portal buffer has a free slot.
+ *
+ * @param buffer Target portal buffer.
+ *
+ * @returns Non-zero if the buffer may be written and zero otherwise.
+ */
+PRIVATE int unix64_portal_buffer_is_writable(struct portal_buffer *buffer)
+{
+    return ((__atomic_load_n(&buffer->head, __ATOMIC_RELAXED) -
+             __atomic_load_n(&buffer->tail, __ATOMIC_ACQUIRE)) <
+            UNIX64_PORTAL_SLOTS_NUM);
+}
+
+/**
+ * @brief Asserts whether or not an output portal has room for data.
+ *
+ * @param portal Target output portal.
+ *
+ * @returns Non-zero if the portal may be written and zero otherwise.
+ *
+ * @note A multicast portal has room only if all readers have room.
+ */
+PRIVATE int unix64_portal_tx_is_writable(struct portal *portal)
+{
+    struct portal_mbuffer *mbuffer;
+
+    /* Unicast portal. */
+    if ((mbuffer = portal->mbuffer) == NULL)
+        return (unix64_portal_buffer_is_writable(
+            portal->buffers[portal->remote]));
+
+    if (__atomic_load_n(
+            &mbuffer->refcount[mbuffer->head % UNIX64_PORTAL_SLOTS_NUM],
+            __ATOMIC_ACQUIRE) != 0)
+        return (0);
+
+    for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++) {
+        if ((portal->buffers[i] != NULL) &&
+            !unix64_portal_buffer_is_writable(portal->buffers[i]))
+            return (0);
+    }
+
+    return (1);
+}
+
+/**
+ * The unix64_portal_poll() function checks the input portal @p
+ * portalid for data from the allowed remote, if @p events has
+ * UNIX64_IKC_POLLIN set, and the output portal @p portalid for room,
+ * if @p events has UNIX64_IKC_POLLOUT set. An input portal is never
+ * readable before a remote is allowed, and busy portals are never
+ * ready, since their owners are about to use them.
+ *
+ * @note This function is thread-safe.
+ */
+PUBLIC int unix64_portal_poll(int portalid, unsigned events)
+{
+    int remote;
+    int revents = 0;
+
+    if (events & UNIX64_IKC_POLLIN) {
+        /* Bad portal. */
+        if (portalid >= UNIX64_PORTAL_CREATE_MAX)
+            return (-EBADF);
+
+        unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
+
+        /* Bad portal. */
+        if (!resource_is_used(&portaltab.rxs[portalid].resource)) {
+            unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+            return (-EBADF);
+        }
+
+        remote = portaltab.rxs[portalid].remote;
+
+        if (!resource_is_busy(&portaltab.rxs[portalid].resource) &&
+            (remote != -1) &&
+            (unix64_portal_buffer_front(
+                 portaltab.rxs[portalid].buffers[remote], NULL) != NULL))
+            revents |= UNIX64_IKC_POLLIN;
+
+        unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+    }
+
+    if (events & UNIX64_IKC_POLLOUT) {
+        /* Bad portal. */
+        if (portalid >= UNIX64_PORTAL_OPEN_MAX)
+            return (-EBADF);
+
+        unix64_portal_mutex_lock(&portaltab.txs[portalid]);
+
+        /* Bad portal. */
+        if (!resource_is_used(&portaltab.txs[portalid].resource)) {
+            unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
+            return (-EBADF);
+        }
+
+        if (!resource_is_busy(&portaltab.txs[portalid].resource) &&
+            unix64_portal_tx_is_writable(&portaltab.txs[portalid]))
+            revents |= UNIX64_IKC_POLLOUT;
+
+        unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
+    }
+
+    return (revents);
+}
+
 /*============================================================================*
  * unix64_portal_ioctl()                                                     *
  *============================================================================*/
@@ -848,11 +2035,6 @@ PUBLIC int unix64_portal_ioctl(int portalid, unsigned request, va_list args)
 {
     int ret = (-EINVAL); /* Return value. */
 
-    UNUSED(portalid);
-    UNUSED(args);
-
-    unix64_portals_lock();
-
     switch (request) {
     case UNIX64_PORTAL_IOCTL_SET_ASYNC_BEHAVIOR: {
         /**
@@ -862,15 +2044,39 @@ PUBLIC int unix64_portal_ioctl(int portalid, unsigned request, va_list args)
         ret = (0);
     } break;
 
+    case UNIX64_PORTAL_IOCTL_SET_TIMEOUT: {
+        int timeout = va_arg(args, int);
+
+        /* Bad timeout. */
+        if (timeout < UNIX64_PORTAL_TIMEOUT_INFINITE)
+            break;
+
+        ret = (-EBADF);
+
+        /* Input and output portals share the same IDs. */
+        if (portalid < UNIX64_PORTAL_CREATE_MAX) {
+            unix64_portal_mutex_lock(&portaltab.rxs[portalid]);
+            if (resource_is_used(&portaltab.rxs[portalid].resource)) {
+                portaltab.rxs[portalid].timeout = timeout;
+                ret = (0);
+            }
+            unix64_portal_mutex_unlock(&portaltab.rxs[portalid]);
+        }
+
+        if (portalid < UNIX64_PORTAL_OPEN_MAX) {
+            unix64_portal_mutex_lock(&portaltab.txs[portalid]);
+            if (resource_is_used(&portaltab.txs[portalid].resource)) {
+                portaltab.txs[portalid].timeout = timeout;
+                ret = (0);
+            }
+            unix64_portal_mutex_unlock(&portaltab.txs[portalid]);
+        }
+    } break;
+
     default:
         break;
     }
 
-    /*
-     * Release lock, since we may sleep below.
-     */
-    unix64_portals_unlock();
-
     return (ret);
 }
 
@@ -889,6 +2095,18 @@ PUBLIC void unix64_portal_setup(void)
         for (int j = 0; j < PROCESSOR_NOC_NODES_NUM; j++)
             portaltab.rxs[i].buffers[j] = NULL;
     }
+
+    for (int i = 0; i < UNIX64_PORTAL_OPEN_MAX; i++) {
+        for (int j = 0; j < PROCESSOR_NOC_NODES_NUM; j++)
+            portaltab.txs[i].buffers[j] = NULL;
+        portaltab.txs[i].mbuffer = NULL;
+    }
+
+    /* Portal buffers must fit in the shared arena of the NoC. */
+    KASSERT(sizeof(struct portal_buffer) <=
+            LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE);
+    KASSERT(sizeof(struct portal_mbuffer) <=
+            LINUX64_PROCESSOR_NOC_ARENA_SLOT_SIZE);
 }
 
 /*============================================================================*
@@ -900,36 +2118,10 @@ PUBLIC void unix64_portal_setup(void)
  */
 PUBLIC void unix64_portal_shutdown(void)
 {
-    /* Input portals. */
-    for (int i = 0; i < UNIX64_PORTAL_CREATE_MAX; i++) {
-        for (int j = 0; j < PROCESSOR_NOC_NODES_NUM; j++) {
-            munmap(portaltab.rxs[i].buffers[j], sizeof(struct portal_buffer));
-        }
-        sem_close(portaltab.rxs[i].lock);
-    }
-
-    /* Output portals. */
-    for (int i = 0; i < UNIX64_PORTAL_OPEN_MAX; i++) {
-        for (int j = 0; j < PROCESSOR_NOC_NODES_NUM; j++) {
-            munmap(portaltab.txs[i].buffers[j], sizeof(struct portal_buffer));
-        }
-        sem_close(portaltab.txs[i].lock);
-    }
-
-    /* Unlink portals. */
-    if (cluster_get_num() == PROCESSOR_CLUSTERNUM_MASTER) {
-        for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++) {
-            char pathname[UNIX64_PORTAL_NAME_LENGTH];
-
-            for (int j = 0; j < PROCESSOR_NOC_NODES_NUM; j++) {
-                sprintf(pathname, "%s-%d-%d", UNIX64_PORTAL_BASENAME, i, j);
-                shm_unlink(pathname);
-            }
-
-            sprintf(pathname, "%s-%d", UNIX64_PORTAL_BASENAME, i);
-            sem_unlink(pathname);
-        }
-    }
+    /*
+     * Portal buffers live in the shared arena of the NoC, which
+     * is released by the processor, and portal locks are local.
+     */
 }
 
 #endif /* !__NANVIX_IKC_USES_ONLY_MAILBOX */
@@ -0,0 +1,515 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <arch/target/unix64/unix64/ring.h>
+#include <fcntl.h>
+#include <nanvix/const.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Mask for slot indexes.
+ */
+#define UNIX64_RING_MASK (UNIX64_RING_SLOTS_NUM - 1)
+
+/*============================================================================*
+ * unix64_ring_map()                                                          *
+ *============================================================================*/
+
+/**
+ * The unix64_ring_map() function maps the ring that lives in the
+ * shared memory segment named @p name, creating it if needed. A
+ * freshly created segment is zero-filled, which is a valid empty
+ * ring, thus no further initialization is required and concurrent
+ * creators do not race.
+ */
+PUBLIC struct unix64_ring *unix64_ring_map(const char *name)
+{
+    int fd;
+    void *p;
+
+    KASSERT((UNIX64_RING_SLOTS_NUM & UNIX64_RING_MASK) == 0);
+
+    /* Open shared memory segment. */
+    if ((fd = shm_open(name, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR)) == -1)
+        goto error0;
+
+    /* Resizing to the same size keeps the contents. */
+    if (ftruncate(fd, sizeof(struct unix64_ring)) == -1)
+        goto error1;
+
+    if ((p = mmap(NULL,
+                  sizeof(struct unix64_ring),
+                  PROT_READ | PROT_WRITE,
+                  MAP_SHARED,
+                  fd,
+                  0)) == MAP_FAILED)
+        goto error1;
+
+    KASSERT(close(fd) != -1);
+
+    return (p);
+
+error1:
+    KASSERT(close(fd) != -1);
+error0:
+    return (NULL);
+}
+
+/*============================================================================*
+ * unix64_ring_unmap()                                                        *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC void unix64_ring_unmap(struct unix64_ring *ring)
+{
+    KASSERT(munmap(ring, sizeof(struct unix64_ring)) != -1);
+}
+
+/*============================================================================*
+ * unix64_ring_unlink()                                                       *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int unix64_ring_unlink(const char *name)
+{
+    return ((shm_unlink(name) == -1) ? -EAGAIN : 0);
+}
+
+/*============================================================================*
+ * unix64_ring_claim()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Claims a free slot of a lane.
+ *
+ * @param lane Target lane.
+ * @param pos  Place where the position of the slot should be stored.
+ *
+ * @returns Upon successful completion, the claimed slot is returned.
+ * If the lane is full, NULL is returned instead.
+ */
+PRIVATE struct unix64_ring_slot *
+unix64_ring_claim(struct unix64_ring_lane *lane, uint64_t *pos)
+{
+    uint64_t seq;
+    struct unix64_ring_slot *slot;
+
+    *pos = __atomic_load_n(&lane->head, __ATOMIC_RELAXED);
+
+    do {
+        slot = &lane->slots[*pos & UNIX64_RING_MASK];
+        seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) +
+              (*pos & UNIX64_RING_MASK);
+
+        /* Lane is full. */
+        if ((int64_t)(seq - *pos) < 0)
+            return (NULL);
+
+        /* Another producer got this slot. */
+        if (seq != *pos) {
+            *pos = __atomic_load_n(&lane->head, __ATOMIC_RELAXED);
+            continue;
+        }
+
+        if (__atomic_compare_exchange_n(&lane->head,
+                                        pos,
+                                        *pos + 1,
+                                        1,
+                                        __ATOMIC_RELAXED,
+                                        __ATOMIC_RELAXED))
+            return (slot);
+    } while (1);
+}
+
+/*============================================================================*
+ * unix64_ring_publish()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Publishes the message of a claimed slot.
+ *
+ * @param ring Target ring.
+ * @param lane Lane of the slot.
+ * @param pos  Position of the slot.
+ * @param n    Size of the message.
+ */
+PRIVATE void unix64_ring_publish(struct unix64_ring *ring,
+                                 struct unix64_ring_lane *lane, uint64_t pos,
+                                 size_t n)
+{
+    struct unix64_ring_slot *slot;
+
+    slot = &lane->slots[pos & UNIX64_RING_MASK];
+    slot->size = n;
+
+    __atomic_store_n(
+        &slot->seq, (pos + 1) - (pos & UNIX64_RING_MASK), __ATOMIC_RELEASE);
+
+    unix64_event_notify(&ring->readable);
+}
+
+/*============================================================================*
+ * unix64_ring_front()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Gets the oldest published slot of a lane.
+ *
+ * @param lane Target lane.
+ *
+ * @returns If the lane is not empty, the oldest published slot is
+ * returned. Otherwise, NULL is returned instead.
+ */
+PRIVATE struct unix64_ring_slot *
+unix64_ring_front(struct unix64_ring_lane *lane)
+{
+    uint64_t pos;
+    uint64_t seq;
+    struct unix64_ring_slot *slot;
+
+    pos = __atomic_load_n(&lane->tail, __ATOMIC_RELAXED);
+    slot = &lane->slots[pos & UNIX64_RING_MASK];
+    seq = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) +
+          (pos & UNIX64_RING_MASK);
+
+    /* Lane is empty. */
+    if (seq != (pos + 1))
+        return (NULL);
+
+    return (slot);
+}
+
+/*============================================================================*
+ * unix64_ring_first()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Gets the most urgent published slot of a ring.
+ *
+ * @param ring Target ring.
+ * @param lane Place where the lane of the slot should be stored.
+ *
+ * @returns If the ring is not empty, the oldest published slot of
+ * the highest non-empty lane is returned. Otherwise, NULL is returned
+ * instead.
+ */
+PRIVATE struct unix64_ring_slot *unix64_ring_first(struct unix64_ring *ring,
+                                                   int *lane)
+{
+    struct unix64_ring_slot *slot;
+
+    for (int i = UNIX64_RING_LANES_NUM - 1; i >= 0; i--) {
+        if ((slot = unix64_ring_front(&ring->lanes[i])) != NULL) {
+            *lane = i;
+            return (slot);
+        }
+    }
+
+    return (NULL);
+}
+
+/*============================================================================*
+ * unix64_ring_retire()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Hands the oldest published slot of a lane back to producers.
+ *
+ * @param lane Target lane.
+ */
+PRIVATE void unix64_ring_retire(struct unix64_ring_lane *lane)
+{
+    uint64_t pos;
+    struct unix64_ring_slot *slot;
+
+    pos = __atomic_load_n(&lane->tail, __ATOMIC_RELAXED);
+    slot = &lane->slots[pos & UNIX64_RING_MASK];
+
+    __atomic_store_n(&slot->seq,
+                     (pos + UNIX64_RING_SLOTS_NUM) - (pos & UNIX64_RING_MASK),
+                     __ATOMIC_RELEASE);
+    __atomic_store_n(&lane->tail, pos + 1, __ATOMIC_RELAXED);
+
+    unix64_event_notify(&lane->writable);
+}
+
+/*============================================================================*
+ * unix64_ring_push()                                                         *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int unix64_ring_push(struct unix64_ring *ring, int lane,
+                            const void *buf, size_t n)
+{
+    uint64_t pos;
+    struct unix64_ring_slot *slot;
+
+    KASSERT(WITHIN(lane, 0, UNIX64_RING_LANES_NUM));
+
+    if (n > UNIX64_RING_DATA_SIZE)
+        return (-EMSGSIZE);
+
+    if ((slot = unix64_ring_claim(&ring->lanes[lane], &pos)) == NULL)
+        return (-EAGAIN);
+
+    kmemcpy(slot->data, buf, n);
+    unix64_ring_publish(ring, &ring->lanes[lane], pos, n);
+
+    return (0);
+}
+
+/*============================================================================*
+ * unix64_ring_pop()                                                          *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC ssize_t unix64_ring_pop(struct unix64_ring *ring, void *buf, size_t n,
+                               int *lane)
+{
+    size_t size;
+    struct unix64_ring_slot *slot;
+
+    if ((slot = unix64_ring_first(ring, lane)) == NULL)
+        return (-EAGAIN);
+
+    /* Buffer is too small. */
+    if ((size = slot->size) > n)
+        return (-EMSGSIZE);
+
+    kmemcpy(buf, slot->data, size);
+    unix64_ring_retire(&ring->lanes[*lane]);
+
+    return (size);
+}
+
+/*============================================================================*
+ * unix64_ring_send()                                                         *
+ *============================================================================*/
+
+/**
+ * The unix64_ring_send() function pushes a message into the lane @p
+ * lane of the ring @p ring. If the lane is full, the caller sleeps
+ * until the consumer releases a slot of it or the deadline @p
+ * deadline expires.
+ */
+PUBLIC int unix64_ring_send(struct unix64_ring *ring, int lane,
+                            const void *buf, size_t n,
+                            const struct unix64_deadline *deadline)
+{
+    int ret;
+    uint32_t counter;
+
+    KASSERT(WITHIN(lane, 0, UNIX64_RING_LANES_NUM));
+
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&ring->lanes[lane].writable);
+
+        if ((ret = unix64_ring_push(ring, lane, buf, n)) != -EAGAIN)
+            return (ret);
+
+    } while (unix64_event_wait(&ring->lanes[lane].writable,
+                               counter,
+                               deadline) == 0);
+
+    return (-ETIMEDOUT);
+}
+
+/*============================================================================*
+ * unix64_ring_recv()                                                         *
+ *============================================================================*/
+
+/**
+ * The unix64_ring_recv() function pops the most urgent message from
+ * the ring @p ring. If the ring is empty, the caller sleeps until a
+ * producer publishes a message or the deadline @p deadline expires.
+ */
+PUBLIC ssize_t unix64_ring_recv(struct unix64_ring *ring, void *buf, size_t n,
+                                int *lane,
+                                const struct unix64_deadline *deadline)
+{
+    ssize_t ret;
+    uint32_t counter;
+
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&ring->readable);
+
+        if ((ret = unix64_ring_pop(ring, buf, n, lane)) != -EAGAIN)
+            return (ret);
+
+    } while (unix64_event_wait(&ring->readable, counter, deadline) == 0);
+
+    return (-ETIMEDOUT);
+}
+
+/*============================================================================*
+ * unix64_ring_reserve()                                                      *
+ *============================================================================*/
+
+/**
+ * The unix64_ring_reserve() function claims a free slot of the lane
+ * @p lane of the ring @p ring and hands out its data area, so that
+ * the caller builds the message in place. If the lane is full, the
+ * caller sleeps until the consumer releases a slot of it or the
+ * deadline @p deadline expires.
+ */
+PUBLIC void *unix64_ring_reserve(struct unix64_ring *ring, int lane,
+                                 uint64_t *pos,
+                                 const struct unix64_deadline *deadline)
+{
+    uint32_t counter;
+    struct unix64_ring_slot *slot;
+
+    KASSERT(WITHIN(lane, 0, UNIX64_RING_LANES_NUM));
+
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&ring->lanes[lane].writable);
+
+        if ((slot = unix64_ring_claim(&ring->lanes[lane], pos)) != NULL)
+            return (slot->data);
+
+    } while (unix64_event_wait(&ring->lanes[lane].writable,
+                               counter,
+                               deadline) == 0);
+
+    return (NULL);
+}
+
+/*============================================================================*
+ * unix64_ring_commit()                                                       *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC void unix64_ring_commit(struct unix64_ring *ring, int lane,
+                               uint64_t pos, size_t n)
+{
+    KASSERT(WITHIN(lane, 0, UNIX64_RING_LANES_NUM));
+    KASSERT(n <= UNIX64_RING_DATA_SIZE);
+
+    unix64_ring_publish(ring, &ring->lanes[lane], pos, n);
+}
+
+/*============================================================================*
+ * unix64_ring_peek()                                                         *
+ *============================================================================*/
+
+/**
+ * The unix64_ring_peek() function hands out the data area of the
+ * most urgent message of the ring @p ring, without consuming it. If
+ * the ring is empty, the caller sleeps until a producer publishes a
+ * message or the deadline @p deadline expires. The lane of the
+ * message is stored in @p lane, since a more urgent message may show
+ * up before the caller releases this one.
+ */
+PUBLIC void *unix64_ring_peek(struct unix64_ring *ring, size_t *n, int *lane,
+                              const struct unix64_deadline *deadline)
+{
+    uint32_t counter;
+    struct unix64_ring_slot *slot;
+
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&ring->readable);
+
+        if ((slot = unix64_ring_first(ring, lane)) != NULL) {
+            *n = slot->size;
+            return (slot->data);
+        }
+
+    } while (unix64_event_wait(&ring->readable, counter, deadline) == 0);
+
+    return (NULL);
+}
+
+/*============================================================================*
+ * unix64_ring_release()                                                      *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC void unix64_ring_release(struct unix64_ring *ring, int lane)
+{
+    KASSERT(WITHIN(lane, 0, UNIX64_RING_LANES_NUM));
+    KASSERT(unix64_ring_front(&ring->lanes[lane]) != NULL);
+
+    unix64_ring_retire(&ring->lanes[lane]);
+}
+
+/*============================================================================*
+ * unix64_ring_is_readable()                                                  *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int unix64_ring_is_readable(struct unix64_ring *ring)
+{
+    int lane;
+
+    return (unix64_ring_first(ring, &lane) != NULL);
+}
+
+/*============================================================================*
+ * unix64_ring_is_writable()                                                  *
+ *============================================================================*/
+
+/**
+ * The unix64_ring_is_writable() function asserts whether or not the
+ * slot at the head of the lane @p lane of the ring @p ring was handed
+ * back by the consumer. The answer is only a hint, since other
+ * producers may claim the slot right afterwards.
+ */
+PUBLIC int unix64_ring_is_writable(struct unix64_ring *ring, int lane)
+{
+    uint64_t pos;
+    uint64_t seq;
+    struct unix64_ring_lane *l;
+
+    KASSERT(WITHIN(lane, 0, UNIX64_RING_LANES_NUM));
+
+    l = &ring->lanes[lane];
+    pos = __atomic_load_n(&l->head, __ATOMIC_RELAXED);
+    seq = __atomic_load_n(&l->slots[pos & UNIX64_RING_MASK].seq,
+                          __ATOMIC_ACQUIRE) +
+          (pos & UNIX64_RING_MASK);
+
+    return ((int64_t)(seq - pos) >= 0);
+}
@@ -26,9 +26,13 @@
 #define __NEED_HAL_PROCESSOR
 #define __NEED_RESOURCE
 
+#include <arch/target/unix64/unix64/barrier.h>
+#include <arch/target/unix64/unix64/futex.h>
+#include <arch/target/unix64/unix64/mailbox.h>
+#include <arch/target/unix64/unix64/poll.h>
 #include <arch/target/unix64/unix64/sync.h>
+#include <arch/target/unix64/unix64/transport.h>
 #include <fcntl.h>
-#include <mqueue.h>
 #include <nanvix/const.h>
 #include <nanvix/hal/processor.h>
 #include <nanvix/hal/resource.h>
@@ -36,7 +40,6 @@
 #include <posix/errno.h>
 #include <pthread.h>
 #include <stdio.h>
-#include <sys/stat.h>
 
 #if !__NANVIX_IKC_USES_ONLY_MAILBOX
 
@@ -60,14 +63,71 @@ struct hash {
 
 #define HASH_INITIALIZER ((struct hash){-1, 0, -1, 0, 0})
 
+/**
+ * @brief Key of the shared barrier of a sync.
+ *
+ * The source is left out, so that all nodes of a sync agree on it.
+ */
+#define UNIX64_SYNC_BARRIER_KEY(hash)                                          \
+    (((((uint64_t)(hash).nodeslist) << 6) |                                    \
+      (((uint64_t)(hash).master) << 1) | ((uint64_t)(hash).type)) +            \
+     1)
+
+/**
+ * @brief Lane of signals in NoC connectors.
+ */
+#define UNIX64_SYNC_LANE 1
+
 /**
  * @brief Synchronization point.
+ *
+ * Signals travel through the NoC connectors of the selected
+ * transport, thus a process-local transport keeps them off POSIX IPC
+ * objects.
  */
 PRIVATE struct queue {
-    mqd_t fd;                               /**< Underlying file descriptor. */
-    char pathname[UNIX64_SYNC_NAME_LENGTH]; /**< Name of underlying mqueue.  */
+    union unix64_connector conn;            /**< Underlying NoC connector. */
+    char pathname[UNIX64_SYNC_NAME_LENGTH]; /**< Name of NoC connector.    */
 } mqueues[PROCESSOR_NOC_NODES_NUM];
 
+/**
+ * @brief Maximum number of relays pending on the demultiplexer.
+ */
+#define UNIX64_SYNC_RELAYS_MAX (2 * UNIX64_SYNC_CREATE_MAX)
+
+/**
+ * @brief Period for retrying pending relays (in milliseconds).
+ */
+#define UNIX64_SYNC_RELAY_PERIOD 1
+
+/**
+ * @brief Signal relayed down the topology.
+ */
+struct relay {
+    struct hash hash;                   /**< Relayed signal.     */
+    int nnodes;                         /**< Number of children. */
+    int nodes[PROCESSOR_NOC_NODES_NUM]; /**< Children.           */
+    int sent[PROCESSOR_NOC_NODES_NUM];  /**< Children signalled. */
+};
+
+/**
+ * @brief Demultiplexer of the local NoC connector.
+ *
+ * Relays are only touched by the demultiplexer thread, thus they are
+ * not locked.
+ */
+PRIVATE struct {
+    pthread_t thread;                            /**< Underlying thread. */
+    int running;                                 /**< Running?           */
+    int error;                                   /**< Failure, if any.   */
+    int nrelays;                                 /**< Pending relays.    */
+    struct relay relays[UNIX64_SYNC_RELAYS_MAX]; /**< Relays.            */
+} demux = {
+    .running = 0,
+    .error = 0,
+    .nrelays = 0,
+};
+
 /**
  * @brief Table of synchronization points.
  */
@@ -81,11 +141,18 @@ PRIVATE struct {
          */
         struct resource resource; /**< Generic resource information. */
 
+        pthread_mutex_t lock; /**< Endpoint lock.                */
+        struct unix64_event idle; /**< Sync no longer busy.   */
         int nbarriers;       /**< Number of barriers completed. */
         struct hash hash;    /**< Local sync hash.              */
         struct hash barrier; /**< Barrier control.              */
         int nreceived[PROCESSOR_NOC_NODES_NUM]; /**< Number of signals received.
                                                  */
+        int timeout;                   /**< Timeout (in milliseconds). */
+        int algorithm;                 /**< Algorithm.      */
+        int next;                      /**< Next in bucket. */
+        struct unix64_event event;     /**< Round completed. */
+        struct unix64_barrier *shared; /**< Shared barrier. */
     } rxs[UNIX64_SYNC_CREATE_MAX];
 
     /**
@@ -97,16 +164,29 @@ PRIVATE struct {
          */
         struct resource resource; /**< Generic resource information.        */
 
+        pthread_mutex_t lock; /**< Endpoint lock.                     */
+        struct unix64_event idle; /**< Sync no longer busy.          */
         int nnodes; /**< Number of remotes in broadcast.      */
         int nodes[PROCESSOR_NOC_NODES_NUM]; /**< IDs of attached nodes. */
         int sent[PROCESSOR_NOC_NODES_NUM];  /**< Signals when a signal has been
                                                sent. */
         struct hash hash; /**< Local sync hash.                     */
+        int timeout;      /**< Timeout (in milliseconds).           */
+        int algorithm;    /**< Algorithm.                           */
+        int nreceived[PROCESSOR_NOC_NODES_NUM]; /**< Signals received from
+                                                   children. */
+        int combined; /**< Signals of children combined?        */
+        int pending;  /**< Arrival pending?                     */
+        int next;     /**< Next in bucket.                      */
+        struct unix64_event event;     /**< Signal of a child received. */
+        struct unix64_barrier *shared; /**< Shared barrier.             */
+        uint32_t round;                /**< Round of the shared barrier. */
     } txs[UNIX64_SYNC_OPEN_MAX];
 } synctab = {
     .rxs[0 ...(UNIX64_SYNC_CREATE_MAX - 1)] =
         {
             .resource = RESOURCE_STATIC_INITIALIZER,
+            .lock = PTHREAD_MUTEX_INITIALIZER,
             .nbarriers = 0,
             .hash = HASH_INITIALIZER,
             .barrier = HASH_INITIALIZER,
@@ -114,11 +194,16 @@ PRIVATE struct {
                 {
                     0,
                 },
+            .timeout = UNIX64_SYNC_TIMEOUT_INFINITE,
+            .algorithm = UNIX64_SYNC_ALGORITHM_LINEAR,
+            .next = -1,
+            .shared = NULL,
         },
 
     .txs[0 ...(UNIX64_SYNC_OPEN_MAX - 1)] =
         {
             .resource = RESOURCE_STATIC_INITIALIZER,
+            .lock = PTHREAD_MUTEX_INITIALIZER,
             .nnodes = 0,
             .nodes =
                 {
@@ -129,9 +214,46 @@ PRIVATE struct {
                     0,
                 },
             .hash = HASH_INITIALIZER,
+            .timeout = UNIX64_SYNC_TIMEOUT,
+            .algorithm = UNIX64_SYNC_ALGORITHM_LINEAR,
+            .nreceived =
+                {
+                    0,
+                },
+            .combined = 0,
+            .pending = 0,
+            .next = -1,
+            .shared = NULL,
+            .round = 0,
         },
 };
 
+/**
+ * @brief Number of buckets in the hash index.
+ */
+#define UNIX64_SYNC_BUCKETS_NUM 16
+
+/**
+ * @brief Bucket of a sync in the hash index.
+ */
+#define UNIX64_SYNC_BUCKET(hash)                                               \
+    (((((hash)->nodeslist) << 1) | ((hash)->type)) % UNIX64_SYNC_BUCKETS_NUM)
+
+/**
+ * @brief Hash index of synchronization points.
+ *
+ * Syncs are chained in buckets by type and list of nodes, so that a
+ * signal is routed to its sync without scanning the whole table. Syncs
+ * of a bucket are told apart by their master as well.
+ */
+PRIVATE struct {
+    int rxs[UNIX64_SYNC_BUCKETS_NUM]; /**< Receiver buckets. */
+    int txs[UNIX64_SYNC_BUCKETS_NUM]; /**< Sender buckets.   */
+} synchash = {
+    .rxs[0 ...(UNIX64_SYNC_BUCKETS_NUM - 1)] = -1,
+    .txs[0 ...(UNIX64_SYNC_BUCKETS_NUM - 1)] = -1,
+};
+
 /**
  * @brief Pools of Synchronization Resource
  */
@@ -144,22 +266,48 @@ PRIVATE struct {
 };
 
 /**
- * @brief Sync module lock.
+ * @brief Sync table lock.
+ *
+ * It guards the allocation of syncs and the hash index. Everything
+ * else in a sync is guarded by the endpoint lock of the sync itself,
+ * which is taken after the table lock whenever both are needed.
  */
 PRIVATE pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
 
 /**
- * @brief Default message queue attribute.
+ * @brief Maximum number of parked signals.
+ */
+#define UNIX64_SYNC_BACKLOG_MAX (UNIX64_SYNC_MAX * PROCESSOR_NOC_NODES_NUM)
+
+/**
+ * @brief Backlog of signals.
+ *
+ * Signals may arrive before the target sync is created or opened, so
+ * the demultiplexer parks them until then. The backlog is guarded by
+ * the table lock.
+ */
+PRIVATE struct {
+    int nhashes;                                 /**< Parked signals. */
+    struct hash hashes[UNIX64_SYNC_BACKLOG_MAX]; /**< Signals.        */
+} backlog = {
+    .nhashes = 0,
+};
+
+#if (__UNIX64_SYNC_USES_SHM)
+
+/**
+ * @brief Table of shared barriers.
  */
-PRIVATE struct mq_attr mq_attr = {.mq_maxmsg = PROCESSOR_NOC_NODES_NUM,
-                                  .mq_msgsize = sizeof(struct hash)};
+PRIVATE struct unix64_barrier_table *barriers = NULL;
+
+#endif
 
 /*============================================================================*
  * unix64_sync_lock()                                                         *
  *============================================================================*/
 
 /**
- * @brief Locks Unix sync module.
+ * @brief Locks the table of syncs.
  */
 PRIVATE void unix64_sync_lock(void)
 {
@@ -171,13 +319,60 @@ PRIVATE void unix64_sync_lock(void)
  *============================================================================*/
 
 /**
- * @brief Unlocks Unix sync module.
+ * @brief Unlocks the table of syncs.
  */
 PRIVATE void unix64_sync_unlock(void)
 {
     pthread_mutex_unlock(&lock);
 }
 
+/*============================================================================*
+ * unix64_sync_endpoint_lock()                                                *
+ *============================================================================*/
+
+/**
+ * @brief Takes the endpoint lock of a sync.
+ *
+ * @param mutex Endpoint lock of the target sync.
+ */
+PRIVATE void unix64_sync_endpoint_lock(pthread_mutex_t *mutex)
+{
+    pthread_mutex_lock(mutex);
+}
+
+/*============================================================================*
+ * unix64_sync_endpoint_unlock()                                              *
+ *============================================================================*/
+
+/**
+ * @brief Releases the endpoint lock of a sync.
+ *
+ * @param mutex Endpoint lock of the target sync.
+ */
+PRIVATE void unix64_sync_endpoint_unlock(pthread_mutex_t *mutex)
+{
+    pthread_mutex_unlock(mutex);
+}
+
+/*============================================================================*
+ * unix64_sync_set_notbusy()                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Clears the busy flag of a sync.
+ *
+ * @param resource Resource of the target sync.
+ * @param idle     Idle event of the target sync.
+ *
+ * Threads that wait for the sync to become idle are woken up.
+ */
+PRIVATE void unix64_sync_set_notbusy(struct resource *resource,
+                                     struct unix64_event *idle)
+{
+    resource_set_notbusy(resource);
+    unix64_event_notify(idle);
+}
+
 /*============================================================================*
  * unix64_sync_build_nodeslist()                                              *
  *============================================================================*/
@@ -193,21 +388,184 @@ PRIVATE uint64_t unix64_sync_build_nodeslist(const int *nodes, int nnodes)
 }
 
 /*============================================================================*
- * do_unix64_sync_search_rx()                                                 *
+ * unix64_sync_nnodes()                                                       *
  *============================================================================*/
 
-PRIVATE int do_unix64_sync_search_rx(struct hash *hash)
+/**
+ * @brief Gets the number of nodes in a sync.
+ */
+PRIVATE int unix64_sync_nnodes(const struct hash *hash)
+{
+    int nnodes = 0;
+
+    for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++) {
+        if (hash->nodeslist & (1ULL << i))
+            nnodes++;
+    }
+
+    return (nnodes);
+}
+
+/*============================================================================*
+ * unix64_sync_rank()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Gets the rank of a node in a sync.
+ *
+ * The master has rank zero, and the other nodes follow in increasing
+ * order of NoC node number.
+ */
+PRIVATE int unix64_sync_rank(const struct hash *hash, int nodenum)
 {
-    for (unsigned i = 0; i < UNIX64_SYNC_CREATE_MAX; ++i) {
-        if (!resource_is_used(&synctab.rxs[i].resource))
+    int rank;
+
+    if (nodenum == (int)hash->master)
+        return (0);
+
+    rank = 1;
+    for (int i = 0; i < nodenum; i++) {
+        if ((i != (int)hash->master) && (hash->nodeslist & (1ULL << i)))
+            rank++;
+    }
+
+    return (rank);
+}
+
+/*============================================================================*
+ * unix64_sync_node()                                                         *
+ *============================================================================*/
+
+/**
+ * @brief Gets the node of a rank in a sync.
+ */
+PRIVATE int unix64_sync_node(const struct hash *hash, int rank)
+{
+    if (rank == 0)
+        return (hash->master);
+
+    for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; i++) {
+        if ((i == (int)hash->master) || !(hash->nodeslist & (1ULL << i)))
             continue;
 
+        if (--rank == 0)
+            return (i);
+    }
+
+    return (-EINVAL);
+}
+
+/*============================================================================*
+ * unix64_sync_parent()                                                       *
+ *============================================================================*/
+
+/**
+ * @brief Gets the parent of a slave node in the topology of a sync.
+ *
+ * @param hash      Target sync.
+ * @param algorithm Algorithm of the sync.
+ * @param nodenum   Target node.
+ *
+ * @returns The node that is one hop closer to the master.
+ */
+PRIVATE int unix64_sync_parent(const struct hash *hash, int algorithm,
+                               int nodenum)
+{
+    int bit;
+    int rank;
+
+    rank = unix64_sync_rank(hash, nodenum);
+
+    KASSERT(rank > 0);
+
+    switch (algorithm) {
+    /* Heap order. */
+    case UNIX64_SYNC_ALGORITHM_TREE:
+        rank = (rank - 1) / 2;
+        break;
+
+    /* Reached in the round of the highest bit. */
+    case UNIX64_SYNC_ALGORITHM_DISSEMINATION:
+        for (bit = 1; (bit << 1) <= rank; bit <<= 1)
+            ;
+        rank -= bit;
+        break;
+
+    default:
+        rank = 0;
+        break;
+    }
+
+    return (unix64_sync_node(hash, rank));
+}
+
+/*============================================================================*
+ * unix64_sync_children()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Gets the children of a node in the topology of a sync.
+ *
+ * @param hash      Target sync.
+ * @param algorithm Algorithm of the sync.
+ * @param nodenum   Target node.
+ * @param children  Place to store the children.
+ *
+ * @returns The number of children of @p nodenum, which are stored in
+ * @p children in the order that they should be signalled.
+ */
+PRIVATE int unix64_sync_children(const struct hash *hash, int algorithm,
+                                 int nodenum, int *children)
+{
+    int rank;
+    int nnodes;
+    int nchildren;
+
+    nchildren = 0;
+    nnodes = unix64_sync_nnodes(hash);
+    rank = unix64_sync_rank(hash, nodenum);
+
+    switch (algorithm) {
+    /* Heap order. */
+    case UNIX64_SYNC_ALGORITHM_TREE:
+        for (int c = 2 * rank + 1; (c <= 2 * rank + 2) && (c < nnodes); c++)
+            children[nchildren++] = unix64_sync_node(hash, c);
+        break;
+
+    /* In round k, ranks below 2^k reach rank + 2^k. */
+    case UNIX64_SYNC_ALGORITHM_DISSEMINATION:
+        for (int bit = 1; (rank + bit) < nnodes; bit <<= 1) {
+            if (bit > rank)
+                children[nchildren++] = unix64_sync_node(hash, rank + bit);
+        }
+        break;
+
+    default:
+        for (int c = 1; (rank == 0) && (c < nnodes); c++)
+            children[nchildren++] = unix64_sync_node(hash, c);
+        break;
+    }
+
+    return (nchildren);
+}
+
+/*============================================================================*
+ * do_unix64_sync_search_rx()                                                 *
+ *============================================================================*/
+
+PRIVATE int do_unix64_sync_search_rx(struct hash *hash)
+{
+    for (int i = synchash.rxs[UNIX64_SYNC_BUCKET(hash)]; i >= 0;
+         i = synctab.rxs[i].next) {
         if (synctab.rxs[i].hash.type != hash->type)
             continue;
 
         if (synctab.rxs[i].hash.nodeslist != hash->nodeslist)
             continue;
 
+        if (synctab.rxs[i].hash.master != hash->master)
+            continue;
+
         return (i);
     }
 
@@ -220,22 +578,136 @@ PRIVATE int do_unix64_sync_search_rx(struct hash *hash)
 
 PRIVATE int do_unix64_sync_search_tx(struct hash *hash)
 {
-    for (unsigned i = 0; i < UNIX64_SYNC_OPEN_MAX; ++i) {
-        if (!resource_is_used(&synctab.txs[i].resource))
-            continue;
-
+    for (int i = synchash.txs[UNIX64_SYNC_BUCKET(hash)]; i >= 0;
+         i = synctab.txs[i].next) {
         if (synctab.txs[i].hash.type != hash->type)
             continue;
 
         if (synctab.txs[i].hash.nodeslist != hash->nodeslist)
             continue;
 
+        if (synctab.txs[i].hash.master != hash->master)
+            continue;
+
         return (i);
     }
 
     return (-EINVAL);
 }
 
+/*============================================================================*
+ * do_unix64_sync_ignore_signal() *
+ *============================================================================*/
+
+PRIVATE void do_unix64_sync_ignore_signal(char *message, struct hash *hash)
+{
+    int source = hash->source;
+    int type = hash->type;
+    int master = hash->master;
+    int nodeslist = hash->nodeslist;
+
+    kprintf("[sync][unix64] Dropping signal: %s | hash = (source:%d, type:%d, "
+            "master:%d, nodeslist:%d)",
+            message,
+            source,
+            type,
+            master,
+            nodeslist);
+}
+
+/*============================================================================*
+ * do_unix64_sync_backlog_park()                                              *
+ *============================================================================*/
+
+/**
+ * @brief Parks a signal of a sync that does not exist yet.
+ *
+ * @param hash Target signal.
+ *
+ * @note The caller must hold the table lock.
+ * @note If the backlog is full, the oldest signal is dropped.
+ */
+PRIVATE void do_unix64_sync_backlog_park(struct hash *hash)
+{
+    if (backlog.nhashes == UNIX64_SYNC_BACKLOG_MAX) {
+        do_unix64_sync_ignore_signal("Backlog full.", &backlog.hashes[0]);
+
+        for (int i = 1; i < backlog.nhashes; i++)
+            backlog.hashes[i - 1] = backlog.hashes[i];
+        backlog.nhashes--;
+    }
+
+    backlog.hashes[backlog.nhashes++] = *hash;
+}
+
+/*============================================================================*
+ * do_unix64_sync_backlog_replay()                                            *
+ *============================================================================*/
+
+/**
+ * @brief Replays parked signals of syncs that now exist.
+ *
+ * @param local Local node.
+ *
+ * @note Signals are sent again to the local NoC connector, thus the
+ * demultiplexer routes them as if they had just arrived. Signals that
+ * do not fit in a bounded amount of time are parked again.
+ */
+PRIVATE void do_unix64_sync_backlog_replay(int local)
+{
+#if (__UNIX64_SYNC_USES_SHM)
+    UNUSED(local);
+#else
+    int i;                           /* Parked signal.   */
+    int sent;                        /* Replayed?        */
+    struct hash hash;                /* Replayed signal. */
+    struct unix64_deadline deadline; /* Replay deadline. */
+
+    unix64_deadline_set(&deadline, UNIX64_SYNC_TIMEOUT);
+
+    do {
+        unix64_sync_lock();
+
+        /* Search for a signal of a sync that exists. */
+        for (i = 0; i < backlog.nhashes; i++) {
+            if (do_unix64_sync_search_rx(&backlog.hashes[i]) >= 0)
+                break;
+
+            if ((backlog.hashes[i].type == UNIX64_SYNC_ALL_TO_ONE) &&
+                (do_unix64_sync_search_tx(&backlog.hashes[i]) >= 0))
+                break;
+        }
+
+        /* Done. */
+        if (i == backlog.nhashes) {
+            unix64_sync_unlock();
+            break;
+        }
+
+        hash = backlog.hashes[i];
+        for (; i < (backlog.nhashes - 1); i++)
+            backlog.hashes[i] = backlog.hashes[i + 1];
+        backlog.nhashes--;
+
+        unix64_sync_unlock();
+
+        sent = (unix64_transport_get()->send(&mqueues[local].conn,
+                                             UNIX64_SYNC_LANE,
+                                             &hash,
+                                             sizeof(struct hash),
+                                             &deadline) == 0);
+
+        /* Try again on a later replay. */
+        if (!sent) {
+            unix64_sync_lock();
+            do_unix64_sync_backlog_park(&hash);
+            unix64_sync_unlock();
+        }
+
+    } while (sent);
+#endif
+}
+
 /*============================================================================*
  * unix64_sync_create()                                                       *
  *============================================================================*/
@@ -267,19 +739,41 @@ PUBLIC int unix64_sync_create(const int *nodes, int nnodes, int type)
     if ((syncid = resource_alloc(&pool.rx)) < 0)
         goto error;
 
+#if (__UNIX64_SYNC_USES_SHM)
+    /* Attach to shared barrier. */
+    synctab.rxs[syncid].shared =
+        unix64_barrier_get(barriers, UNIX64_SYNC_BARRIER_KEY(hash));
+    if (synctab.rxs[syncid].shared == NULL) {
+        resource_free(&pool.rx, syncid);
+        goto error;
+    }
+#endif
+
     /* Initialize synchronization point. */
+    unix64_sync_endpoint_lock(&synctab.rxs[syncid].lock);
     synctab.rxs[syncid].hash = hash;
     synctab.rxs[syncid].barrier = HASH_INITIALIZER;
     synctab.rxs[syncid].nbarriers = 0;
+    synctab.rxs[syncid].timeout = UNIX64_SYNC_TIMEOUT_INFINITE;
+    synctab.rxs[syncid].algorithm = UNIX64_SYNC_ALGORITHM_LINEAR;
     kmemset(synctab.rxs[syncid].nreceived,
             0,
             PROCESSOR_NOC_NODES_NUM * sizeof(int));
 
     resource_set_rdonly(&synctab.rxs[syncid].resource);
-    resource_set_notbusy(&synctab.rxs[syncid].resource);
+    unix64_sync_set_notbusy(&synctab.rxs[syncid].resource,
+                            &synctab.rxs[syncid].idle);
+    unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
+
+    /* Index synchronization point. */
+    synctab.rxs[syncid].next = synchash.rxs[UNIX64_SYNC_BUCKET(&hash)];
+    synchash.rxs[UNIX64_SYNC_BUCKET(&hash)] = syncid;
 
     unix64_sync_unlock();
 
+    /* Signals may have arrived before us. */
+    do_unix64_sync_backlog_replay(hash.source);
+
     return (syncid + UNIX64_SYNC_CREATE_OFFSET);
 
 error:
@@ -320,17 +814,46 @@ PUBLIC int unix64_sync_open(const int *nodes, int nnodes, int type)
     if ((syncid = resource_alloc(&pool.tx)) < 0)
         goto error;
 
+#if (__UNIX64_SYNC_USES_SHM)
+    /* Attach to shared barrier. */
+    synctab.txs[syncid].shared =
+        unix64_barrier_get(barriers, UNIX64_SYNC_BARRIER_KEY(hash));
+    if (synctab.txs[syncid].shared == NULL) {
+        resource_free(&pool.tx, syncid);
+        goto error;
+    }
+    synctab.txs[syncid].round =
+        unix64_barrier_round(synctab.txs[syncid].shared);
+#endif
+
     /* Initialize synchronization point. */
+    unix64_sync_endpoint_lock(&synctab.txs[syncid].lock);
     synctab.txs[syncid].hash = hash;
     synctab.txs[syncid].nnodes = nnodes;
     kmemcpy(synctab.txs[syncid].nodes, nodes, nnodes * sizeof(int));
     kmemset(synctab.txs[syncid].sent, 0, nnodes * sizeof(int));
+    synctab.txs[syncid].timeout = UNIX64_SYNC_TIMEOUT;
+    synctab.txs[syncid].algorithm = UNIX64_SYNC_ALGORITHM_LINEAR;
+    synctab.txs[syncid].combined = 0;
+    synctab.txs[syncid].pending = 0;
+    kmemset(synctab.txs[syncid].nreceived,
+            0,
+            PROCESSOR_NOC_NODES_NUM * sizeof(int));
 
     resource_set_wronly(&synctab.txs[syncid].resource);
-    resource_set_notbusy(&synctab.txs[syncid].resource);
+    unix64_sync_set_notbusy(&synctab.txs[syncid].resource,
+                            &synctab.txs[syncid].idle);
+    unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
+
+    /* Index synchronization point. */
+    synctab.txs[syncid].next = synchash.txs[UNIX64_SYNC_BUCKET(&hash)];
+    synchash.txs[UNIX64_SYNC_BUCKET(&hash)] = syncid;
 
     unix64_sync_unlock();
 
+    /* Signals may have arrived before us. */
+    do_unix64_sync_backlog_replay(hash.source);
+
     return (syncid + UNIX64_SYNC_OPEN_OFFSET);
 
 error:
@@ -342,6 +865,12 @@ error:
  * unix64_sync_unlink()                                                       *
  *============================================================================*/
 
+/**
+ * @brief Spin wait counters of unix64_sync_unlink().
+ */
+PRIVATE struct spinwait_stats sync_unlink_stats =
+    SPINWAIT_STATS_INITIALIZER("unix64_sync_unlink");
+
 /**
  * @todo TODO: provide a detailed description for this function.
  *
@@ -351,10 +880,16 @@ error:
  */
 PUBLIC int unix64_sync_unlink(int syncid)
 {
+    uint32_t counter;       /* Event counter. */
+    struct spinwait waiter; /* Spin waiter.   */
+
     syncid -= UNIX64_SYNC_CREATE_OFFSET;
 
+    spinwait_init(&waiter, &sync_unlink_stats);
+
 again:
     unix64_sync_lock();
+    unix64_sync_endpoint_lock(&synctab.rxs[syncid].lock);
 
     /* Bad sync. */
     if (!resource_is_used(&synctab.rxs[syncid].resource))
@@ -366,20 +901,37 @@ again:
 
     /* Busy sync. */
     if (resource_is_busy(&synctab.rxs[syncid].resource)) {
+        counter = unix64_event_counter(&synctab.rxs[syncid].idle);
+        unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
         unix64_sync_unlock();
+        unix64_event_spinwait(&synctab.rxs[syncid].idle, counter, &waiter);
         goto again;
     }
 
+    /* Unindex synchronization point. */
+    for (int *p = &synchash.rxs[UNIX64_SYNC_BUCKET(&synctab.rxs[syncid].hash)];
+         *p >= 0;
+         p = &synctab.rxs[*p].next) {
+        if (*p == syncid) {
+            *p = synctab.rxs[syncid].next;
+            break;
+        }
+    }
+
     synctab.rxs[syncid].hash = HASH_INITIALIZER;
     synctab.rxs[syncid].barrier = HASH_INITIALIZER;
+    synctab.rxs[syncid].next = -1;
+    synctab.rxs[syncid].shared = NULL;
 
     resource_free(&pool.rx, syncid);
 
+    unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
     unix64_sync_unlock();
 
     return (0);
 
 error:
+    unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
     unix64_sync_unlock();
     return (-EBADF);
 }
@@ -388,6 +940,12 @@ error:
  * unix64_sync_close()                                                        *
  *============================================================================*/
 
+/**
+ * @brief Spin wait counters of unix64_sync_close().
+ */
+PRIVATE struct spinwait_stats sync_close_stats =
+    SPINWAIT_STATS_INITIALIZER("unix64_sync_close");
+
 /**
  * @todo TODO: provide a detailed description for this function.
  *
@@ -397,10 +955,16 @@ error:
  */
 PUBLIC int unix64_sync_close(int syncid)
 {
+    uint32_t counter;       /* Event counter. */
+    struct spinwait waiter; /* Spin waiter.   */
+
     syncid -= UNIX64_SYNC_OPEN_OFFSET;
 
+    spinwait_init(&waiter, &sync_close_stats);
+
 again:
     unix64_sync_lock();
+    unix64_sync_endpoint_lock(&synctab.txs[syncid].lock);
 
     /* Bad sync. */
     if (!resource_is_used(&synctab.txs[syncid].resource))
@@ -412,53 +976,99 @@ again:
 
     /* Busy sync. */
     if (resource_is_busy(&synctab.txs[syncid].resource)) {
+        counter = unix64_event_counter(&synctab.txs[syncid].idle);
+        unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
         unix64_sync_unlock();
+        unix64_event_spinwait(&synctab.txs[syncid].idle, counter, &waiter);
         goto again;
     }
 
+    /* Unindex synchronization point. */
+    for (int *p = &synchash.txs[UNIX64_SYNC_BUCKET(&synctab.txs[syncid].hash)];
+         *p >= 0;
+         p = &synctab.txs[*p].next) {
+        if (*p == syncid) {
+            *p = synctab.txs[syncid].next;
+            break;
+        }
+    }
+
     /* Initialize synchronization point. */
     synctab.txs[syncid].hash = HASH_INITIALIZER;
     synctab.txs[syncid].nnodes = 0;
+    synctab.txs[syncid].next = -1;
+    synctab.txs[syncid].shared = NULL;
 
     resource_free(&pool.tx, syncid);
 
+    unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
     unix64_sync_unlock();
 
     return (0);
 
 error:
+    unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
     unix64_sync_unlock();
     return (-EBADF);
 }
 
 /*============================================================================*
- * do_unix64_sync_ignore_signal() *
+ * unix64_sync_demux_error()                                                  *
  *============================================================================*/
 
-PRIVATE void do_unix64_sync_ignore_signal(char *message, struct hash *hash)
+/**
+ * @brief Gets the error of the demultiplexer.
+ *
+ * @returns If the demultiplexer failed, a negative error code is
+ * returned. Otherwise, zero is returned.
+ */
+PRIVATE inline int unix64_sync_demux_error(void)
 {
-    int source = hash->source;
-    int type = hash->type;
-    int master = hash->master;
-    int nodeslist = hash->nodeslist;
-
-    kprintf("[sync][unix64] Dropping signal: %s | hash = (source:%d, type:%d, "
-            "master:%d, nodeslist:%d)",
-            message,
-            source,
-            type,
-            master,
-            nodeslist);
+    return (__atomic_load_n(&demux.error, __ATOMIC_ACQUIRE));
 }
 
 /*============================================================================*
- * unix64_sync_wait()                                                         *
+ * do_unix64_sync_signal()                                                    *
  *============================================================================*/
 
 /**
- * @brief Sync module lock.
+ * @brief Sends a signal to some nodes.
+ *
+ * @param i        Initial node ID.
+ * @param nnodes   Number of nodes.
+ * @param nodes    Node IDs.
+ * @param sent     Nodes that were already signalled.
+ * @param hash     Message.
+ * @param deadline Deadline for waiting on full NoC connectors.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
  */
-PRIVATE pthread_mutex_t lock_wait = PTHREAD_MUTEX_INITIALIZER;
+PRIVATE inline int do_unix64_sync_signal(int i, int nnodes, const int *nodes,
+                                         int *sent, const struct hash *hash,
+                                         const struct unix64_deadline *deadline)
+{
+    int ret; /* Return value. */
+
+    for (; i < nnodes; ++i) {
+        if (sent[i])
+            continue;
+
+        if ((ret = unix64_transport_get()->send(&mqueues[nodes[i]].conn,
+                                                UNIX64_SYNC_LANE,
+                                                hash,
+                                                sizeof(struct hash),
+                                                deadline)) < 0)
+            goto error;
+
+        sent[i] = 1;
+    }
+
+    ret = 0;
+
+error:
+    return (ret);
+}
 
 /*============================================================================*
  * unix64_sync_barrier_is_complete()                                          *
@@ -468,16 +1078,24 @@ PRIVATE int unix64_sync_barrier_is_complete(struct rx *rx)
 {
     int received;
     int expected;
+    int nchildren;
+    int children[PROCESSOR_NOC_NODES_NUM];
 
     received = rx->barrier.nodeslist;
 
-    /* Does master notifies it? */
+    /* Does parent notifies it? */
     if (rx->hash.type == UNIX64_SYNC_ONE_TO_ALL)
-        expected = (rx->hash.nodeslist & (1 << rx->hash.master));
+        expected =
+            (1 << unix64_sync_parent(&rx->hash, rx->algorithm, rx->hash.source));
 
-    /* Does slaves notifies it? */
-    else
-        expected = (rx->hash.nodeslist & ~(1 << rx->hash.master));
+    /* Does children notifies it? */
+    else {
+        expected = 0;
+        nchildren = unix64_sync_children(
+            &rx->hash, rx->algorithm, rx->hash.source, children);
+        for (int i = 0; i < nchildren; i++)
+            expected |= (1 << children[i]);
+    }
 
     return (received == expected);
 }
@@ -508,7 +1126,7 @@ PRIVATE int unix64_sync_barrier_consume(struct rx *rx)
 {
     int consumed; /* Indicates if the barrier is consumed. */
 
-    unix64_sync_lock();
+    unix64_sync_endpoint_lock(&rx->lock);
 
     consumed = rx->nbarriers;
 
@@ -516,84 +1134,647 @@ PRIVATE int unix64_sync_barrier_consume(struct rx *rx)
     if (consumed)
         rx->nbarriers--;
 
-    unix64_sync_unlock();
+    unix64_sync_endpoint_unlock(&rx->lock);
 
     return (consumed);
 }
 
 /*============================================================================*
- * do_unix64_sync_wait()                                                      *
+ * unix64_sync_children_consume()                                             *
+ *============================================================================*/
+
+/**
+ * @brief Consumes a signal of each child in a gather.
+ *
+ * @param tx        Target sync.
+ * @param children  Children of the local node.
+ * @param nchildren Number of children.
+ *
+ * @returns Non-zero if all children have signalled, and zero
+ * otherwise.
+ */
+PRIVATE int unix64_sync_children_consume(struct tx *tx, const int *children,
+                                         int nchildren)
+{
+    int consumed; /* Indicates if signals were consumed. */
+
+    unix64_sync_endpoint_lock(&tx->lock);
+
+    consumed = 1;
+    for (int i = 0; i < nchildren; i++) {
+        if (tx->nreceived[children[i]] == 0) {
+            consumed = 0;
+            break;
+        }
+    }
+
+    if (consumed) {
+        for (int i = 0; i < nchildren; i++)
+            tx->nreceived[children[i]]--;
+    }
+
+    unix64_sync_endpoint_unlock(&tx->lock);
+
+    return (consumed);
+}
+
+/*============================================================================*
+ * do_unix64_sync_combine()                                                   *
  *============================================================================*/
 
 /**
- * @brief Waits for a signal.
+ * @brief Waits for the children of a gather to signal.
  *
- * @param syncid ID of the target sync.
- * @param sig    Place where the received signal should be stored.
+ * @param tx        Target sync.
+ * @param children  Children of the local node.
+ * @param nchildren Number of children.
+ * @param deadline  Deadline for waiting.
  *
  * @returns Upon successful completion, zero is returned. Upon
  * failure, a negative error code is returned instead.
  */
-PRIVATE int do_unix64_sync_wait(struct rx *rx)
+PRIVATE int do_unix64_sync_combine(struct tx *tx, const int *children,
+                                   int nchildren,
+                                   const struct unix64_deadline *deadline)
 {
-    int syncid;       /* Synchronization point. */
-    struct hash hash; /* Hash buffer.           */
+    int ret;          /* Return value.  */
+    uint32_t counter; /* Event counter. */
 
-    /* Is the previous wait released me? */
-    if (unix64_sync_barrier_consume(rx))
-        return (0);
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&tx->event);
+
+        /* Did the demultiplexer receive them? */
+        if (unix64_sync_children_consume(tx, children, nchildren))
+            return (0);
+
+        /* Did the demultiplexer fail? */
+        if ((ret = unix64_sync_demux_error()) < 0)
+            return (ret);
+
+    } while (unix64_event_wait(&tx->event, counter, deadline) == 0);
+
+    return (-ETIMEDOUT);
+}
 
-    spinlock_lock(&lock_wait);
+/*============================================================================*
+ * do_unix64_sync_signal_topology()                                           *
+ *============================================================================*/
+
+/**
+ * @brief Signals the neighbours of the local node in a sync.
+ *
+ * @param tx       Target sync.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note In a broadcast the master signals its children. In a gather a
+ * slave first combines the signals of its children, if any, and then
+ * signals its parent. Partial progress is kept across timeouts.
+ */
+PRIVATE int do_unix64_sync_signal_topology(
+    struct tx *tx, const struct unix64_deadline *deadline)
+{
+    int ret;                             /* Return value.       */
+    int local;                           /* Local node.         */
+    int ndests;                          /* Number of targets.  */
+    int dests[PROCESSOR_NOC_NODES_NUM];  /* Target nodes.       */
+
+    local = tx->hash.source;
+
+    /* Broadcast. */
+    if (tx->hash.type == UNIX64_SYNC_ONE_TO_ALL)
+        ndests = unix64_sync_children(&tx->hash, tx->algorithm, local, dests);
+
+    /* Gather. */
+    else {
+        if (!tx->combined) {
+            ndests =
+                unix64_sync_children(&tx->hash, tx->algorithm, local, dests);
+
+            if (ndests > 0) {
+                ret = do_unix64_sync_combine(tx, dests, ndests, deadline);
+                if (ret < 0)
+                    return (ret);
+            }
+
+            tx->combined = 1;
+        }
+
+        dests[0] = unix64_sync_parent(&tx->hash, tx->algorithm, local);
+        ndests = 1;
+    }
+
+    if ((ret = do_unix64_sync_signal(0, ndests, dests, tx->sent, &tx->hash,
+                                     deadline)) == 0) {
+        for (int i = 0; i < ndests; ++i)
+            tx->sent[i] = 0;
+        tx->combined = 0;
+    }
+
+    return (ret);
+}
+
+/*============================================================================*
+ * do_unix64_sync_signal_shared()                                             *
+ *============================================================================*/
+
+#if (__UNIX64_SYNC_USES_SHM)
+
+/**
+ * @brief Arrives at the shared barrier of a sync.
+ *
+ * @param tx       Target sync.
+ * @param deadline Deadline for waiting on a previous round.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note In a broadcast the master is the only sender, whereas in a
+ * gather every slave is.
+ */
+PRIVATE inline int
+do_unix64_sync_signal_shared(struct tx *tx,
+                             const struct unix64_deadline *deadline)
+{
+    int ret;
+    uint32_t nsenders;
+
+    nsenders = (tx->hash.type == UNIX64_SYNC_ONE_TO_ALL)
+                   ? 1
+                   : (uint32_t)(tx->nnodes - 1);
+
+    if ((ret = unix64_barrier_arrive(
+             tx->shared, &tx->round, nsenders, deadline)) < 0)
+        return (ret);
+
+    /* Waiters may poll for the round. */
+    if (tx->hash.type == UNIX64_SYNC_ONE_TO_ALL) {
+        for (int i = 1; i < tx->nnodes; i++)
+            unix64_doorbell_ring(tx->nodes[i]);
+    } else
+        unix64_doorbell_ring(tx->nodes[0]);
+
+    return (0);
+}
+
+#endif /* __UNIX64_SYNC_USES_SHM */
+
+/*============================================================================*
+ * do_unix64_sync_arrival()                                                   *
+ *============================================================================*/
+
+/**
+ * @brief Delivers the arrival of the local node at a sync.
+ *
+ * @param tx       Target sync.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ */
+PRIVATE inline int do_unix64_sync_arrival(struct tx *tx,
+                                          const struct unix64_deadline *deadline)
+{
+#if (__UNIX64_SYNC_USES_SHM)
+    return (do_unix64_sync_signal_shared(tx, deadline));
+#else
+    return (do_unix64_sync_signal_topology(tx, deadline));
+#endif
+}
+
+/*============================================================================*
+ * do_unix64_sync_progress()                                                  *
+ *============================================================================*/
 
-    /* Is other core released me? */
-    if (unix64_sync_barrier_consume(rx)) {
-        spinlock_unlock(&lock_wait);
+/**
+ * @brief Makes progress on the pending arrival of a sync.
+ *
+ * @param tx       Target sync.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns If the arrival was delivered, zero is returned. If someone
+ * else is making progress on it, -EBUSY is returned. Otherwise, the
+ * error code of the delivery is returned, and the arrival is kept
+ * pending.
+ */
+PRIVATE int do_unix64_sync_progress(struct tx *tx,
+                                    const struct unix64_deadline *deadline)
+{
+    int ret;
+
+    unix64_sync_endpoint_lock(&tx->lock);
+
+    /* Delivered. */
+    if (!tx->pending) {
+        unix64_sync_endpoint_unlock(&tx->lock);
         return (0);
     }
 
-    /* Reads a signal. */
-    if (mq_receive(mqueues[rx->hash.source].fd,
-                   (char *)&hash,
-                   sizeof(struct hash),
-                   NULL) == -1) {
-        spinlock_unlock(&lock_wait);
-        return (-EAGAIN);
+    /* Busy sync. */
+    if (resource_is_busy(&tx->resource)) {
+        unix64_sync_endpoint_unlock(&tx->lock);
+        return (-EBUSY);
+    }
+
+    resource_set_busy(&tx->resource);
+
+    /*
+     * Release lock, since we may sleep below.
+     */
+    unix64_sync_endpoint_unlock(&tx->lock);
+
+    ret = do_unix64_sync_arrival(tx, deadline);
+
+    unix64_sync_endpoint_lock(&tx->lock);
+    if (ret == 0)
+        tx->pending = 0;
+    unix64_sync_set_notbusy(&tx->resource, &tx->idle);
+    unix64_sync_endpoint_unlock(&tx->lock);
+
+    return (ret);
+}
+
+/*============================================================================*
+ * do_unix64_sync_relay_flush()                                               *
+ *============================================================================*/
+
+/**
+ * @brief Sends pending relays.
+ *
+ * @param deadline Deadline for waiting on full NoC connectors.
+ *
+ * @returns The number of relays that are still pending.
+ *
+ * @note Relays that fail for other reasons than a full NoC connector
+ * are dropped. Partial progress is kept across timeouts.
+ */
+PRIVATE int do_unix64_sync_relay_flush(const struct unix64_deadline *deadline)
+{
+    int ret;             /* Return value.  */
+    int npending;        /* Still pending. */
+    struct relay *relay; /* Target relay.  */
+
+    npending = 0;
+
+    for (int i = 0; i < demux.nrelays; i++) {
+        relay = &demux.relays[i];
+
+        ret = do_unix64_sync_signal(0,
+                                    relay->nnodes,
+                                    relay->nodes,
+                                    relay->sent,
+                                    &relay->hash,
+                                    deadline);
+
+        /* Delivered. */
+        if (ret == 0)
+            continue;
+
+        if (ret != (-ETIMEDOUT)) {
+            do_unix64_sync_ignore_signal("Relay failed.", &relay->hash);
+            continue;
+        }
+
+        if (npending != i)
+            demux.relays[npending] = *relay;
+        npending++;
+    }
+
+    return (demux.nrelays = npending);
+}
+
+/*============================================================================*
+ * do_unix64_sync_relay_push()                                                *
+ *============================================================================*/
+
+/**
+ * @brief Queues a relay.
+ *
+ * @param hash   Relayed signal.
+ * @param nnodes Number of children.
+ * @param nodes  Children.
+ *
+ * @note If the queue is full, children are given a bounded amount of
+ * time to drain their NoC connectors, after which the oldest relay is
+ * dropped.
+ */
+PRIVATE void do_unix64_sync_relay_push(const struct hash *hash, int nnodes,
+                                       const int *nodes)
+{
+    struct relay *relay;             /* Target relay. */
+    struct unix64_deadline deadline; /* Deadline.     */
+
+    if (demux.nrelays == UNIX64_SYNC_RELAYS_MAX) {
+        unix64_deadline_set(&deadline, UNIX64_SYNC_TIMEOUT);
+
+        if (do_unix64_sync_relay_flush(&deadline) == UNIX64_SYNC_RELAYS_MAX) {
+            do_unix64_sync_ignore_signal("Relay dropped.",
+                                         &demux.relays[0].hash);
+
+            for (int i = 1; i < demux.nrelays; i++)
+                demux.relays[i - 1] = demux.relays[i];
+            demux.nrelays--;
+        }
+    }
+
+    relay = &demux.relays[demux.nrelays++];
+    relay->hash = *hash;
+    relay->nnodes = nnodes;
+
+    for (int i = 0; i < nnodes; i++) {
+        relay->nodes[i] = nodes[i];
+        relay->sent[i] = 0;
+    }
+}
+
+/*============================================================================*
+ * do_unix64_sync_route()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Routes a signal to its sync.
+ *
+ * @param local Local node.
+ * @param hash  Received signal.
+ *
+ * @note A signal either completes a round of a sync that we wait on,
+ * which we relay to our children in a broadcast, or comes from a
+ * child of a gather that we combine before signalling. Only the
+ * waiters of the target sync are woken up. Relays are queued, and
+ * later sent by the demultiplexer in between receives.
+ */
+PRIVATE void do_unix64_sync_route(int local, struct hash *hash)
+{
+    int syncid;                          /* Synchronization point. */
+    struct rx *rx;                       /* Receiver sync.         */
+    struct tx *tx;                       /* Sender sync.           */
+    struct hash relay;                   /* Relayed signal.        */
+    int nrelays;                         /* Number of relays.      */
+    int relays[PROCESSOR_NOC_NODES_NUM]; /* Relay nodes.           */
+    struct unix64_event *event;          /* Event to notify.       */
+    struct tx *pending;                  /* Pending arrival.       */
+    struct unix64_deadline now;          /* Progress deadline.     */
+
+    event = NULL;
+    pending = NULL;
+    nrelays = 0;
+
+    if (!node_is_valid(hash->source)) {
+        do_unix64_sync_ignore_signal("Invalid source.", hash);
+        return;
     }
 
     unix64_sync_lock();
 
-    if (!node_is_valid(hash.source)) {
-        do_unix64_sync_ignore_signal("Invalid source.", &hash);
-        goto release;
+    /* Signal of a sync that we wait on. */
+    if ((syncid = do_unix64_sync_search_rx(hash)) >= 0) {
+        rx = &synctab.rxs[syncid];
+
+        /* Other syncs may be looked up meanwhile. */
+        unix64_sync_endpoint_lock(&rx->lock);
+        unix64_sync_unlock();
+
+        rx->barrier.nodeslist |= (1 << hash->source);
+        rx->nreceived[hash->source]++;
+
+        if (unix64_sync_barrier_is_complete(rx)) {
+            unix64_sync_barrier_reset(rx);
+            rx->nbarriers++;
+            event = &rx->event;
+
+            /* Relay broadcast down the topology. */
+            if (rx->hash.type == UNIX64_SYNC_ONE_TO_ALL) {
+                relay = rx->hash;
+                nrelays =
+                    unix64_sync_children(&relay, rx->algorithm, local, relays);
+            }
+        }
+
+        unix64_sync_endpoint_unlock(&rx->lock);
     }
 
-    if ((syncid = do_unix64_sync_search_rx(&hash)) < 0) {
-        do_unix64_sync_ignore_signal("Sync point not found.", &hash);
-        goto release;
+    /* Signal of a child in a gather that we combine. */
+    else if ((hash->type == UNIX64_SYNC_ALL_TO_ONE) &&
+             ((syncid = do_unix64_sync_search_tx(hash)) >= 0)) {
+        tx = &synctab.txs[syncid];
+
+        /* Other syncs may be looked up meanwhile. */
+        unix64_sync_endpoint_lock(&tx->lock);
+        unix64_sync_unlock();
+
+        tx->nreceived[hash->source]++;
+        event = &tx->event;
+
+        /* Push a split-phase arrival up the topology. */
+        if (tx->pending)
+            pending = tx;
+
+        unix64_sync_endpoint_unlock(&tx->lock);
+    }
+
+    /* Sync may be created or opened later. */
+    else {
+        do_unix64_sync_backlog_park(hash);
+        unix64_sync_unlock();
     }
 
-    synctab.rxs[syncid].barrier.nodeslist |= (1 << hash.source);
-    synctab.rxs[syncid].nreceived[hash.source]++;
+    if (event != NULL)
+        unix64_event_notify(event);
 
-    if (unix64_sync_barrier_is_complete(&synctab.rxs[syncid])) {
-        unix64_sync_barrier_reset(&synctab.rxs[syncid]);
-        synctab.rxs[syncid].nbarriers++;
+    if (pending != NULL) {
+        unix64_deadline_set(&now, 0);
+        do_unix64_sync_progress(pending, &now);
     }
 
-release:
-    unix64_sync_unlock();
-    spinlock_unlock(&lock_wait);
+    /* Local threads may poll for the sync. */
+    if ((event != NULL) || (pending != NULL))
+        unix64_doorbell_ring(local);
+
+    /* Children must not miss a round, but we must not block on them. */
+    if (nrelays > 0)
+        do_unix64_sync_relay_push(&relay, nrelays, relays);
+}
+
+/*============================================================================*
+ * do_unix64_sync_demux_fail()                                                *
+ *============================================================================*/
+
+/**
+ * @brief Records a failure of the demultiplexer.
+ *
+ * @param local Local node.
+ * @param error Error code.
+ *
+ * @note All waiters are woken up, so that they fail with @p error
+ * instead of waiting on signals that will never be routed.
+ */
+PRIVATE void do_unix64_sync_demux_fail(int local, int error)
+{
+    kprintf("[sync][unix64] demultiplexer failed (%d)", error);
+
+    __atomic_store_n(&demux.error, error, __ATOMIC_RELEASE);
+
+    for (int i = 0; i < UNIX64_SYNC_CREATE_MAX; i++)
+        unix64_event_notify(&synctab.rxs[i].event);
+
+    for (int i = 0; i < UNIX64_SYNC_OPEN_MAX; i++)
+        unix64_event_notify(&synctab.txs[i].event);
+
+    /* Local threads may poll for a sync. */
+    unix64_doorbell_ring(local);
+}
+
+/*============================================================================*
+ * unix64_sync_demux()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Demultiplexes the local NoC connector.
+ *
+ * @param arg Local node.
+ *
+ * @returns Always NULL.
+ *
+ * @note The local NoC connector is drained by this thread alone, thus
+ * waiters on distinct syncs never serialize on it.
+ * @note Relays are sent without blocking in between receives, so
+ * that a full NoC connector of a child does not stall the thread.
+ */
+PRIVATE void *unix64_sync_demux(void *arg)
+{
+    ssize_t ret;                  /* Return value.    */
+    int lane;                     /* Lane of signal.  */
+    int local;                    /* Local node.      */
+    struct unix64_deadline retry; /* Relay deadline.  */
+
+    /* Some transports only receive whole NoC connector messages. */
+    union {
+        struct hash hash;                        /* Signal.  */
+        char data[UNIX64_MAILBOX_MSG_SIZE_MAX]; /* Message. */
+    } buf;
+
+    local = (int)(long)arg;
+
+    do {
+        /* Reads a signal, waking up to retry pending relays. */
+        unix64_deadline_set(
+            &retry, (demux.nrelays > 0) ? UNIX64_SYNC_RELAY_PERIOD : -1);
+        ret = unix64_transport_get()->recv(
+            &mqueues[local].conn, &buf, sizeof(buf), &lane, &retry);
+
+        if (ret < 0) {
+            if (ret != -ETIMEDOUT) {
+                do_unix64_sync_demux_fail(local, ret);
+                break;
+            }
+        }
+
+        /* Stop request. */
+        else if (!__atomic_load_n(&demux.running, __ATOMIC_ACQUIRE))
+            break;
+
+        /* Not a signal. */
+        else if (ret != sizeof(struct hash)) {
+            do_unix64_sync_demux_fail(local, -EBADMSG);
+            break;
+        }
+
+        else
+            do_unix64_sync_route(local, &buf.hash);
+
+        /* Never block on children. */
+        if (demux.nrelays > 0) {
+            unix64_deadline_set(&retry, 0);
+            do_unix64_sync_relay_flush(&retry);
+        }
+
+    } while (1);
 
-    /* Do again. */
-    return (1);
+    return (NULL);
 }
 
+/*============================================================================*
+ * do_unix64_sync_wait()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Waits for a round of a sync to complete.
+ *
+ * @param rx       Target sync.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, zero is returned. If the
+ * deadline expires, -ETIMEDOUT is returned instead. If the
+ * demultiplexer failed, its error code is returned.
+ */
+PRIVATE int do_unix64_sync_wait(struct rx *rx,
+                                const struct unix64_deadline *deadline)
+{
+    int ret;          /* Return value.  */
+    uint32_t counter; /* Event counter. */
+
+    do {
+        /* Snapshot the event before checking, to not miss a wakeup. */
+        counter = unix64_event_counter(&rx->event);
+
+        /* Did the demultiplexer complete a round? */
+        if (unix64_sync_barrier_consume(rx))
+            return (0);
+
+        /* Did the demultiplexer fail? */
+        if ((ret = unix64_sync_demux_error()) < 0)
+            return (ret);
+
+    } while (unix64_event_wait(&rx->event, counter, deadline) == 0);
+
+    return (-ETIMEDOUT);
+}
+
+/*============================================================================*
+ * do_unix64_sync_wait_shared()                                               *
+ *============================================================================*/
+
+#if (__UNIX64_SYNC_USES_SHM)
+
+/**
+ * @brief Waits on the shared barrier of a sync.
+ *
+ * @param rx       Target sync.
+ * @param deadline Deadline for waiting.
+ *
+ * @returns Upon successful completion, zero is returned. If the
+ * deadline expires, -ETIMEDOUT is returned instead.
+ *
+ * @note Unlike message queues, the shared barrier has a completion
+ * counter per waiting node, thus there is nothing to demultiplex and
+ * waits on distinct syncs do not serialize.
+ */
+PRIVATE int do_unix64_sync_wait_shared(struct rx *rx,
+                                       const struct unix64_deadline *deadline)
+{
+    return (unix64_barrier_wait(rx->shared, rx->hash.source, deadline));
+}
+
+#endif /* __UNIX64_SYNC_USES_SHM */
+
 /*============================================================================*
  * unix64_sync_wait()                                                         *
  *============================================================================*/
 
 /**
- * @todo TODO: provide a detailed description for this function.
+ * @brief Spin wait counters of unix64_sync_wait().
+ */
+PRIVATE struct spinwait_stats sync_wait_stats =
+    SPINWAIT_STATS_INITIALIZER("unix64_sync_wait");
+
+/**
+ * The unix64_sync_wait() function waits for a round of the sync @p
+ * syncid to complete, consuming a buffered round if there is one. The
+ * wait gives up when the timeout of the sync expires, which never
+ * happens unless it is set with #UNIX64_SYNC_IOCTL_SET_TIMEOUT.
  *
  * @note This function is blocking.
  * @note This function is thread-safe.
@@ -601,23 +1782,30 @@ release:
  */
 PUBLIC int unix64_sync_wait(int syncid)
 {
-    int ret;
+    int ret;                         /* Return value. */
+    struct unix64_deadline deadline; /* Deadline.     */
+    uint32_t counter;                /* Event counter. */
+    struct spinwait waiter;          /* Spin waiter.   */
 
     ret = (0);
     syncid -= UNIX64_SYNC_CREATE_OFFSET;
 
+    spinwait_init(&waiter, &sync_wait_stats);
+
 again:
-    unix64_sync_lock();
+    unix64_sync_endpoint_lock(&synctab.rxs[syncid].lock);
 
     /* Bad sync. */
     if (!resource_is_used(&synctab.rxs[syncid].resource)) {
-        unix64_sync_unlock();
+        unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
         return (-EBADF);
     }
 
     /* Busy sync. */
     if (resource_is_busy(&synctab.rxs[syncid].resource)) {
-        unix64_sync_unlock();
+        counter = unix64_event_counter(&synctab.rxs[syncid].idle);
+        unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
+        unix64_event_spinwait(&synctab.rxs[syncid].idle, counter, &waiter);
         goto again;
     }
 
@@ -629,20 +1817,26 @@ again:
     /* Set sync as busy. */
     resource_set_busy(&synctab.rxs[syncid].resource);
 
+    unix64_deadline_set(&deadline, synctab.rxs[syncid].timeout);
+
     /*
      * Release lock, since we may sleep below.
      */
-    unix64_sync_unlock();
+    unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
 
-    while ((ret = do_unix64_sync_wait(&synctab.rxs[syncid])) > 0)
-        ;
+#if (__UNIX64_SYNC_USES_SHM)
+    ret = do_unix64_sync_wait_shared(&synctab.rxs[syncid], &deadline);
+#else
+    ret = do_unix64_sync_wait(&synctab.rxs[syncid], &deadline);
+#endif
 
-    unix64_sync_lock();
-    resource_set_notbusy(&synctab.rxs[syncid].resource);
+    unix64_sync_endpoint_lock(&synctab.rxs[syncid].lock);
+    unix64_sync_set_notbusy(&synctab.rxs[syncid].resource,
+                            &synctab.rxs[syncid].idle);
 exit:
-    unix64_sync_unlock();
+    unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
 
-    return ((ret != 0) ? (-EAGAIN) : (0));
+    return (ret);
 }
 
 /*============================================================================*
@@ -650,60 +1844,10 @@ exit:
  *============================================================================*/
 
 /**
- * @brief Broadcasts a signal.
- *
- * @param i      Initial node ID.
- * @param nnodes Number of nodes.
- * @param nodes  Node IDs.
- * @param hash   Message.
- *
- * @returns Upon successful completion, zero is returned. Upon
- * failure, a negative error code is returned instead.
+ * @brief Spin wait counters of unix64_sync_signal().
  */
-PRIVATE inline int do_unix64_sync_signal(int i, int nnodes, const int *nodes,
-                                         int *sent, const struct hash *hash)
-{
-    int ret;        /* Return value.    */
-    int ntries = 5; /* Number of tries. */
-
-    for (; i < nnodes; ++i) {
-        if (sent[i])
-            continue;
-
-        do {
-            struct timespec tm;
-
-            if (ntries-- == 0) {
-                ret = (-ETIMEDOUT);
-                goto error;
-            }
-
-            clock_gettime(CLOCK_REALTIME, &tm);
-            tm.tv_sec += 1;
-
-            if (mq_timedsend(mqueues[nodes[i]].fd,
-                             (char *)hash,
-                             sizeof(struct hash),
-                             1,
-                             &tm) == -1) {
-                if (errno == EAGAIN)
-                    continue;
-
-                ret = (-EAGAIN);
-                goto error;
-            }
-
-            sent[i] = 1;
-            break;
-
-        } while (1);
-    }
-
-    ret = 0;
-
-error:
-    return (ret);
-}
+PRIVATE struct spinwait_stats sync_signal_stats =
+    SPINWAIT_STATS_INITIALIZER("unix64_sync_signal");
 
 /**
  * @todo TODO: provide a detailed description for this function.
@@ -714,66 +1858,310 @@ error:
  */
 PUBLIC int unix64_sync_signal(int syncid)
 {
-    int ret; /* Return value. */
+    int ret;                         /* Return value. */
+    struct unix64_deadline deadline; /* Deadline.     */
+    uint32_t counter;                /* Event counter. */
+    struct spinwait waiter;          /* Spin waiter.   */
 
     syncid -= UNIX64_SYNC_OPEN_OFFSET;
 
+    spinwait_init(&waiter, &sync_signal_stats);
+
 again:
-    unix64_sync_lock();
+    unix64_sync_endpoint_lock(&synctab.txs[syncid].lock);
 
     /* Bad sync. */
     if (!resource_is_used(&synctab.txs[syncid].resource)) {
-        unix64_sync_unlock();
+        unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
         return (-EBADF);
     }
 
     /* Busy sync. */
     if (resource_is_busy(&synctab.txs[syncid].resource)) {
-        unix64_sync_unlock();
+        counter = unix64_event_counter(&synctab.txs[syncid].idle);
+        unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
+        unix64_event_spinwait(&synctab.txs[syncid].idle, counter, &waiter);
         goto again;
     }
 
+    /* Split-phase arrival in progress. */
+    if (synctab.txs[syncid].pending) {
+        unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
+        return (-EBUSY);
+    }
+
     /* Set sync as busy. */
     resource_set_busy(&synctab.txs[syncid].resource);
 
+    unix64_deadline_set(&deadline, synctab.txs[syncid].timeout);
+
     /*
      * Release lock, since we may sleep below.
      */
-    unix64_sync_unlock();
+    unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
 
-    /* Broadcast. */
-    if (synctab.txs[syncid].hash.type == UNIX64_SYNC_ONE_TO_ALL) {
-        ret = do_unix64_sync_signal(1,
-                                    synctab.txs[syncid].nnodes,
-                                    synctab.txs[syncid].nodes,
-                                    synctab.txs[syncid].sent,
-                                    &synctab.txs[syncid].hash);
-
-        if (ret == 0) {
-            for (int i = 1; i < synctab.txs[syncid].nnodes; ++i)
-                synctab.txs[syncid].sent[i] = 0;
-        }
+    ret = do_unix64_sync_arrival(&synctab.txs[syncid], &deadline);
+
+    unix64_sync_endpoint_lock(&synctab.txs[syncid].lock);
+    unix64_sync_set_notbusy(&synctab.txs[syncid].resource,
+                            &synctab.txs[syncid].idle);
+    unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
+
+    /* Deadline expired. */
+    if (ret == (-ETIMEDOUT))
+        return (ret);
+
+    return ((ret != 0) ? (-EAGAIN) : (0));
+}
+
+/*============================================================================*
+ * unix64_sync_arrive()                                                       *
+ *============================================================================*/
+
+/**
+ * The unix64_sync_arrive() function announces the arrival of the local
+ * node at the sync @p syncid, without blocking. The arrival is
+ * delivered right away if possible, and otherwise it is kept pending
+ * until unix64_sync_test() or unix64_sync_await() are called. In a
+ * gather, the demultiplexer also pushes it up as soon as the children
+ * of the local node arrive.
+ *
+ * @note This function is non-blocking.
+ * @note This function is thread-safe.
+ */
+PUBLIC int unix64_sync_arrive(int syncid)
+{
+    struct unix64_deadline now; /* Deadline. */
+
+    syncid -= UNIX64_SYNC_OPEN_OFFSET;
+
+    unix64_sync_endpoint_lock(&synctab.txs[syncid].lock);
+
+    /* Bad sync. */
+    if (!resource_is_used(&synctab.txs[syncid].resource)) {
+        unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
+        return (-EBADF);
     }
 
-    /* Gather. */
-    else {
-        ret = do_unix64_sync_signal(0,
-                                    1,
-                                    synctab.txs[syncid].nodes,
-                                    synctab.txs[syncid].sent,
-                                    &synctab.txs[syncid].hash);
+    /* One arrival at a time. */
+    if (synctab.txs[syncid].pending) {
+        unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
+        return (-EBUSY);
+    }
+
+    synctab.txs[syncid].pending = 1;
+
+    unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
+
+    /* Try to deliver it. */
+    unix64_deadline_set(&now, 0);
+    do_unix64_sync_progress(&synctab.txs[syncid], &now);
+
+    return (0);
+}
+
+/*============================================================================*
+ * unix64_sync_test()                                                         *
+ *============================================================================*/
+
+/**
+ * The unix64_sync_test() function checks, without blocking, the
+ * split-phase state of the sync @p syncid. On the receiving side, a
+ * completed round is consumed if there is any. On the sending side,
+ * progress is made on the pending arrival.
+ *
+ * @note This function is non-blocking.
+ * @note This function is thread-safe.
+ */
+PUBLIC int unix64_sync_test(int syncid)
+{
+    int ret;                    /* Return value. */
+    struct unix64_deadline now; /* Deadline.     */
+
+    unix64_deadline_set(&now, 0);
+
+    /* Sender. */
+    if (syncid >= UNIX64_SYNC_OPEN_OFFSET) {
+        syncid -= UNIX64_SYNC_OPEN_OFFSET;
+
+        /* Bad sync. */
+        if (!resource_is_used(&synctab.txs[syncid].resource))
+            return (-EBADF);
+
+        ret = do_unix64_sync_progress(&synctab.txs[syncid], &now);
 
         if (ret == 0)
-            synctab.txs[syncid].sent[0] = 0;
+            return (1);
+
+        return (((ret == (-ETIMEDOUT)) || (ret == (-EBUSY))) ? 0 : ret);
     }
 
-    unix64_sync_lock();
-    resource_set_notbusy(&synctab.txs[syncid].resource);
-    unix64_sync_unlock();
+    syncid -= UNIX64_SYNC_CREATE_OFFSET;
+
+    unix64_sync_endpoint_lock(&synctab.rxs[syncid].lock);
+
+    /* Bad sync. */
+    if (!resource_is_used(&synctab.rxs[syncid].resource)) {
+        unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
+        return (-EBADF);
+    }
+
+    /* Someone else is waiting. */
+    if (resource_is_busy(&synctab.rxs[syncid].resource)) {
+        unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
+        return (0);
+    }
+
+#if (__UNIX64_SYNC_USES_SHM)
+    resource_set_busy(&synctab.rxs[syncid].resource);
+    unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
+
+    ret = (unix64_barrier_wait(synctab.rxs[syncid].shared,
+                               synctab.rxs[syncid].hash.source,
+                               &now) == 0);
+
+    unix64_sync_endpoint_lock(&synctab.rxs[syncid].lock);
+    unix64_sync_set_notbusy(&synctab.rxs[syncid].resource,
+                            &synctab.rxs[syncid].idle);
+#else
+    ret = (synctab.rxs[syncid].nbarriers > 0);
+
+    if (ret)
+        synctab.rxs[syncid].nbarriers--;
+#endif
+
+    unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
+
+    return (ret);
+}
+
+/*============================================================================*
+ * unix64_sync_await()                                                        *
+ *============================================================================*/
+
+/**
+ * The unix64_sync_await() function blocks until the split-phase
+ * operation on the sync @p syncid completes. On the receiving side,
+ * it waits for a round just like unix64_sync_wait() does. On the
+ * sending side, it waits for the pending arrival to be delivered,
+ * giving up when the timeout of the sync expires.
+ *
+ * @note This function is blocking.
+ * @note This function is thread-safe.
+ */
+PUBLIC int unix64_sync_await(int syncid)
+{
+    int ret;                         /* Return value. */
+    struct tx *tx;                   /* Sender sync.  */
+    struct unix64_deadline deadline; /* Deadline.     */
+
+    /* Receiver. */
+    if (syncid < UNIX64_SYNC_OPEN_OFFSET)
+        return (unix64_sync_wait(syncid));
+
+    tx = &synctab.txs[syncid - UNIX64_SYNC_OPEN_OFFSET];
+
+    unix64_sync_endpoint_lock(&tx->lock);
+
+    /* Bad sync. */
+    if (!resource_is_used(&tx->resource)) {
+        unix64_sync_endpoint_unlock(&tx->lock);
+        return (-EBADF);
+    }
+
+    unix64_deadline_set(&deadline, tx->timeout);
+
+    unix64_sync_endpoint_unlock(&tx->lock);
+
+    /* Someone else may be making progress, so try again. */
+    while ((ret = do_unix64_sync_progress(tx, &deadline)) == (-EBUSY)) {
+        if (unix64_deadline_expired(&deadline))
+            return (-ETIMEDOUT);
+    }
+
+    /* Deadline expired. */
+    if (ret == (-ETIMEDOUT))
+        return (ret);
 
     return ((ret != 0) ? (-EAGAIN) : (0));
 }
 
+/*============================================================================*
+ * unix64_sync_poll()                                                         *
+ *============================================================================*/
+
+/**
+ * The unix64_sync_poll() function checks the receiving sync @p syncid
+ * for a completed round, if @p events has UNIX64_IKC_POLLIN set, and
+ * the sending sync @p syncid for no pending arrival, if @p events has
+ * UNIX64_IKC_POLLOUT set. No round is consumed, and busy syncs are
+ * never ready, since their owners are about to use them.
+ *
+ * @note This function is thread-safe.
+ */
+PUBLIC int unix64_sync_poll(int syncid, unsigned events)
+{
+    int revents = 0;
+    struct rx *rx;
+    struct tx *tx;
+
+    if (events & UNIX64_IKC_POLLIN) {
+        /* Bad sync. */
+        if (!WITHIN(syncid,
+                    UNIX64_SYNC_CREATE_OFFSET,
+                    UNIX64_SYNC_CREATE_OFFSET + UNIX64_SYNC_CREATE_MAX))
+            return (-EBADF);
+
+        rx = &synctab.rxs[syncid - UNIX64_SYNC_CREATE_OFFSET];
+
+        unix64_sync_endpoint_lock(&rx->lock);
+
+        /* Bad sync. */
+        if (!resource_is_used(&rx->resource)) {
+            unix64_sync_endpoint_unlock(&rx->lock);
+            return (-EBADF);
+        }
+
+        if (!resource_is_busy(&rx->resource)) {
+#if (__UNIX64_SYNC_USES_SHM)
+            if ((rx->nbarriers > 0) ||
+                unix64_barrier_is_complete(rx->shared, rx->hash.source))
+                revents |= UNIX64_IKC_POLLIN;
+#else
+            if (rx->nbarriers > 0)
+                revents |= UNIX64_IKC_POLLIN;
+#endif
+        }
+
+        unix64_sync_endpoint_unlock(&rx->lock);
+    }
+
+    if (events & UNIX64_IKC_POLLOUT) {
+        /* Bad sync. */
+        if (!WITHIN(syncid,
+                    UNIX64_SYNC_OPEN_OFFSET,
+                    UNIX64_SYNC_OPEN_OFFSET + UNIX64_SYNC_OPEN_MAX))
+            return (-EBADF);
+
+        tx = &synctab.txs[syncid - UNIX64_SYNC_OPEN_OFFSET];
+
+        unix64_sync_endpoint_lock(&tx->lock);
+
+        /* Bad sync. */
+        if (!resource_is_used(&tx->resource)) {
+            unix64_sync_endpoint_unlock(&tx->lock);
+            return (-EBADF);
+        }
+
+        if (!resource_is_busy(&tx->resource) && !tx->pending)
+            revents |= UNIX64_IKC_POLLOUT;
+
+        unix64_sync_endpoint_unlock(&tx->lock);
+    }
+
+    return (revents);
+}
+
 /*============================================================================*
  * unix64_sync_ioctl()                                                        *
  *============================================================================*/
@@ -792,11 +2180,6 @@ PUBLIC int unix64_sync_ioctl(int syncid, unsigned request, va_list args)
 {
     int ret = (-EINVAL); /* Return value. */
 
-    UNUSED(syncid);
-    UNUSED(args);
-
-    unix64_sync_lock();
-
     switch (request) {
     case UNIX64_SYNC_IOCTL_SET_ASYNC_BEHAVIOR: {
         /**
@@ -806,15 +2189,102 @@ PUBLIC int unix64_sync_ioctl(int syncid, unsigned request, va_list args)
         ret = (0);
     } break;
 
+    case UNIX64_SYNC_IOCTL_SET_TIMEOUT: {
+        int timeout = va_arg(args, int);
+
+        /* Bad timeout. */
+        if (timeout < UNIX64_SYNC_TIMEOUT_INFINITE)
+            break;
+
+        /* Receiver. */
+        if (syncid < UNIX64_SYNC_OPEN_OFFSET) {
+            syncid -= UNIX64_SYNC_CREATE_OFFSET;
+
+            unix64_sync_endpoint_lock(&synctab.rxs[syncid].lock);
+
+            /* Bad sync. */
+            if (!resource_is_used(&synctab.rxs[syncid].resource)) {
+                unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
+                ret = (-EBADF);
+                break;
+            }
+
+            synctab.rxs[syncid].timeout = timeout;
+
+            unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
+        }
+
+        /* Sender. */
+        else {
+            syncid -= UNIX64_SYNC_OPEN_OFFSET;
+
+            unix64_sync_endpoint_lock(&synctab.txs[syncid].lock);
+
+            /* Bad sync. */
+            if (!resource_is_used(&synctab.txs[syncid].resource)) {
+                unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
+                ret = (-EBADF);
+                break;
+            }
+
+            synctab.txs[syncid].timeout = timeout;
+
+            unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
+        }
+
+        ret = (0);
+    } break;
+
+    case UNIX64_SYNC_IOCTL_SET_ALGORITHM: {
+        int algorithm = va_arg(args, int);
+
+        /* Bad algorithm. */
+        if (!WITHIN(algorithm, 0, UNIX64_SYNC_ALGORITHM_MAX))
+            break;
+
+        /* Receiver. */
+        if (syncid < UNIX64_SYNC_OPEN_OFFSET) {
+            syncid -= UNIX64_SYNC_CREATE_OFFSET;
+
+            unix64_sync_endpoint_lock(&synctab.rxs[syncid].lock);
+
+            /* Bad sync. */
+            if (!resource_is_used(&synctab.rxs[syncid].resource)) {
+                unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
+                ret = (-EBADF);
+                break;
+            }
+
+            synctab.rxs[syncid].algorithm = algorithm;
+
+            unix64_sync_endpoint_unlock(&synctab.rxs[syncid].lock);
+        }
+
+        /* Sender. */
+        else {
+            syncid -= UNIX64_SYNC_OPEN_OFFSET;
+
+            unix64_sync_endpoint_lock(&synctab.txs[syncid].lock);
+
+            /* Bad sync. */
+            if (!resource_is_used(&synctab.txs[syncid].resource)) {
+                unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
+                ret = (-EBADF);
+                break;
+            }
+
+            synctab.txs[syncid].algorithm = algorithm;
+
+            unix64_sync_endpoint_unlock(&synctab.txs[syncid].lock);
+        }
+
+        ret = (0);
+    } break;
+
     default:
         break;
     }
 
-    /*
-     * Release lock, since we may sleep below.
-     */
-    unix64_sync_unlock();
-
     return (ret);
 }
 
@@ -831,14 +2301,18 @@ PUBLIC void unix64_sync_setup(void)
 
     local = processor_node_get_num();
 
+#if (__UNIX64_SYNC_USES_SHM)
+    UNUSED(local);
+
+    /* Map shared barriers. */
+    KASSERT((barriers = unix64_barrier_map("/" UNIX64_SYNC_BASENAME)) != NULL);
+#else
     /* Build pathname for NoC connector. */
     sprintf(mqueues[local].pathname, "/%s-%d", UNIX64_SYNC_BASENAME, local);
 
     /* Open NoC connector. */
-    KASSERT((mqueues[local].fd = mq_open(mqueues[local].pathname,
-                                         (O_RDONLY | O_CREAT),
-                                         (S_IRUSR | S_IWUSR),
-                                         &mq_attr)) != -1);
+    KASSERT(unix64_transport_get()->connect(
+                &mqueues[local].conn, mqueues[local].pathname, O_RDWR) == 0);
 
     for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; ++i) {
         if (i == local)
@@ -847,11 +2321,17 @@ PUBLIC void unix64_sync_setup(void)
         sprintf(mqueues[i].pathname, "/%s-%d", UNIX64_SYNC_BASENAME, i);
 
         /* Open NoC connector. */
-        KASSERT((mqueues[i].fd = mq_open(mqueues[i].pathname,
-                                         (O_WRONLY | O_CREAT | O_NONBLOCK),
-                                         (S_IRUSR | S_IWUSR),
-                                         &mq_attr)) != -1);
+        KASSERT(unix64_transport_get()->connect(
+                    &mqueues[i].conn, mqueues[i].pathname, O_WRONLY) == 0);
     }
+
+    /* Start demultiplexer. */
+    demux.running = 1;
+    KASSERT(pthread_create(&demux.thread,
+                           NULL,
+                           unix64_sync_demux,
+                           (void *)(long)local) == 0);
+#endif
 }
 
 /*============================================================================*
@@ -864,18 +2344,45 @@ PUBLIC void unix64_sync_setup(void)
 PUBLIC void unix64_sync_shutdown(void)
 {
     int local;
+#if !(__UNIX64_SYNC_USES_SHM)
+    struct hash stop = HASH_INITIALIZER;
+    struct unix64_deadline deadline;
+#endif
 
     local = processor_node_get_num();
 
-    KASSERT(mq_close(mqueues[local].fd) == 0);
-    KASSERT(mq_unlink(mqueues[local].pathname) == 0);
+#if (__UNIX64_SYNC_USES_SHM)
+    UNUSED(local);
+
+    unix64_barrier_unmap(barriers);
+    barriers = NULL;
+
+    /* Unlink shared barriers. */
+    if (cluster_get_num() == PROCESSOR_CLUSTERNUM_MASTER)
+        unix64_barrier_unlink("/" UNIX64_SYNC_BASENAME);
+#else
+    /* Stop demultiplexer, unless it has already failed. */
+    __atomic_store_n(&demux.running, 0, __ATOMIC_RELEASE);
+    if (unix64_sync_demux_error() == 0) {
+        unix64_deadline_set(&deadline, -1);
+        KASSERT(unix64_transport_get()->send(&mqueues[local].conn,
+                                             UNIX64_SYNC_LANE,
+                                             &stop,
+                                             sizeof(struct hash),
+                                             &deadline) == 0);
+    }
+    KASSERT(pthread_join(demux.thread, NULL) == 0);
+
+    unix64_transport_get()->disconnect(&mqueues[local].conn);
+    KASSERT(unix64_transport_get()->unlink(mqueues[local].pathname) == 0);
 
     for (int i = 0; i < PROCESSOR_NOC_NODES_NUM; ++i) {
         if (i == local)
             continue;
 
-        KASSERT(mq_close(mqueues[i].fd) == 0);
+        unix64_transport_get()->disconnect(&mqueues[i].conn);
     }
+#endif
 }
 
 #endif /* !__NANVIX_IKC_USES_ONLY_MAILBOX */
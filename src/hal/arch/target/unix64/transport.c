@@ -0,0 +1,438 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Must come first. */
+#define __NEED_HAL_PROCESSOR
+
+#include <arch/target/unix64/unix64/loopback.h>
+#include <arch/target/unix64/unix64/mailbox.h>
+#include <arch/target/unix64/unix64/ring.h>
+#include <arch/target/unix64/unix64/transport.h>
+#include <fcntl.h>
+#include <mqueue.h>
+#include <nanvix/const.h>
+#include <nanvix/hal/processor.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+#include <sys/stat.h>
+#include <time.h>
+
+/*============================================================================*
+ * Message Queue Transport                                                    *
+ *============================================================================*/
+
+/**
+ * @brief Messages per lane of a message queue.
+ *
+ * Lanes share the message queue, thus each one gets an even part of
+ * it. Senders are granted credits per lane, so the message queue is
+ * never full while they hold a credit.
+ */
+#define UNIX64_MQUEUE_DEPTH                                                    \
+    (((PROCESSOR_NOC_NODES_NUM) / (UNIX64_MAILBOX_PRIORITY_NUM)) > 0           \
+         ? ((PROCESSOR_NOC_NODES_NUM) / (UNIX64_MAILBOX_PRIORITY_NUM))         \
+         : 1)
+
+/**
+ * @brief Default message queue attribute.
+ */
+PRIVATE struct mq_attr mq_attr = {
+    .mq_maxmsg = UNIX64_MQUEUE_DEPTH * UNIX64_MAILBOX_PRIORITY_NUM,
+    .mq_msgsize = UNIX64_MAILBOX_MSG_SIZE_MAX,
+};
+
+/**
+ * @brief Opens a message queue.
+ */
+PRIVATE int unix64_mqueue_connect(union unix64_connector *conn,
+                                  const char *name, int flags)
+{
+    return (((conn->fd = mq_open(
+                  name, flags | O_CREAT, S_IRUSR | S_IWUSR, &mq_attr)) == -1)
+                ? -1
+                : 0);
+}
+
+/**
+ * @brief Closes a message queue.
+ */
+PRIVATE void unix64_mqueue_disconnect(union unix64_connector *conn)
+{
+    KASSERT(mq_close(conn->fd) == 0);
+}
+
+/**
+ * @brief Removes a message queue from the system.
+ */
+PRIVATE int unix64_mqueue_unlink(const char *name)
+{
+    return ((mq_unlink(name) == -1) ? -EAGAIN : 0);
+}
+
+/**
+ * @brief Sends a message through a message queue.
+ *
+ * The lane of the message is its priority in the message queue.
+ */
+PRIVATE int unix64_mqueue_send(union unix64_connector *conn, int lane,
+                               const void *buf, size_t n,
+                               const struct unix64_deadline *deadline)
+{
+    struct timespec tm;
+
+    do {
+        unix64_deadline_slice(deadline, &tm);
+
+        if (mq_timedsend(conn->fd, buf, n, lane, &tm) == 0)
+            return (0);
+
+        if ((errno != ETIMEDOUT) && (errno != EINTR))
+            return (-EAGAIN);
+
+    } while (!unix64_deadline_expired(deadline));
+
+    return (-ETIMEDOUT);
+}
+
+/**
+ * @brief Receives a message from a message queue.
+ */
+PRIVATE ssize_t unix64_mqueue_recv(union unix64_connector *conn, void *buf,
+                                   size_t n, int *lane,
+                                   const struct unix64_deadline *deadline)
+{
+    ssize_t nread;
+    unsigned prio;
+    struct timespec tm;
+
+    do {
+        unix64_deadline_slice(deadline, &tm);
+
+        if ((nread = mq_timedreceive(conn->fd, buf, n, &prio, &tm)) != -1) {
+            *lane = prio;
+            return (nread);
+        }
+
+        if ((errno != ETIMEDOUT) && (errno != EINTR))
+            return (-EAGAIN);
+
+    } while (!unix64_deadline_expired(deadline));
+
+    return (-ETIMEDOUT);
+}
+
+/**
+ * @brief Asserts whether or not a message queue has a message to read.
+ */
+PRIVATE int unix64_mqueue_is_readable(union unix64_connector *conn)
+{
+    struct mq_attr attr;
+
+    return ((mq_getattr(conn->fd, &attr) == 0) && (attr.mq_curmsgs > 0));
+}
+
+/**
+ * @brief Asserts whether or not a message queue has room for a message.
+ */
+PRIVATE int unix64_mqueue_is_writable(union unix64_connector *conn, int lane)
+{
+    struct mq_attr attr;
+
+    UNUSED(lane);
+
+    return ((mq_getattr(conn->fd, &attr) == 0) &&
+            (attr.mq_curmsgs < attr.mq_maxmsg));
+}
+
+/**
+ * @brief Counts the messages that fit in a message queue.
+ *
+ * Lanes share the message queue.
+ */
+PRIVATE int unix64_mqueue_room(union unix64_connector *conn)
+{
+    struct mq_attr attr;
+
+    if (mq_getattr(conn->fd, &attr) != 0)
+        return (mq_attr.mq_maxmsg);
+
+    return (attr.mq_maxmsg - attr.mq_curmsgs);
+}
+
+/**
+ * @brief Message queue transport.
+ */
+PRIVATE const struct unix64_transport unix64_transport_mqueue = {
+    .name = "mqueue",
+    .flags = 0,
+    .depth = UNIX64_MQUEUE_DEPTH,
+    .connect = unix64_mqueue_connect,
+    .disconnect = unix64_mqueue_disconnect,
+    .unlink = unix64_mqueue_unlink,
+    .send = unix64_mqueue_send,
+    .recv = unix64_mqueue_recv,
+    .reserve = NULL,
+    .commit = NULL,
+    .peek = NULL,
+    .release = NULL,
+    .is_readable = unix64_mqueue_is_readable,
+    .is_writable = unix64_mqueue_is_writable,
+    .room = unix64_mqueue_room,
+};
+
+/*============================================================================*
+ * Ring Transports                                                            *
+ *============================================================================*/
+
+/**
+ * @brief Maps a shared-memory ring.
+ */
+PRIVATE int unix64_shmring_connect(union unix64_connector *conn,
+                                   const char *name, int flags)
+{
+    UNUSED(flags);
+
+    return (((conn->ring = unix64_ring_map(name)) == NULL) ? -1 : 0);
+}
+
+/**
+ * @brief Unmaps a shared-memory ring.
+ */
+PRIVATE void unix64_shmring_disconnect(union unix64_connector *conn)
+{
+    unix64_ring_unmap(conn->ring);
+}
+
+/**
+ * @brief Maps a loopback ring.
+ */
+PRIVATE int unix64_loopback_connect(union unix64_connector *conn,
+                                    const char *name, int flags)
+{
+    UNUSED(flags);
+
+    return (((conn->ring = unix64_loopback_map(
+                  name, sizeof(struct unix64_ring))) == NULL)
+                ? -1
+                : 0);
+}
+
+/**
+ * @brief Unmaps a loopback ring.
+ */
+PRIVATE void unix64_loopback_disconnect(union unix64_connector *conn)
+{
+    unix64_loopback_unmap(conn->ring);
+}
+
+/**
+ * @see unix64_ring_send().
+ */
+PRIVATE int unix64_ringconn_send(union unix64_connector *conn, int lane,
+                                 const void *buf, size_t n,
+                                 const struct unix64_deadline *deadline)
+{
+    return (unix64_ring_send(conn->ring, lane, buf, n, deadline));
+}
+
+/**
+ * @see unix64_ring_recv().
+ */
+PRIVATE ssize_t unix64_ringconn_recv(union unix64_connector *conn, void *buf,
+                                     size_t n, int *lane,
+                                     const struct unix64_deadline *deadline)
+{
+    return (unix64_ring_recv(conn->ring, buf, n, lane, deadline));
+}
+
+/**
+ * @see unix64_ring_reserve().
+ */
+PRIVATE void *unix64_ringconn_reserve(union unix64_connector *conn, int lane,
+                                      uint64_t *pos,
+                                      const struct unix64_deadline *deadline)
+{
+    return (unix64_ring_reserve(conn->ring, lane, pos, deadline));
+}
+
+/**
+ * @see unix64_ring_commit().
+ */
+PRIVATE void unix64_ringconn_commit(union unix64_connector *conn, int lane,
+                                    uint64_t pos, size_t n)
+{
+    unix64_ring_commit(conn->ring, lane, pos, n);
+}
+
+/**
+ * @see unix64_ring_peek().
+ */
+PRIVATE void *unix64_ringconn_peek(union unix64_connector *conn, size_t *n,
+                                   int *lane,
+                                   const struct unix64_deadline *deadline)
+{
+    return (unix64_ring_peek(conn->ring, n, lane, deadline));
+}
+
+/**
+ * @see unix64_ring_release().
+ */
+PRIVATE void unix64_ringconn_release(union unix64_connector *conn, int lane)
+{
+    unix64_ring_release(conn->ring, lane);
+}
+
+/**
+ * @see unix64_ring_is_readable().
+ */
+PRIVATE int unix64_ringconn_is_readable(union unix64_connector *conn)
+{
+    return (unix64_ring_is_readable(conn->ring));
+}
+
+/**
+ * @see unix64_ring_is_writable().
+ */
+PRIVATE int unix64_ringconn_is_writable(union unix64_connector *conn,
+                                        int lane)
+{
+    return (unix64_ring_is_writable(conn->ring, lane));
+}
+
+/**
+ * @brief Counts the messages that fit in a ring.
+ *
+ * Each lane has slots of its own, thus the lanes do not bound each
+ * other.
+ */
+PRIVATE int unix64_ringconn_room(union unix64_connector *conn)
+{
+    UNUSED(conn);
+
+    return (UNIX64_RING_SLOTS_NUM);
+}
+
+/**
+ * @brief Shared-memory ring transport.
+ */
+PRIVATE const struct unix64_transport unix64_transport_shmring = {
+    .name = "shm-ring",
+    .flags = UNIX64_TRANSPORT_INPLACE,
+    .depth = UNIX64_RING_SLOTS_NUM,
+    .connect = unix64_shmring_connect,
+    .disconnect = unix64_shmring_disconnect,
+    .unlink = unix64_ring_unlink,
+    .send = unix64_ringconn_send,
+    .recv = unix64_ringconn_recv,
+    .reserve = unix64_ringconn_reserve,
+    .commit = unix64_ringconn_commit,
+    .peek = unix64_ringconn_peek,
+    .release = unix64_ringconn_release,
+    .is_readable = unix64_ringconn_is_readable,
+    .is_writable = unix64_ringconn_is_writable,
+    .room = unix64_ringconn_room,
+};
+
+/**
+ * @brief In-process loopback transport.
+ *
+ * Rings live in the memory of the calling process, thus no POSIX IPC
+ * object backs them, and only NoC nodes in the same address space
+ * reach each other.
+ */
+PRIVATE const struct unix64_transport unix64_transport_loopback = {
+    .name = "loopback",
+    .flags = UNIX64_TRANSPORT_INPLACE | UNIX64_TRANSPORT_LOCAL,
+    .depth = UNIX64_RING_SLOTS_NUM,
+    .connect = unix64_loopback_connect,
+    .disconnect = unix64_loopback_disconnect,
+    .unlink = unix64_loopback_unlink,
+    .send = unix64_ringconn_send,
+    .recv = unix64_ringconn_recv,
+    .reserve = unix64_ringconn_reserve,
+    .commit = unix64_ringconn_commit,
+    .peek = unix64_ringconn_peek,
+    .release = unix64_ringconn_release,
+    .is_readable = unix64_ringconn_is_readable,
+    .is_writable = unix64_ringconn_is_writable,
+    .room = unix64_ringconn_room,
+};
+
+/*============================================================================*
+ * Transport Selection                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Available transports.
+ */
+PRIVATE const struct unix64_transport *transports[] = {
+    &unix64_transport_mqueue,
+    &unix64_transport_shmring,
+    &unix64_transport_loopback,
+    NULL,
+};
+
+/**
+ * @brief Selected transport.
+ */
+#if (__UNIX64_MAILBOX_USES_RING)
+PRIVATE const struct unix64_transport *transport = &unix64_transport_shmring;
+#else
+PRIVATE const struct unix64_transport *transport = &unix64_transport_mqueue;
+#endif
+
+/*============================================================================*
+ * unix64_transport_select()                                                  *
+ *============================================================================*/
+
+/**
+ * The unix64_transport_select() function selects the transport named
+ * @p name for all NoC connectors opened afterwards. If no transport is
+ * selected, the shared-memory ring transport is used when
+ * __UNIX64_MAILBOX_USES_RING is set, and the message queue transport
+ * is used otherwise.
+ */
+PUBLIC int unix64_transport_select(const char *name)
+{
+    for (int i = 0; transports[i] != NULL; i++) {
+        if (!kstrcmp(transports[i]->name, name)) {
+            transport = transports[i];
+            return (0);
+        }
+    }
+
+    return (-EINVAL);
+}
+
+/*============================================================================*
+ * unix64_transport_get()                                                     *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC const struct unix64_transport *unix64_transport_get(void)
+{
+    return (transport);
+}
@@ -51,11 +51,24 @@ PUBLIC void cluster_fence_release(void)
     spinlock_unlock(&fence.lock);
 }
 
+/**
+ * @brief Spin wait counters of cluster_fence_wait().
+ */
+PRIVATE struct spinwait_stats fence_stats =
+    SPINWAIT_STATS_INITIALIZER("cluster_fence_wait");
+
 /**
  * @brief Waits on the startup fence.
+ *
+ * @note There is nothing to park on, thus once spinning is over the
+ * caller keeps yielding the core until the fence is released.
  */
 PUBLIC void cluster_fence_wait(void)
 {
+    struct spinwait waiter;
+
+    spinwait_init(&waiter, &fence_stats);
+
     while (true) {
         /* TODO: Master core cannot acquire the lock in some runs. (BUG) */
         dcache_invalidate();
@@ -68,11 +81,12 @@ PUBLIC void cluster_fence_wait(void)
             break;
         }
 
-        noop();
         spinlock_unlock(&fence.lock);
 
         /* TODO: Master core cannot acquire the lock in some runs. (BUG) */
         dcache_invalidate();
+
+        spinwait_relax(&waiter);
     }
 }
 
@@ -235,17 +235,29 @@ PUBLIC void event_drop(void)
  * event_wait()                                                               *
  *============================================================================*/
 
+/**
+ * @brief Spin wait counters of event_wait().
+ */
+PRIVATE struct spinwait_stats event_wait_stats =
+    SPINWAIT_STATS_INITIALIZER("event_wait");
+
 /**
  * @todo TODO provide a detailed description for this function.
  *
+ * @note On clusters that have neither IPIs nor events, there is
+ * nothing to park on, thus once spinning is over the caller keeps
+ * yielding the core until an event is pending.
+ *
  * @author Davidson Francis
  */
 PUBLIC void event_wait(void)
 {
     int mycoreid;
     struct section_guard guard;
+    struct spinwait waiter;
 
     mycoreid = core_get_id();
+    spinwait_init(&waiter, &event_wait_stats);
 
     /* Prevent this call be preempted by any maskable interrupt. */
     section_guard_init(&guard, &event_lock, INTERRUPT_LEVEL_NONE);
@@ -262,6 +274,8 @@ PUBLIC void event_wait(void)
         cluster_ipi_wait();
 #elif (CLUSTER_HAS_EVENTS)
         __event_wait();
+#else
+        spinwait_relax(&waiter);
 #endif
     }
 
@@ -0,0 +1,171 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/const.h>
+#include <nanvix/hal/core/spinwait.h>
+#include <nanvix/hlib.h>
+
+#if (__NANVIX_HAL_SPINWAIT_STATS)
+
+/**
+ * @brief Increments a counter of the call site of a waiter.
+ *
+ * @param waiter Target waiter.
+ * @param x      Target counter.
+ */
+#define SPINWAIT_COUNT(waiter, x)                                              \
+    __atomic_add_fetch(&(waiter)->stats->x, 1, __ATOMIC_RELAXED)
+
+/**
+ * @brief Call sites that waited.
+ */
+PRIVATE struct spinwait_stats *spinwait_sites = NULL;
+
+#else
+
+#define SPINWAIT_COUNT(waiter, x)
+
+#endif /* __NANVIX_HAL_SPINWAIT_STATS */
+
+/*============================================================================*
+ * spinwait_init()                                                            *
+ *============================================================================*/
+
+/**
+ * The spinwait_init() function initializes the waiter @p waiter,
+ * whose counters are kept in @p stats. The first time @p stats is
+ * seen, it is listed for spinwait_report().
+ */
+PUBLIC void spinwait_init(struct spinwait *waiter,
+                          struct spinwait_stats *stats)
+{
+    waiter->round = 0;
+    waiter->stats = stats;
+
+#if (__NANVIX_HAL_SPINWAIT_STATS)
+    /* Already listed. */
+    if (__atomic_load_n(&stats->listed, __ATOMIC_ACQUIRE))
+        return;
+    if (__atomic_exchange_n(&stats->listed, 1, __ATOMIC_ACQ_REL))
+        return;
+
+    stats->next = __atomic_load_n(&spinwait_sites, __ATOMIC_RELAXED);
+    while (!__atomic_compare_exchange_n(&spinwait_sites,
+                                        &stats->next,
+                                        stats,
+                                        1,
+                                        __ATOMIC_RELEASE,
+                                        __ATOMIC_RELAXED))
+        /* noop */;
+#endif
+}
+
+/*============================================================================*
+ * spinwait_once()                                                            *
+ *============================================================================*/
+
+/**
+ * The spinwait_once() function spends a round of the waiter @p waiter.
+ * The first #SPINWAIT_SPINS rounds relax the core, and the next
+ * #SPINWAIT_YIELDS rounds yield it. Every round after that is left to
+ * the caller, which should park until the awaited condition may have
+ * changed.
+ */
+PUBLIC int spinwait_once(struct spinwait *waiter)
+{
+    int park = 0;
+
+    /* Spin. */
+    if (waiter->round < SPINWAIT_SPINS) {
+        spinwait_pause();
+        SPINWAIT_COUNT(waiter, spins);
+    }
+
+    /* Yield. */
+    else if (waiter->round < (SPINWAIT_SPINS + SPINWAIT_YIELDS)) {
+        spinwait_yield();
+        SPINWAIT_COUNT(waiter, yields);
+    }
+
+    /* Park. */
+    else {
+        park = 1;
+        SPINWAIT_COUNT(waiter, parks);
+    }
+
+    /* Do not wrap around to spinning. */
+    if (!park)
+        waiter->round++;
+
+    return (park);
+}
+
+/*============================================================================*
+ * spinwait_relax()                                                           *
+ *============================================================================*/
+
+/**
+ * The spinwait_relax() function spends a round of the waiter @p waiter
+ * as spinwait_once() does, except that rounds that would be left to
+ * the caller for parking yield the core instead.
+ */
+PUBLIC void spinwait_relax(struct spinwait *waiter)
+{
+    /* Spin or yield. */
+    if (waiter->round < (SPINWAIT_SPINS + SPINWAIT_YIELDS)) {
+        spinwait_once(waiter);
+        return;
+    }
+
+    /* Nothing to park on. */
+    spinwait_yield();
+    SPINWAIT_COUNT(waiter, yields);
+}
+
+/*============================================================================*
+ * spinwait_report()                                                          *
+ *============================================================================*/
+
+/**
+ * The spinwait_report() function prints the counters of every call
+ * site that was listed by spinwait_init(), if any wait happened there.
+ */
+PUBLIC void spinwait_report(void)
+{
+#if (__NANVIX_HAL_SPINWAIT_STATS)
+    struct spinwait_stats *stats;
+
+    stats = __atomic_load_n(&spinwait_sites, __ATOMIC_ACQUIRE);
+    for (; stats != NULL; stats = stats->next) {
+        if ((stats->spins + stats->yields + stats->parks) == 0)
+            continue;
+
+        kprintf("[hal][spinwait] %s: spins=%u yields=%u parks=%u",
+                stats->name,
+                stats->spins,
+                stats->yields,
+                stats->parks);
+    }
+#endif
+}
@@ -69,4 +69,7 @@ PUBLIC void hal_init(void)
 #if (__TARGET_HAS_PORTAL)
     portal_setup();
 #endif
+#if (__HAL_HAS_COALESCE)
+    coalesce_setup();
+#endif
 }
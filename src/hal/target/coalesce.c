@@ -0,0 +1,729 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/* Must come first. */
+#define __NEED_HAL_PROCESSOR
+
+#include <nanvix/hal/target/coalesce.h>
+#include <nanvix/hal/target/poll.h>
+#include <posix/errno.h>
+#include <posix/stddef.h>
+#include <posix/stdint.h>
+
+#if (__HAL_HAS_COALESCE)
+
+/**
+ * @brief Size of a batch (in bytes).
+ */
+#define COALESCE_BATCH_SIZE (COALESCE_MSGS_MAX * HAL_MAILBOX_MSG_SIZE)
+
+/**
+ * @brief Coalesced output mailbox.
+ */
+PRIVATE struct coalesce_tx {
+    int used;                         /**< Is it used?             */
+    int portalid;                     /**< Underlying portal.      */
+    int nmsgs;                        /**< Buffered messages.      */
+    int threshold;                    /**< Size threshold.         */
+    int delay;                        /**< Time threshold (in ms). */
+    uint64_t stamp;                   /**< Oldest message stamp.   */
+    spinlock_t lock;                  /**< Lock.                   */
+    char batch[COALESCE_BATCH_SIZE]; /**< Buffered messages.      */
+} coalesce_txs[COALESCE_OPEN_MAX];
+
+/**
+ * @brief Coalesced input mailbox.
+ */
+PRIVATE struct coalesce_rx {
+    int used;                         /**< Is it used?            */
+    int portalid;                     /**< Underlying portal.     */
+    int head;                         /**< Next unread message.   */
+    int nmsgs;                        /**< Messages in the batch. */
+    spinlock_t lock;                  /**< Lock.                  */
+    char batch[COALESCE_BATCH_SIZE]; /**< Last received batch.   */
+} coalesce_rxs[COALESCE_CREATE_MAX];
+
+/**
+ * @brief Lock for the tables of mailboxes.
+ */
+PRIVATE spinlock_t coalesce_lock;
+
+/*============================================================================*
+ * coalesce_rx_get()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Gets a coalesced input mailbox.
+ *
+ * @param mbxid ID of the target mailbox.
+ *
+ * @returns The target mailbox if it is valid and in use, and NULL
+ * otherwise.
+ */
+PRIVATE struct coalesce_rx *coalesce_rx_get(int mbxid)
+{
+    int i = mbxid - HAL_MAILBOX_CREATE_OFFSET;
+
+    if (!WITHIN(i, 0, COALESCE_CREATE_MAX))
+        return (NULL);
+
+    return (coalesce_rxs[i].used ? &coalesce_rxs[i] : NULL);
+}
+
+/*============================================================================*
+ * coalesce_tx_get()                                                          *
+ *============================================================================*/
+
+/**
+ * @brief Gets a coalesced output mailbox.
+ *
+ * @param mbxid ID of the target mailbox.
+ *
+ * @returns The target mailbox if it is valid and in use, and NULL
+ * otherwise.
+ */
+PRIVATE struct coalesce_tx *coalesce_tx_get(int mbxid)
+{
+    int i = mbxid - HAL_MAILBOX_OPEN_OFFSET;
+
+    if (!WITHIN(i, 0, COALESCE_OPEN_MAX))
+        return (NULL);
+
+    return (coalesce_txs[i].used ? &coalesce_txs[i] : NULL);
+}
+
+/*============================================================================*
+ * coalesce_tx_is_stale()                                                     *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether or not the buffered messages of a coalesced
+ * output mailbox hit the time threshold.
+ *
+ * @param tx Target mailbox.
+ *
+ * @returns Non-zero if the oldest buffered message is older than the
+ * time threshold, and zero otherwise.
+ */
+PRIVATE int coalesce_tx_is_stale(const struct coalesce_tx *tx)
+{
+    uint64_t age;
+
+    age = clock_read() - tx->stamp;
+
+    return (age >= ((uint64_t)tx->delay * (CLUSTER_FREQ / 1000)));
+}
+
+/*============================================================================*
+ * do_coalesce_flush()                                                        *
+ *============================================================================*/
+
+/**
+ * @brief Flushes the buffered messages of a coalesced output mailbox.
+ *
+ * @param mbxid ID of the target mailbox.
+ * @param tx    Target mailbox.
+ *
+ * @returns Upon successful completion, zero is returned. Upon
+ * failure, a negative error code is returned instead.
+ *
+ * @note A lone message is sent as a plain mailbox message. Otherwise,
+ * the batch is announced first, so that the receiver allows the
+ * portal transfer that follows on targets where writes wait for it.
+ * The announcement is a short mailbox message, so that it is told
+ * apart from plain ones by its size.
+ */
+PRIVATE int do_coalesce_flush(int mbxid, struct coalesce_tx *tx)
+{
+    ssize_t ret;
+    struct coalesce_header header;
+
+    /* Nothing to flush. */
+    if (tx->nmsgs == 0)
+        return (0);
+
+    /* Send lone message. */
+    if (tx->nmsgs == 1) {
+        if ((ret = mailbox_awrite(mbxid, tx->batch, HAL_MAILBOX_MSG_SIZE)) < 0)
+            return (ret);
+        if ((ret = mailbox_wait(mbxid)) < 0)
+            return (ret);
+
+        tx->nmsgs = 0;
+
+        return (0);
+    }
+
+    /* Announce batch. */
+    header.source = processor_node_get_num();
+    header.nmsgs = tx->nmsgs;
+    if ((ret = mailbox_awrite(
+             mbxid, &header, sizeof(struct coalesce_header))) < 0)
+        return (ret);
+    if ((ret = mailbox_wait(mbxid)) < 0)
+        return (ret);
+
+    /* Send batch. */
+    if ((ret = portal_awrite(tx->portalid,
+                             tx->batch,
+                             tx->nmsgs * HAL_MAILBOX_MSG_SIZE)) < 0)
+        return (ret);
+    if ((ret = portal_wait(tx->portalid)) < 0)
+        return (ret);
+
+    tx->nmsgs = 0;
+
+    return (0);
+}
+
+#endif /* __HAL_HAS_COALESCE */
+
+/*============================================================================*
+ * coalesce_create()                                                          *
+ *============================================================================*/
+
+/**
+ * The coalesce_create() function creates an input mailbox and an input
+ * portal in the NoC node @p local. The mailbox receives both plain
+ * messages and batch announcements, and the portal receives batches.
+ */
+PUBLIC int coalesce_create(int local)
+{
+#if (__HAL_HAS_COALESCE)
+    int mbxid;
+    int portalid;
+    struct coalesce_rx *rx;
+
+    if ((mbxid = mailbox_create(local)) < 0)
+        return (mbxid);
+
+    if ((portalid = portal_create(local)) < 0) {
+        KASSERT(mailbox_unlink(mbxid) == 0);
+        return (portalid);
+    }
+
+    KASSERT(WITHIN(mbxid,
+                   HAL_MAILBOX_CREATE_OFFSET,
+                   HAL_MAILBOX_CREATE_OFFSET + COALESCE_CREATE_MAX));
+
+    spinlock_lock(&coalesce_lock);
+    rx = &coalesce_rxs[mbxid - HAL_MAILBOX_CREATE_OFFSET];
+    rx->portalid = portalid;
+    rx->head = 0;
+    rx->nmsgs = 0;
+    rx->used = 1;
+    spinlock_unlock(&coalesce_lock);
+
+    return (mbxid);
+
+#else
+    UNUSED(local);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * coalesce_open()                                                            *
+ *============================================================================*/
+
+/**
+ * The coalesce_open() function opens an output mailbox and an output
+ * portal to the NoC node @p remote, and sets the default thresholds:
+ * a batch is flushed once it is full, or once its oldest message is
+ * COALESCE_DELAY_DEFAULT milliseconds old and the caller next writes
+ * to, reads from or polls any coalesced mailbox.
+ */
+PUBLIC int coalesce_open(int remote)
+{
+#if (__HAL_HAS_COALESCE)
+    int mbxid;
+    int portalid;
+    struct coalesce_tx *tx;
+
+    if ((mbxid = mailbox_open(remote)) < 0)
+        return (mbxid);
+
+    if ((portalid = portal_open(processor_node_get_num(), remote)) < 0) {
+        KASSERT(mailbox_close(mbxid) == 0);
+        return (portalid);
+    }
+
+    KASSERT(WITHIN(mbxid,
+                   HAL_MAILBOX_OPEN_OFFSET,
+                   HAL_MAILBOX_OPEN_OFFSET + COALESCE_OPEN_MAX));
+
+    spinlock_lock(&coalesce_lock);
+    tx = &coalesce_txs[mbxid - HAL_MAILBOX_OPEN_OFFSET];
+    tx->portalid = portalid;
+    tx->nmsgs = 0;
+    tx->threshold = COALESCE_MSGS_MAX;
+    tx->delay = COALESCE_DELAY_DEFAULT;
+    tx->used = 1;
+    spinlock_unlock(&coalesce_lock);
+
+    return (mbxid);
+
+#else
+    UNUSED(remote);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * coalesce_unlink()                                                          *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int coalesce_unlink(int mbxid)
+{
+#if (__HAL_HAS_COALESCE)
+    int ret;
+    struct coalesce_rx *rx;
+
+    spinlock_lock(&coalesce_lock);
+
+    /* Bad mailbox. */
+    if ((rx = coalesce_rx_get(mbxid)) == NULL) {
+        spinlock_unlock(&coalesce_lock);
+        return (-EBADF);
+    }
+
+    if ((ret = mailbox_unlink(mbxid)) == 0) {
+        KASSERT(portal_unlink(rx->portalid) == 0);
+        rx->used = 0;
+    }
+
+    spinlock_unlock(&coalesce_lock);
+
+    return (ret);
+
+#else
+    UNUSED(mbxid);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * coalesce_close()                                                           *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int coalesce_close(int mbxid)
+{
+#if (__HAL_HAS_COALESCE)
+    int ret;
+    struct coalesce_tx *tx;
+
+    spinlock_lock(&coalesce_lock);
+
+    /* Bad mailbox. */
+    if ((tx = coalesce_tx_get(mbxid)) == NULL) {
+        spinlock_unlock(&coalesce_lock);
+        return (-EBADF);
+    }
+
+    spinlock_lock(&tx->lock);
+
+    if ((ret = do_coalesce_flush(mbxid, tx)) == 0) {
+        if ((ret = mailbox_close(mbxid)) == 0) {
+            KASSERT(portal_close(tx->portalid) == 0);
+            tx->used = 0;
+        }
+    }
+
+    spinlock_unlock(&tx->lock);
+
+    spinlock_unlock(&coalesce_lock);
+
+    return (ret);
+
+#else
+    UNUSED(mbxid);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * coalesce_awrite()                                                          *
+ *============================================================================*/
+
+/**
+ * The coalesce_awrite() function appends the message pointed to by @p
+ * buffer to the batch of the output mailbox @p mbxid, and flushes the
+ * batch if it hits either threshold. If the flush fails, the message
+ * stays buffered and the error is reported.
+ */
+PUBLIC ssize_t coalesce_awrite(int mbxid, const void *buffer, uint64_t size)
+{
+#if (__HAL_HAS_COALESCE)
+    int ret;
+    struct coalesce_tx *tx;
+
+    /* Invalid buffer. */
+    if (buffer == NULL)
+        return (-EINVAL);
+
+    /* Invalid write size. */
+    if (size != HAL_MAILBOX_MSG_SIZE)
+        return (-EINVAL);
+
+    /* Bad mailbox. */
+    if ((tx = coalesce_tx_get(mbxid)) == NULL)
+        return (-EBADF);
+
+    spinlock_lock(&tx->lock);
+
+    /* Batch is full of messages that could not be flushed. */
+    if (tx->nmsgs == COALESCE_MSGS_MAX) {
+        if ((ret = do_coalesce_flush(mbxid, tx)) < 0) {
+            spinlock_unlock(&tx->lock);
+            return (ret);
+        }
+    }
+
+    if (tx->nmsgs == 0)
+        tx->stamp = clock_read();
+
+    kmemcpy(&tx->batch[tx->nmsgs * HAL_MAILBOX_MSG_SIZE], buffer, size);
+    tx->nmsgs++;
+
+    /* Size or time threshold hit. */
+    ret = 0;
+    if ((tx->nmsgs >= tx->threshold) || coalesce_tx_is_stale(tx))
+        ret = do_coalesce_flush(mbxid, tx);
+
+    spinlock_unlock(&tx->lock);
+
+    return ((ret < 0) ? ret : (ssize_t)size);
+
+#else
+    UNUSED(mbxid);
+    UNUSED(buffer);
+    UNUSED(size);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * coalesce_aread()                                                           *
+ *============================================================================*/
+
+/**
+ * The coalesce_aread() function reads the next message of the input
+ * mailbox @p mbxid. Messages of the last received batch are served
+ * first. Otherwise, a message is read from the underlying mailbox: a
+ * plain message is returned as is, and a batch announcement, which is
+ * told apart by its size, makes the batch be read from the underlying
+ * portal and its first message be returned. While waiting for a
+ * message, output mailboxes that hit the time threshold are flushed.
+ */
+PUBLIC ssize_t coalesce_aread(int mbxid, void *buffer, uint64_t size)
+{
+#if (__HAL_HAS_COALESCE)
+    ssize_t ret;
+    ssize_t nread;
+    uint64_t nbytes;
+    struct coalesce_rx *rx;
+    struct coalesce_header header;
+#if (__TARGET_HAS_POLL)
+    int wait;
+    struct ikc_pollfd fd;
+#endif
+
+    /* Invalid buffer. */
+    if (buffer == NULL)
+        return (-EINVAL);
+
+    /* Invalid read size. */
+    if (size != HAL_MAILBOX_MSG_SIZE)
+        return (-EINVAL);
+
+    /* Bad mailbox. */
+    if ((rx = coalesce_rx_get(mbxid)) == NULL)
+        return (-EBADF);
+
+    spinlock_lock(&rx->lock);
+
+    /* Read message from the underlying mailbox. */
+    if (rx->head == rx->nmsgs) {
+#if (__TARGET_HAS_POLL)
+        fd.type = IKC_MAILBOX;
+        fd.id = mbxid;
+        fd.events = IKC_POLLIN;
+        fd.revents = 0;
+
+        /* Flush stale batches until a message arrives. */
+        while ((wait = coalesce_sweep()) > 0) {
+            if (ikc_poll(&fd, 1, wait) != 0)
+                break;
+        }
+#else
+        coalesce_sweep();
+#endif
+
+        if ((nread = mailbox_aread(mbxid, buffer, size)) < 0) {
+            ret = nread;
+            goto error;
+        }
+        if ((ret = mailbox_wait(mbxid)) < 0)
+            goto error;
+
+        /* Plain message. */
+        if (nread == (ssize_t)size) {
+            spinlock_unlock(&rx->lock);
+            return (size);
+        }
+
+        /* Not a batch announcement. */
+        if (nread != sizeof(struct coalesce_header)) {
+            ret = -EAGAIN;
+            goto error;
+        }
+
+        kmemcpy(&header, buffer, sizeof(struct coalesce_header));
+
+        /* Bad batch announcement. */
+        if (!WITHIN(header.nmsgs, 2, COALESCE_MSGS_MAX + 1) ||
+            !node_is_valid(header.source)) {
+            ret = -EAGAIN;
+            goto error;
+        }
+
+        /* Read batch from the underlying portal. */
+        nbytes = header.nmsgs * HAL_MAILBOX_MSG_SIZE;
+        if ((ret = portal_allow(rx->portalid, header.source)) < 0)
+            goto error;
+        if ((ret = portal_aread(rx->portalid, rx->batch, nbytes)) < 0)
+            goto error;
+        if ((ret = portal_wait(rx->portalid)) < 0)
+            goto error;
+
+        rx->head = 0;
+        rx->nmsgs = header.nmsgs;
+    }
+
+    kmemcpy(buffer, &rx->batch[rx->head * HAL_MAILBOX_MSG_SIZE], size);
+    rx->head++;
+
+    spinlock_unlock(&rx->lock);
+
+    return (size);
+
+error:
+    spinlock_unlock(&rx->lock);
+    return (ret);
+
+#else
+    UNUSED(mbxid);
+    UNUSED(buffer);
+    UNUSED(size);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * coalesce_flush()                                                           *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int coalesce_flush(int mbxid)
+{
+#if (__HAL_HAS_COALESCE)
+    int ret;
+    struct coalesce_tx *tx;
+
+    /* Bad mailbox. */
+    if ((tx = coalesce_tx_get(mbxid)) == NULL)
+        return (-EBADF);
+
+    spinlock_lock(&tx->lock);
+    ret = do_coalesce_flush(mbxid, tx);
+    spinlock_unlock(&tx->lock);
+
+    return (ret);
+
+#else
+    UNUSED(mbxid);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * coalesce_sweep()                                                           *
+ *============================================================================*/
+
+/**
+ * The coalesce_sweep() function flushes the output mailboxes whose
+ * oldest buffered message hit the time threshold. Mailboxes that are
+ * locked by a concurrent writer, or whose flush fails, are skipped,
+ * and their messages stay buffered.
+ */
+PUBLIC int coalesce_sweep(void)
+{
+#if (__HAL_HAS_COALESCE)
+    int wait;
+    int left;
+    uint64_t age;
+    uint64_t delay;
+    struct coalesce_tx *tx;
+
+    wait = 0;
+    for (int i = 0; i < COALESCE_OPEN_MAX; i++) {
+        tx = &coalesce_txs[i];
+
+        /* Busy mailbox. */
+        if (!spinlock_trylock(&tx->lock))
+            continue;
+
+        if (tx->used && (tx->nmsgs > 0)) {
+            age = clock_read() - tx->stamp;
+            delay = (uint64_t)tx->delay * (CLUSTER_FREQ / 1000);
+
+            if (age >= delay)
+                do_coalesce_flush(i + HAL_MAILBOX_OPEN_OFFSET, tx);
+
+            /* Time left until the threshold is hit (rounded up). */
+            else {
+                left = (int)((delay - age) / (CLUSTER_FREQ / 1000)) + 1;
+                if ((wait == 0) || (left < wait))
+                    wait = left;
+            }
+        }
+
+        spinlock_unlock(&tx->lock);
+    }
+
+    return (wait);
+
+#else
+    return (0);
+#endif
+}
+
+/*============================================================================*
+ * coalesce_ioctl()                                                           *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int coalesce_ioctl(int mbxid, unsigned request, ...)
+{
+#if (__HAL_HAS_COALESCE)
+    int ret;
+    int value;
+    va_list args;
+    struct coalesce_tx *tx;
+
+    /* Bad mailbox. */
+    if ((tx = coalesce_tx_get(mbxid)) == NULL)
+        return (-EBADF);
+
+    va_start(args, request);
+
+    spinlock_lock(&tx->lock);
+
+    ret = 0;
+    switch (request) {
+        case COALESCE_IOCTL_SET_THRESHOLD:
+            value = va_arg(args, int);
+            if (!WITHIN(value, 1, COALESCE_MSGS_MAX + 1))
+                ret = -EINVAL;
+            else
+                tx->threshold = value;
+            break;
+
+        case COALESCE_IOCTL_SET_DELAY:
+            value = va_arg(args, int);
+            if (value < 0)
+                ret = -EINVAL;
+            else
+                tx->delay = value;
+            break;
+
+        default:
+            ret = -EINVAL;
+            break;
+    }
+
+    /* New thresholds may have been hit already. */
+    if ((ret == 0) && (tx->nmsgs > 0)) {
+        if ((tx->nmsgs >= tx->threshold) || coalesce_tx_is_stale(tx))
+            ret = do_coalesce_flush(mbxid, tx);
+    }
+
+    spinlock_unlock(&tx->lock);
+
+    va_end(args);
+
+    return (ret);
+
+#else
+    UNUSED(mbxid);
+    UNUSED(request);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * coalesce_setup()                                                           *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC void coalesce_setup(void)
+{
+#if (__HAL_HAS_COALESCE)
+    KASSERT(sizeof(struct coalesce_header) < HAL_MAILBOX_MSG_SIZE);
+    KASSERT(COALESCE_MSGS_MAX >= 2);
+
+    spinlock_init(&coalesce_lock);
+
+    for (int i = 0; i < COALESCE_CREATE_MAX; i++) {
+        coalesce_rxs[i].used = 0;
+        spinlock_init(&coalesce_rxs[i].lock);
+    }
+
+    for (int i = 0; i < COALESCE_OPEN_MAX; i++) {
+        coalesce_txs[i].used = 0;
+        spinlock_init(&coalesce_txs[i].lock);
+    }
+#endif /* __HAL_HAS_COALESCE */
+}
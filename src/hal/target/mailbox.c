@@ -197,7 +197,7 @@ PUBLIC ssize_t mailbox_aread(int mbxid, void *buffer, uint64_t size)
         return (-EINVAL);
 
     /* Invalid read size. */
-    if (size != HAL_MAILBOX_MSG_SIZE)
+    if ((size == 0) || (size > HAL_MAILBOX_MSG_SIZE_MAX))
         return (-EINVAL);
 
     /* Invalid mailbox. */
@@ -231,7 +231,7 @@ PUBLIC ssize_t mailbox_awrite(int mbxid, const void *buffer, uint64_t size)
         return (-EINVAL);
 
     /* Invalid write size. */
-    if (size != HAL_MAILBOX_MSG_SIZE)
+    if ((size == 0) || (size > HAL_MAILBOX_MSG_SIZE_MAX))
         return (-EINVAL);
 
     /* Invalid mailbox. */
@@ -249,6 +249,180 @@ PUBLIC ssize_t mailbox_awrite(int mbxid, const void *buffer, uint64_t size)
 #endif
 }
 
+/*============================================================================*
+ * mailbox_areadv()                                                           *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int mailbox_areadv(int mbxid, void *buffer, int nmsgs)
+{
+#if (__TARGET_HAS_MAILBOX)
+
+    /* Invalid buffer. */
+    if (buffer == NULL)
+        return (-EINVAL);
+
+    /* Invalid number of messages. */
+    if (nmsgs <= 0)
+        return (-EINVAL);
+
+    /* Invalid mailbox. */
+    if (!mailbox_rx_is_valid(mbxid))
+        return (-EBADF);
+
+    return (__mailbox_areadv(mbxid, buffer, nmsgs));
+
+#else
+    UNUSED(mbxid);
+    UNUSED(buffer);
+    UNUSED(nmsgs);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * mailbox_awritev()                                                          *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int mailbox_awritev(int mbxid, const void *buffer, int nmsgs)
+{
+#if (__TARGET_HAS_MAILBOX)
+
+    /* Invalid buffer. */
+    if (buffer == NULL)
+        return (-EINVAL);
+
+    /* Invalid number of messages. */
+    if (nmsgs <= 0)
+        return (-EINVAL);
+
+    /* Invalid mailbox. */
+    if (!mailbox_tx_is_valid(mbxid))
+        return (-EBADF);
+
+    return (__mailbox_awritev(mbxid, buffer, nmsgs));
+
+#else
+    UNUSED(mbxid);
+    UNUSED(buffer);
+    UNUSED(nmsgs);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * mailbox_reserve()                                                          *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int mailbox_reserve(int mbxid, void **buffer)
+{
+#if (__TARGET_HAS_MAILBOX)
+
+    /* Invalid buffer. */
+    if (buffer == NULL)
+        return (-EINVAL);
+
+    /* Invalid mailbox. */
+    if (!mailbox_tx_is_valid(mbxid))
+        return (-EBADF);
+
+    return (__mailbox_reserve(mbxid, buffer));
+
+#else
+    UNUSED(mbxid);
+    UNUSED(buffer);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * mailbox_commit()                                                           *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int mailbox_commit(int mbxid)
+{
+#if (__TARGET_HAS_MAILBOX)
+
+    /* Invalid mailbox. */
+    if (!mailbox_tx_is_valid(mbxid))
+        return (-EBADF);
+
+    return (__mailbox_commit(mbxid));
+
+#else
+    UNUSED(mbxid);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * mailbox_peek()                                                             *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC ssize_t mailbox_peek(int mbxid, void **buffer)
+{
+#if (__TARGET_HAS_MAILBOX)
+
+    /* Invalid buffer. */
+    if (buffer == NULL)
+        return (-EINVAL);
+
+    /* Invalid mailbox. */
+    if (!mailbox_rx_is_valid(mbxid))
+        return (-EBADF);
+
+    return (__mailbox_peek(mbxid, buffer));
+
+#else
+    UNUSED(mbxid);
+    UNUSED(buffer);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * mailbox_release()                                                          *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int mailbox_release(int mbxid)
+{
+#if (__TARGET_HAS_MAILBOX)
+
+    /* Invalid mailbox. */
+    if (!mailbox_rx_is_valid(mbxid))
+        return (-EBADF);
+
+    return (__mailbox_release(mbxid));
+
+#else
+    UNUSED(mbxid);
+
+    return (-ENOSYS);
+#endif
+}
+
 /*============================================================================*
  * mailbox_wait()                                                             *
  *============================================================================*/
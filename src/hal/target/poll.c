@@ -0,0 +1,159 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <nanvix/hal/target/coalesce.h>
+#include <nanvix/hal/target/mailbox.h>
+#include <nanvix/hal/target/poll.h>
+#include <nanvix/hal/target/portal.h>
+#include <nanvix/hal/target/sync.h>
+#include <posix/errno.h>
+#include <posix/stddef.h>
+#include <posix/stdint.h>
+
+#if (__TARGET_HAS_POLL)
+
+/*============================================================================*
+ * ikc_pollfd_is_valid()                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Asserts whether or not a polled endpoint is valid.
+ *
+ * @param fd Target polled endpoint.
+ *
+ * @returns Zero if the target endpoint is valid, and a negative error
+ * code otherwise.
+ *
+ * @note This function is non-blocking.
+ * @note This function is thread-safe.
+ * @note This function is reentrant.
+ */
+PRIVATE int ikc_pollfd_is_valid(const struct ikc_pollfd *fd)
+{
+    /* Invalid events. */
+    if ((fd->events == 0) || (fd->events & ~(IKC_POLLIN | IKC_POLLOUT)))
+        return (-EINVAL);
+
+    switch (fd->type) {
+#if (__TARGET_HAS_MAILBOX)
+        case IKC_MAILBOX:
+            if ((fd->events & IKC_POLLIN) &&
+                !WITHIN(fd->id,
+                        HAL_MAILBOX_CREATE_OFFSET,
+                        HAL_MAILBOX_CREATE_OFFSET + HAL_MAILBOX_CREATE_MAX))
+                return (-EBADF);
+            if ((fd->events & IKC_POLLOUT) &&
+                !WITHIN(fd->id,
+                        HAL_MAILBOX_OPEN_OFFSET,
+                        HAL_MAILBOX_OPEN_OFFSET + HAL_MAILBOX_OPEN_MAX))
+                return (-EBADF);
+            break;
+#endif
+
+#if (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+        case IKC_PORTAL:
+            if ((fd->events & IKC_POLLIN) &&
+                !WITHIN(fd->id,
+                        HAL_PORTAL_CREATE_OFFSET,
+                        HAL_PORTAL_CREATE_OFFSET + HAL_PORTAL_CREATE_MAX))
+                return (-EBADF);
+            if ((fd->events & IKC_POLLOUT) &&
+                !WITHIN(fd->id,
+                        HAL_PORTAL_OPEN_OFFSET,
+                        HAL_PORTAL_OPEN_OFFSET + HAL_PORTAL_OPEN_MAX))
+                return (-EBADF);
+            break;
+#endif
+
+#if (__TARGET_HAS_SYNC && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+        case IKC_SYNC:
+            /* A sync is either an input or an output endpoint. */
+            if (fd->events == (IKC_POLLIN | IKC_POLLOUT))
+                return (-EINVAL);
+            if ((fd->events & IKC_POLLIN) &&
+                !WITHIN(fd->id,
+                        SYNC_CREATE_OFFSET,
+                        SYNC_CREATE_OFFSET + SYNC_CREATE_MAX))
+                return (-EBADF);
+            if ((fd->events & IKC_POLLOUT) &&
+                !WITHIN(fd->id,
+                        SYNC_OPEN_OFFSET,
+                        SYNC_OPEN_OFFSET + SYNC_OPEN_MAX))
+                return (-EBADF);
+            break;
+#endif
+
+        /* Invalid type. */
+        default:
+            return (-EINVAL);
+    }
+
+    return (0);
+}
+
+#endif /* __TARGET_HAS_POLL */
+
+/*============================================================================*
+ * ikc_poll()                                                                 *
+ *============================================================================*/
+
+/**
+ * The ikc_poll() function checks the endpoints in @p fds and, if none
+ * of them is ready, waits until one becomes ready or @p timeout
+ * milliseconds elapse. The whole set of endpoints is validated before
+ * any of them is checked. Coalesced output mailboxes that hit the
+ * time threshold are flushed first.
+ */
+PUBLIC int ikc_poll(struct ikc_pollfd *fds, int nfds, int timeout)
+{
+#if (__TARGET_HAS_POLL)
+    int ret;
+
+    /* Invalid set of endpoints. */
+    if (fds == NULL)
+        return (-EINVAL);
+
+    /* Invalid number of endpoints. */
+    if (!WITHIN(nfds, 1, IKC_POLL_MAX + 1))
+        return (-EINVAL);
+
+    /* Invalid endpoint. */
+    for (int i = 0; i < nfds; i++) {
+        if ((ret = ikc_pollfd_is_valid(&fds[i])) < 0)
+            return (ret);
+    }
+
+    /* Flush stale batches, since the caller may go idle. */
+    coalesce_sweep();
+
+    return (__ikc_poll(fds, nfds, timeout));
+
+#else
+    UNUSED(fds);
+    UNUSED(nfds);
+    UNUSED(timeout);
+
+    return (-ENOSYS);
+#endif
+}
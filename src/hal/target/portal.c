@@ -81,6 +81,80 @@ PRIVATE int portal_tx_is_valid(int portalid)
 
 #endif
 
+/*============================================================================*
+ * portal_nodelist_is_valid()                                                 *
+ *============================================================================*/
+
+#if (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+/**
+ * @brief Node list validation.
+ *
+ * @param nodes  IDs of target NoC nodes.
+ * @param nnodes Number of target NoC nodes.
+ *
+ * @return Non zero if node list is valid and zero otherwise.
+ */
+PRIVATE int portal_nodelist_is_valid(const int *nodes, int nnodes)
+{
+    uint64_t checks; /* Bit-stream of nodes. */
+
+    checks = 0ULL;
+
+    /* Is the local the one? */
+    if (!node_is_local(nodes[0]))
+        return (0);
+
+    /* Build nodelist. */
+    for (int i = 0; i < nnodes; ++i) {
+        /* Invalid node. */
+        if (!node_is_valid(nodes[i]))
+            return (0);
+
+        /* Does a node appear twice? */
+        if (checks & (1ULL << nodes[i]))
+            return (0);
+
+        checks |= (1ULL << nodes[i]);
+    }
+
+    return (1);
+}
+
+#endif
+
+/*============================================================================*
+ * portal_iov_size()                                                          *
+ *============================================================================*/
+
+#if (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+/**
+ * @brief Computes the total length of scatter-gather segments.
+ *
+ * @param iov    Target segments.
+ * @param iovcnt Number of segments.
+ *
+ * @returns The total length of the segments. If a segment is
+ * invalid, zero is returned instead.
+ */
+PRIVATE uint64_t portal_iov_size(const struct portal_iovec *iov, int iovcnt)
+{
+    uint64_t size = 0;
+
+    for (int i = 0; i < iovcnt; i++) {
+        /* Bad segment. */
+        if ((iov[i].base == NULL) && (iov[i].len != 0))
+            return (0);
+
+        size += iov[i].len;
+    }
+
+    return (size);
+}
+
+#endif
+
 /*============================================================================*
  * portal_create()                                                            *
  *============================================================================*/
@@ -146,6 +220,39 @@ PUBLIC int portal_open(int localnum, int remotenum)
 #endif
 }
 
+/*============================================================================*
+ * portal_mopen()                                                             *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int portal_mopen(const int *nodes, int nnodes)
+{
+#if (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+    /*  Invalid nodes list. */
+    if (nodes == NULL)
+        return (-EINVAL);
+
+    /* Bad nodes list. */
+    if (!WITHIN(nnodes, 2, PROCESSOR_NOC_NODES_NUM + 1))
+        return (-EINVAL);
+
+    /* Is nodelist valid? */
+    if (!portal_nodelist_is_valid(nodes, nnodes))
+        return (-EINVAL);
+
+    return (__portal_mopen(nodes, nnodes));
+
+#else
+    UNUSED(nodes);
+    UNUSED(nnodes);
+
+    return (-ENOSYS);
+#endif
+}
+
 /*============================================================================*
  * portal_allow()                                                             *
  *============================================================================*/
@@ -295,6 +402,202 @@ PUBLIC ssize_t portal_aread(int portalid, void *buffer, uint64_t size)
 #endif
 }
 
+/*============================================================================*
+ * portal_awrite_large()                                                      *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC ssize_t portal_awrite_large(int portalid, const void *buffer,
+                                   uint64_t size)
+{
+#if (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+    /* Invalid NoC node ID. */
+    if (!portal_tx_is_valid(portalid))
+        return (-EBADF);
+
+    /* Bad buffer*/
+    if (buffer == NULL)
+        return (-EINVAL);
+
+    /* Bad size. */
+    if (size == 0)
+        return (-EINVAL);
+
+    return (__portal_awrite_large(portalid, buffer, size));
+
+#else
+    UNUSED(portalid);
+    UNUSED(buffer);
+    UNUSED(size);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * portal_aread_large()                                                       *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC ssize_t portal_aread_large(int portalid, void *buffer, uint64_t size)
+{
+#if (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+    /* Invalid NoC node ID. */
+    if (!portal_rx_is_valid(portalid))
+        return (-EBADF);
+
+    /* Bad buffer*/
+    if (buffer == NULL)
+        return (-EINVAL);
+
+    /* Bad size. */
+    if (size == 0)
+        return (-EINVAL);
+
+    return (__portal_aread_large(portalid, buffer, size));
+
+#else
+    UNUSED(portalid);
+    UNUSED(buffer);
+    UNUSED(size);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * portal_awritev()                                                           *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC ssize_t portal_awritev(int portalid, const struct portal_iovec *iov,
+                              int iovcnt)
+{
+#if (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+    uint64_t size;
+
+    /* Invalid NoC node ID. */
+    if (!portal_tx_is_valid(portalid))
+        return (-EBADF);
+
+    /* Bad segments. */
+    if ((iov == NULL) || (iovcnt < 1) || (iovcnt > HAL_PORTAL_IOV_MAX))
+        return (-EINVAL);
+
+    /* Bad size. */
+    size = portal_iov_size(iov, iovcnt);
+    if (size == 0 || size > HAL_PORTAL_MAX_SIZE)
+        return (-EINVAL);
+
+    return (__portal_awritev(portalid, iov, iovcnt));
+
+#else
+    UNUSED(portalid);
+    UNUSED(iov);
+    UNUSED(iovcnt);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * portal_areadv()                                                            *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC ssize_t portal_areadv(int portalid, const struct portal_iovec *iov,
+                             int iovcnt)
+{
+#if (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+    uint64_t size;
+
+    /* Invalid NoC node ID. */
+    if (!portal_rx_is_valid(portalid))
+        return (-EBADF);
+
+    /* Bad segments. */
+    if ((iov == NULL) || (iovcnt < 1) || (iovcnt > HAL_PORTAL_IOV_MAX))
+        return (-EINVAL);
+
+    /* Bad size. */
+    size = portal_iov_size(iov, iovcnt);
+    if (size == 0 || size > HAL_PORTAL_MAX_SIZE)
+        return (-EINVAL);
+
+    return (__portal_areadv(portalid, iov, iovcnt));
+
+#else
+    UNUSED(portalid);
+    UNUSED(iov);
+    UNUSED(iovcnt);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * portal_peek()                                                              *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC ssize_t portal_peek(int portalid, void **buffer)
+{
+#if (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+    /* Invalid NoC node ID. */
+    if (!portal_rx_is_valid(portalid))
+        return (-EBADF);
+
+    /* Bad buffer*/
+    if (buffer == NULL)
+        return (-EINVAL);
+
+    return (__portal_peek(portalid, buffer));
+
+#else
+    UNUSED(portalid);
+    UNUSED(buffer);
+
+    return (-ENOSYS);
+#endif
+}
+
+/*============================================================================*
+ * portal_release()                                                           *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int portal_release(int portalid)
+{
+#if (__TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+    /* Invalid NoC node ID. */
+    if (!portal_rx_is_valid(portalid))
+        return (-EBADF);
+
+    return (__portal_release(portalid));
+
+#else
+    UNUSED(portalid);
+
+    return (-ENOSYS);
+#endif
+}
+
 /*============================================================================*
  * portal_wait()                                                              *
  *============================================================================*/
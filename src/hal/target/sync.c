@@ -343,6 +343,78 @@ PUBLIC int sync_ioctl(int syncid, unsigned request, ...)
 #endif /* __TARGET_HAS_SYNC */
 }
 
+/*============================================================================*
+ * sync_arrive()                                                              *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int sync_arrive(int syncid)
+{
+#if (__TARGET_HAS_SYNC && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+    /* Invalid sync. */
+    if (!sync_tx_is_valid(syncid))
+        return (-EBADF);
+
+    return (__sync_arrive(syncid));
+
+#else  /* __TARGET_HAS_SYNC */
+    UNUSED(syncid);
+
+    return (-ENOSYS);
+#endif /* __TARGET_HAS_SYNC */
+}
+
+/*============================================================================*
+ * sync_test()                                                                *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int sync_test(int syncid)
+{
+#if (__TARGET_HAS_SYNC && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+    /* Invalid sync. */
+    if (!sync_rx_is_valid(syncid) && !sync_tx_is_valid(syncid))
+        return (-EBADF);
+
+    return (__sync_test(syncid));
+
+#else  /* __TARGET_HAS_SYNC */
+    UNUSED(syncid);
+
+    return (-ENOSYS);
+#endif /* __TARGET_HAS_SYNC */
+}
+
+/*============================================================================*
+ * sync_await()                                                               *
+ *============================================================================*/
+
+/**
+ * @todo TODO: provide a detailed description for this function.
+ */
+PUBLIC int sync_await(int syncid)
+{
+#if (__TARGET_HAS_SYNC && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+    /* Invalid sync. */
+    if (!sync_rx_is_valid(syncid) && !sync_tx_is_valid(syncid))
+        return (-EBADF);
+
+    return (__sync_await(syncid));
+
+#else  /* __TARGET_HAS_SYNC */
+    UNUSED(syncid);
+
+    return (-ENOSYS);
+#endif /* __TARGET_HAS_SYNC */
+}
+
 /*============================================================================*
  * sync_setup()                                                               *
  *============================================================================*/
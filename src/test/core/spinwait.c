@@ -0,0 +1,130 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../test.h"
+#include <nanvix/const.h>
+#include <nanvix/hal/hal.h>
+#include <nanvix/hlib.h>
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief Counters of the test call site.
+ */
+PRIVATE struct spinwait_stats test_stats =
+    SPINWAIT_STATS_INITIALIZER("test_spinwait");
+
+/*----------------------------------------------------------------------------*
+ * Spin, Yield and Park                                                       *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Spin, Yield and Park
+ */
+PRIVATE void test_api_spinwait_policy(void)
+{
+    struct spinwait waiter;
+
+    spinwait_init(&waiter, &test_stats);
+
+    /* Spin and yield. */
+    for (int i = 0; i < (SPINWAIT_SPINS + SPINWAIT_YIELDS); i++)
+        KASSERT(spinwait_once(&waiter) == 0);
+
+    /* Park, and never go back to spinning. */
+    KASSERT(spinwait_once(&waiter) != 0);
+    KASSERT(spinwait_once(&waiter) != 0);
+}
+
+/*----------------------------------------------------------------------------*
+ * Restart a Waiter                                                           *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Restart a Waiter
+ */
+PRIVATE void test_api_spinwait_restart(void)
+{
+    struct spinwait waiter;
+
+    spinwait_init(&waiter, &test_stats);
+
+    while (spinwait_once(&waiter) == 0)
+        /* noop */;
+
+    spinwait_init(&waiter, &test_stats);
+
+    KASSERT(spinwait_once(&waiter) == 0);
+}
+
+/*----------------------------------------------------------------------------*
+ * Relax a Waiter                                                             *
+ *----------------------------------------------------------------------------*/
+
+/**
+ * @brief API Test: Relax a Waiter
+ */
+PRIVATE void test_api_spinwait_relax(void)
+{
+    struct spinwait waiter;
+
+    spinwait_init(&waiter, &test_stats);
+
+    /* Never asks to park, but goes through the same rounds. */
+    for (int i = 0; i < 2 * (SPINWAIT_SPINS + SPINWAIT_YIELDS); i++)
+        spinwait_relax(&waiter);
+
+    KASSERT(spinwait_once(&waiter) != 0);
+}
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test test_api_spinwait[] = {
+    {test_api_spinwait_policy, "spin/yield/park"},
+    {test_api_spinwait_restart, "restart        "},
+    {test_api_spinwait_relax, "relax          "},
+    {NULL, NULL},
+};
+
+/**
+ * The test_spinwait() function launches testing units on the spin
+ * wait interface of the HAL.
+ */
+PUBLIC void test_spinwait(void)
+{
+    /* API Tests */
+    CLUSTER_KPRINTF(HLINE);
+    for (int i = 0; test_api_spinwait[i].test_fn != NULL; i++) {
+        test_api_spinwait[i].test_fn();
+        CLUSTER_KPRINTF("[test][api][spinwait] %s [passed]",
+                        test_api_spinwait[i].name);
+    }
+}
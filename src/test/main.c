@@ -27,6 +27,10 @@
 #include <nanvix/hal/hal.h>
 #include <nanvix/hlib.h>
 
+#ifdef __unix64__
+#include <arch/target/unix64/unix64/transport.h>
+#endif
+
 /**
  * Horizontal line for tests.
  */
@@ -59,6 +63,7 @@ PRIVATE void test_core_al(void)
     test_mmu();
     test_tlb();
     test_trap();
+    test_spinwait();
 #ifndef __unix64__
     test_upcall();
 #endif
@@ -107,6 +112,14 @@ PRIVATE void test_target_al(void)
 #if (__TARGET_HAS_PORTAL)
     test_portal();
 #endif
+
+#if (__TARGET_HAS_POLL)
+    test_poll();
+#endif
+
+#if (__HAL_HAS_COALESCE)
+    test_coalesce();
+#endif
 }
 
 #ifndef __unix64__
@@ -177,7 +190,10 @@ PUBLIC NORETURN void kmain(int argc, const char *argv[])
 #endif
     }
 #ifdef __unix64__
-    if ((nodenum == NODENUM_MASTER) || (nodenum == NODENUM_SLAVE))
+    /* A process-local transport does not reach the slave. */
+    if (unix64_transport_get()->flags & UNIX64_TRANSPORT_LOCAL)
+        kprintf("[test] skipping inter-cluster tests");
+    else if (nodenum < test_stress_nodes_num())
         test_stress_al();
 #endif
 
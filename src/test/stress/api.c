@@ -29,6 +29,22 @@
 #include <nanvix/hlib.h>
 #include <posix/errno.h>
 
+/**
+ * The test_stress_nodes_num() function returns the number of nodes
+ * that run stress tests. The master and the slave node always do, and
+ * so does every other cluster that was powered on.
+ */
+PUBLIC int test_stress_nodes_num(void)
+{
+#ifdef __unix64__
+    int nclusters = linux64_processor_get_nclusters();
+
+    return ((nclusters > NODES_AMOUNT) ? nclusters : NODES_AMOUNT);
+#else
+    return (NODES_AMOUNT);
+#endif
+}
+
 #if (__TARGET_HAS_SYNC && __TARGET_HAS_MAILBOX && __TARGET_HAS_PORTAL &&       \
      !__NANVIX_IKC_USES_ONLY_MAILBOX)
 
@@ -42,13 +58,27 @@ PRIVATE struct fence stress_fence;
  */
 PRIVATE void do_test_stress_al(void)
 {
-    test_stress_setup();
+    int nodenum;
 
-    test_stress_mailbox();
-    test_stress_portal();
-    test_stress_combination();
+    nodenum = processor_node_get_num();
 
-    test_stress_cleanup();
+    /* Every node joins the barrier sweep. */
+    test_stress_interrupt_setup();
+    test_stress_sync_sweep();
+    test_stress_interrupt_cleanup();
+
+    /* Point-to-point tests. */
+    if ((nodenum == NODENUM_MASTER) || (nodenum == NODENUM_SLAVE)) {
+        test_stress_setup();
+
+        test_stress_sync();
+        test_stress_mailbox();
+        test_stress_portal();
+        test_stress_combination();
+        test_stress_coalesce();
+
+        test_stress_cleanup();
+    }
 
     vsys_exit();
     fence_join(&stress_fence);
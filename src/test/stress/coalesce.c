@@ -0,0 +1,262 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "../test.h"
+#include "stress.h"
+#include <nanvix/const.h>
+#include <nanvix/hal/hal.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+
+#if (__HAL_HAS_COALESCE)
+
+/**
+ * @name Number of setups and communications.
+ */
+/**@{*/
+#define NSETUPS 10
+#define NCOMMUNICATIONS 10
+/**@}*/
+
+/**
+ * @name Messages of a round.
+ */
+/**@{*/
+#define NBATCHED 8                                /**< Batch flush.  */
+#define NLONE 1                                   /**< Lone flush.   */
+#define NDELAYED 3                                /**< Delay flush.  */
+#define NMSGS (NBATCHED + NLONE + NDELAYED)       /**< Total.        */
+/**@}*/
+
+/**
+ * @name Time thresholds (in milliseconds).
+ */
+/**@{*/
+#define DELAY_NEVER 60000 /**< Not hit within a round. */
+#define DELAY_SHORT 10    /**< Hit while waiting.      */
+/**@}*/
+
+/**
+ * @brief Possible value returned by aread of a coalesced mailbox.
+ */
+#define AREAD_CHECKS(_ret)                                                     \
+    ((_ret == -ETIMEDOUT) || (_ret == -EAGAIN) || (_ret == -EBUSY) ||          \
+     (_ret == -ENOMSG) || (_ret == HAL_MAILBOX_MSG_SIZE))
+
+/*============================================================================*
+ * Stress Tests                                                               *
+ *============================================================================*/
+
+/**
+ * @brief Builds the message of a sequence number.
+ *
+ * @param message Target message.
+ * @param seq     Sequence number.
+ */
+PRIVATE void message_build(char *message, int seq)
+{
+    kmemset(message, (char)seq, HAL_MAILBOX_MSG_SIZE);
+    kmemcpy(message, &seq, sizeof(int));
+}
+
+/**
+ * @brief Checks the message of a sequence number.
+ *
+ * @param message Target message.
+ * @param seq     Expected sequence number.
+ */
+PRIVATE void message_check(const char *message, int seq)
+{
+    int got;
+
+    kmemcpy(&got, message, sizeof(int));
+    KASSERT(got == seq);
+
+    for (int k = sizeof(int); k < HAL_MAILBOX_MSG_SIZE; ++k)
+        KASSERT(message[k] == (char)seq);
+}
+
+/**
+ * @brief Reads a message from a coalesced mailbox, waiting for it.
+ *
+ * @param mbxid   ID of the target mailbox.
+ * @param message Place where the message should be stored.
+ */
+PRIVATE void message_read(int mbxid, char *message)
+{
+    int ret;
+
+    do {
+        ret = vsys_coalesce_aread(mbxid, message, HAL_MAILBOX_MSG_SIZE);
+        KASSERT(AREAD_CHECKS(ret));
+    } while (ret != HAL_MAILBOX_MSG_SIZE);
+}
+
+/**
+ * @brief Stress auxiliar: Coalesced sender rule
+ *
+ * Each round writes a batch of NBATCHED messages, which is flushed by
+ * the size threshold, a lone message, which is flushed on demand, and a few
+ * messages that are only flushed by the time threshold, while the
+ * sender waits for the acknowledgement of the round.
+ */
+PRIVATE void do_coalesce_sender(int local, int remote)
+{
+    int seq;
+    int inbox;
+    int outbox;
+    char message[HAL_MAILBOX_MSG_SIZE];
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((inbox = vsys_coalesce_create(local)) >= 0);
+        KASSERT((outbox = vsys_coalesce_open(remote)) >= 0);
+        KASSERT(vsys_coalesce_ioctl(
+                    outbox, COALESCE_IOCTL_SET_THRESHOLD, NBATCHED) == 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j) {
+            seq = j * NMSGS;
+
+            /* Batch flush. */
+            KASSERT(vsys_coalesce_ioctl(
+                        outbox, COALESCE_IOCTL_SET_DELAY, DELAY_NEVER) == 0);
+            for (int k = 0; k < NBATCHED; ++k) {
+                message_build(message, seq++);
+                KASSERT(vsys_coalesce_awrite(
+                            outbox, message, HAL_MAILBOX_MSG_SIZE) ==
+                        HAL_MAILBOX_MSG_SIZE);
+            }
+
+            /* Lone flush. */
+            message_build(message, seq++);
+            KASSERT(vsys_coalesce_awrite(
+                        outbox, message, HAL_MAILBOX_MSG_SIZE) ==
+                    HAL_MAILBOX_MSG_SIZE);
+            KASSERT(vsys_coalesce_flush(outbox) == 0);
+
+            /* Delay flush. */
+            KASSERT(vsys_coalesce_ioctl(
+                        outbox, COALESCE_IOCTL_SET_DELAY, DELAY_SHORT) == 0);
+            for (int k = 0; k < NDELAYED; ++k) {
+                message_build(message, seq++);
+                KASSERT(vsys_coalesce_awrite(
+                            outbox, message, HAL_MAILBOX_MSG_SIZE) ==
+                        HAL_MAILBOX_MSG_SIZE);
+            }
+
+            /* Acknowledgement. */
+            message_read(inbox, message);
+            message_check(message, j);
+        }
+
+        KASSERT(vsys_coalesce_close(outbox) == 0);
+        KASSERT(vsys_coalesce_unlink(inbox) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress auxiliar: Coalesced receiver rule
+ */
+PRIVATE void do_coalesce_receiver(int local, int remote)
+{
+    int inbox;
+    int outbox;
+    char message[HAL_MAILBOX_MSG_SIZE];
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((inbox = vsys_coalesce_create(local)) >= 0);
+        KASSERT((outbox = vsys_coalesce_open(remote)) >= 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j) {
+            for (int k = 0; k < NMSGS; ++k) {
+                kmemset(message, -1, HAL_MAILBOX_MSG_SIZE);
+                message_read(inbox, message);
+                message_check(message, j * NMSGS + k);
+            }
+
+            /* Acknowledgement. */
+            message_build(message, j);
+            KASSERT(vsys_coalesce_awrite(
+                        outbox, message, HAL_MAILBOX_MSG_SIZE) ==
+                    HAL_MAILBOX_MSG_SIZE);
+            KASSERT(vsys_coalesce_flush(outbox) == 0);
+        }
+
+        KASSERT(vsys_coalesce_close(outbox) == 0);
+        KASSERT(vsys_coalesce_unlink(inbox) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress Test: Coalesced Mailbox Flushes
+ */
+PRIVATE void stress_coalesce_flushes(void)
+{
+    if (processor_node_get_num() == NODENUM_MASTER)
+        do_coalesce_sender(NODENUM_MASTER, NODENUM_SLAVE);
+    else
+        do_coalesce_receiver(NODENUM_SLAVE, NODENUM_MASTER);
+}
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test stress_coalesce_tests[] = {
+    {stress_coalesce_flushes, "flushes"},
+    {NULL, NULL},
+};
+
+/**
+ * The test_stress_coalesce() function launches stress testing units on
+ * the coalescing interface of the HAL.
+ */
+PUBLIC void test_stress_coalesce(void)
+{
+    test_stress_barrier();
+
+    /* API Tests */
+    CLUSTER_KPRINTF(HLINE);
+    for (int i = 0; stress_coalesce_tests[i].test_fn != NULL; i++) {
+        stress_coalesce_tests[i].test_fn();
+
+        CLUSTER_KPRINTF("[test][stress][coalesce] %s [passed]",
+                        stress_coalesce_tests[i].name);
+
+        test_stress_barrier();
+    }
+}
+
+#endif /* __HAL_HAS_COALESCE */
@@ -46,7 +46,7 @@
 #define PORTAL_AREAD_CHECKS(_ret)                                              \
     ((_ret == -EBUSY) || (_ret == -ENOMSG) || (_ret == HAL_PORTAL_MAX_SIZE))
 #define PORTAL_AWRITE_CHECKS(_ret)                                             \
-    ((_ret == -EACCES) || (_ret == -EBUSY) || (_ret == HAL_PORTAL_MAX_SIZE))
+    ((_ret == -EBUSY) || (_ret == HAL_PORTAL_MAX_SIZE))
 /**@}*/
 
 /**
@@ -39,6 +39,11 @@
 #define NCOMMUNICATIONS 10
 /**@}*/
 
+/**
+ * @brief Number of round trips in a benchmark.
+ */
+#define NROUNDTRIPS 100
+
 /**
  * @name Possible value returned by aread/awrite.
  */
@@ -49,6 +54,18 @@
 #define AWRITE_CHECKS(_ret)                                                    \
     ((_ret == -ETIMEDOUT) || (_ret == -EAGAIN) || (_ret == -EBUSY) ||          \
      (_ret == HAL_MAILBOX_MSG_SIZE))
+#define AREADV_CHECKS(_ret)                                                    \
+    ((_ret == -ETIMEDOUT) || (_ret == -EAGAIN) || (_ret == -EBUSY) ||          \
+     (_ret == -ENOMSG) || (_ret > 0))
+#define AWRITEV_CHECKS(_ret)                                                   \
+    ((_ret == -ETIMEDOUT) || (_ret == -EAGAIN) || (_ret == -EBUSY) ||          \
+     (_ret > 0))
+#define PEEK_CHECKS(_ret)                                                      \
+    ((_ret == -ETIMEDOUT) || (_ret == -EAGAIN) || (_ret == -EBUSY) ||          \
+     (_ret == HAL_MAILBOX_MSG_SIZE))
+#define RESERVE_CHECKS(_ret)                                                   \
+    ((_ret == -ETIMEDOUT) || (_ret == -EAGAIN) || (_ret == -EBUSY) ||          \
+     (_ret == 0))
 /**@}*/
 
 /*============================================================================*
@@ -240,6 +257,356 @@ PRIVATE void stress_mailbox_pingpong(void)
     }
 }
 
+/**
+ * @brief Stress auxiliar: Burst sender rule
+ */
+PRIVATE void do_burst_sender(int remote)
+{
+    int ret;
+    int mbxid;
+    int nsent;
+    char messages[NCOMMUNICATIONS * HAL_MAILBOX_MSG_SIZE];
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((mbxid = vsys_mailbox_open(remote)) >= 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j)
+            messages[j * HAL_MAILBOX_MSG_SIZE] = (char)j;
+
+        nsent = 0;
+        do {
+            ret = vsys_mailbox_awritev(mbxid,
+                                       &messages[nsent * HAL_MAILBOX_MSG_SIZE],
+                                       NCOMMUNICATIONS - nsent);
+            KASSERT(AWRITEV_CHECKS(ret));
+            if (ret > 0)
+                nsent += ret;
+        } while (nsent < NCOMMUNICATIONS);
+        KASSERT(vsys_mailbox_wait(mbxid) == 0);
+
+        KASSERT(vsys_mailbox_close(mbxid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress auxiliar: Burst receiver rule
+ */
+PRIVATE void do_burst_receiver(int local)
+{
+    int ret;
+    int mbxid;
+    int nrecv;
+    char messages[NCOMMUNICATIONS * HAL_MAILBOX_MSG_SIZE];
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((mbxid = vsys_mailbox_create(local)) >= 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j)
+            messages[j * HAL_MAILBOX_MSG_SIZE] = (-1);
+
+        nrecv = 0;
+        do {
+            ret = vsys_mailbox_areadv(mbxid,
+                                      &messages[nrecv * HAL_MAILBOX_MSG_SIZE],
+                                      NCOMMUNICATIONS - nrecv);
+            KASSERT(AREADV_CHECKS(ret));
+            if (ret > 0)
+                nrecv += ret;
+        } while (nrecv < NCOMMUNICATIONS);
+        KASSERT(vsys_mailbox_wait(mbxid) == 0);
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j)
+            KASSERT(messages[j * HAL_MAILBOX_MSG_SIZE] == (char)j);
+
+        KASSERT(vsys_mailbox_unlink(mbxid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress Test: Mailbox Burst
+ */
+PRIVATE void stress_mailbox_burst(void)
+{
+    if (processor_node_get_num() == NODENUM_MASTER)
+        do_burst_sender(NODENUM_SLAVE);
+    else
+        do_burst_receiver(NODENUM_SLAVE);
+}
+
+/**
+ * @brief Stress auxiliar: Zero-copy sender rule
+ */
+PRIVATE void do_zerocopy_sender(int remote)
+{
+    int ret;
+    int mbxid;
+    char *msg;
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((mbxid = vsys_mailbox_open(remote)) >= 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j) {
+            do {
+                ret = vsys_mailbox_reserve(mbxid, (void **)&msg);
+                KASSERT(RESERVE_CHECKS(ret));
+            } while (ret != 0);
+
+            kmemset(msg, (char)j, HAL_MAILBOX_MSG_SIZE);
+
+            KASSERT(vsys_mailbox_commit(mbxid) == 0);
+        }
+
+        KASSERT(vsys_mailbox_close(mbxid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress auxiliar: Zero-copy receiver rule
+ */
+PRIVATE void do_zerocopy_receiver(int local)
+{
+    int ret;
+    int mbxid;
+    char *msg;
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((mbxid = vsys_mailbox_create(local)) >= 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j) {
+            do {
+                ret = vsys_mailbox_peek(mbxid, (void **)&msg);
+                KASSERT(PEEK_CHECKS(ret));
+            } while (ret < 0);
+
+            for (int k = 0; k < HAL_MAILBOX_MSG_SIZE; ++k)
+                KASSERT(msg[k] == (char)j);
+
+            KASSERT(vsys_mailbox_release(mbxid) == 0);
+        }
+
+        KASSERT(vsys_mailbox_unlink(mbxid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress Test: Mailbox Zero-Copy
+ */
+PRIVATE void stress_mailbox_zerocopy(void)
+{
+    if (processor_node_get_num() == NODENUM_MASTER)
+        do_zerocopy_sender(NODENUM_SLAVE);
+    else
+        do_zerocopy_receiver(NODENUM_SLAVE);
+}
+
+/**
+ * @brief Stress auxiliar: Sends a message until the mailbox accepts it.
+ */
+PRIVATE void do_send(int mbxid, const char *message)
+{
+    int ret;
+
+    do {
+        ret = vsys_mailbox_awrite(mbxid, message, HAL_MAILBOX_MSG_SIZE);
+        KASSERT(AWRITE_CHECKS(ret));
+    } while (ret != HAL_MAILBOX_MSG_SIZE);
+}
+
+/**
+ * @brief Stress auxiliar: Receives a message, waiting for it.
+ */
+PRIVATE void do_recv(int mbxid, char *message)
+{
+    int ret;
+
+    do {
+        ret = vsys_mailbox_aread(mbxid, message, HAL_MAILBOX_MSG_SIZE);
+        KASSERT(AREAD_CHECKS(ret));
+    } while (ret != HAL_MAILBOX_MSG_SIZE);
+}
+
+/**
+ * @brief Stress Test: Mailbox Latency
+ *
+ * Nodes bounce a message back and forth. The master reports the
+ * average cost of a round trip, which compares the transports that
+ * the target selects at boot.
+ */
+PRIVATE void stress_mailbox_latency(void)
+{
+    int local;
+    int remote;
+    int inbox;
+    int outbox;
+    uint64_t t0;
+    uint64_t t1;
+    char message[HAL_MAILBOX_MSG_SIZE];
+
+    local = processor_node_get_num();
+    remote = local == NODENUM_MASTER ? NODENUM_SLAVE : NODENUM_MASTER;
+
+    KASSERT((inbox = vsys_mailbox_create(local)) >= 0);
+    KASSERT((outbox = vsys_mailbox_open(remote)) >= 0);
+
+    kmemset(message, 0, HAL_MAILBOX_MSG_SIZE);
+
+    test_stress_barrier();
+
+    t0 = clock_read();
+
+    for (int i = 0; i < NROUNDTRIPS; ++i) {
+        if (local == NODENUM_MASTER) {
+            do_send(outbox, message);
+            do_recv(inbox, message);
+        } else {
+            do_recv(inbox, message);
+            do_send(outbox, message);
+        }
+    }
+
+    t1 = clock_read();
+
+    CLUSTER_KPRINTF("[test][stress][mailbox] latency cycles/round-trip=%d",
+                    (int)((t1 - t0) / NROUNDTRIPS));
+
+    test_stress_barrier();
+
+    KASSERT(vsys_mailbox_close(outbox) == 0);
+    KASSERT(vsys_mailbox_unlink(inbox) == 0);
+}
+
+/**
+ * @brief Size of a short message (in bytes).
+ */
+#define SHORT_SIZE (HAL_MAILBOX_MSG_SIZE / 2)
+
+/**
+ * @brief Stress auxiliar: Short sender rule
+ *
+ * Each round sends a short message and then a full one.
+ */
+PRIVATE void do_short_sender(int remote)
+{
+    int ret;
+    int mbxid;
+    char message[HAL_MAILBOX_MSG_SIZE];
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((mbxid = vsys_mailbox_open(remote)) >= 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j) {
+            kmemset(message, (char)j, SHORT_SIZE);
+            do {
+                ret = vsys_mailbox_awrite(mbxid, message, SHORT_SIZE);
+                KASSERT((ret == SHORT_SIZE) ||
+                        ((ret < 0) && AWRITE_CHECKS(ret)));
+            } while (ret != SHORT_SIZE);
+            KASSERT(vsys_mailbox_wait(mbxid) == 0);
+
+            kmemset(message, (char)~j, HAL_MAILBOX_MSG_SIZE);
+            do {
+                ret = vsys_mailbox_awrite(mbxid, message, HAL_MAILBOX_MSG_SIZE);
+                KASSERT(AWRITE_CHECKS(ret));
+            } while (ret != HAL_MAILBOX_MSG_SIZE);
+            KASSERT(vsys_mailbox_wait(mbxid) == 0);
+        }
+
+        KASSERT(vsys_mailbox_close(mbxid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress auxiliar: Short receiver rule
+ *
+ * The short message is first rejected by a batch read, and then read
+ * into a full-size buffer. The full one is first read into a buffer
+ * that is too small for it, and then by a batch read, which stops at
+ * the short message of the next round, if it is already there.
+ */
+PRIVATE void do_short_receiver(int local)
+{
+    int ret;
+    int mbxid;
+    char message[2 * HAL_MAILBOX_MSG_SIZE];
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((mbxid = vsys_mailbox_create(local)) >= 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j) {
+            /* Batch read does not take short messages. */
+            do {
+                ret = vsys_mailbox_areadv(mbxid, message, 1);
+                KASSERT((ret == (-EMSGSIZE)) ||
+                        ((ret < 0) && AREADV_CHECKS(ret)));
+            } while (ret != (-EMSGSIZE));
+
+            /* Only the bytes that were written are read. */
+            kmemset(message, -1, HAL_MAILBOX_MSG_SIZE);
+            do {
+                ret = vsys_mailbox_aread(mbxid, message, HAL_MAILBOX_MSG_SIZE);
+                KASSERT((ret == SHORT_SIZE) ||
+                        ((ret < 0) && AREAD_CHECKS(ret)));
+            } while (ret != SHORT_SIZE);
+            KASSERT(vsys_mailbox_wait(mbxid) == 0);
+
+            for (int k = 0; k < SHORT_SIZE; ++k)
+                KASSERT(message[k] == (char)j);
+            KASSERT(message[SHORT_SIZE] == (char)(-1));
+
+            /* Message does not fit, so it is kept. */
+            do {
+                ret = vsys_mailbox_aread(mbxid, message, SHORT_SIZE);
+                KASSERT((ret == (-EMSGSIZE)) ||
+                        ((ret < 0) && AREAD_CHECKS(ret)));
+            } while (ret != (-EMSGSIZE));
+
+            kmemset(message, -1, HAL_MAILBOX_MSG_SIZE);
+            KASSERT(vsys_mailbox_areadv(mbxid, message, 2) == 1);
+            KASSERT(vsys_mailbox_wait(mbxid) == 0);
+
+            for (int k = 0; k < HAL_MAILBOX_MSG_SIZE; ++k)
+                KASSERT(message[k] == (char)~j);
+        }
+
+        KASSERT(vsys_mailbox_unlink(mbxid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress Test: Mailbox Short Message
+ */
+PRIVATE void stress_mailbox_short(void)
+{
+    if (processor_node_get_num() == NODENUM_MASTER)
+        do_short_sender(NODENUM_SLAVE);
+    else
+        do_short_receiver(NODENUM_SLAVE);
+}
+
 /*============================================================================*
  * Test Driver                                                                *
  *============================================================================*/
@@ -254,6 +621,10 @@ PRIVATE struct test stress_mailbox_tests[] = {
     {stress_mailbox_broadcast, "broadcast    "},
     {stress_mailbox_gather, "gather       "},
     {stress_mailbox_pingpong, "ping-pong    "},
+    {stress_mailbox_burst, "burst        "},
+    {stress_mailbox_zerocopy, "zero-copy    "},
+    {stress_mailbox_short, "short        "},
+    {stress_mailbox_latency, "latency      "},
     {NULL, NULL},
 };
 
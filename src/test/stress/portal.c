@@ -46,7 +46,7 @@
 #define AREAD_CHECKS(_ret)                                                     \
     ((_ret == -EBUSY) || (_ret == -ENOMSG) || (_ret == HAL_PORTAL_MAX_SIZE))
 #define AWRITE_CHECKS(_ret)                                                    \
-    ((_ret == -EACCES) || (_ret == -EBUSY) || (_ret == HAL_PORTAL_MAX_SIZE))
+    ((_ret == -EBUSY) || (_ret == HAL_PORTAL_MAX_SIZE))
 /**@}*/
 
 /**
@@ -54,6 +54,16 @@
  */
 static char data[HAL_PORTAL_MAX_SIZE];
 
+/**
+ * @brief Size of a large transfer (in bytes).
+ */
+#define LARGE_SIZE (16 * HAL_PORTAL_MAX_SIZE + 1)
+
+/**
+ * @brief Auxiliar buffer for large transfers.
+ */
+static char large[LARGE_SIZE];
+
 /*============================================================================*
  * Stress Tests                                                               *
  *============================================================================*/
@@ -244,6 +254,435 @@ PRIVATE void stress_portal_pingpong(void)
     }
 }
 
+/**
+ * @brief Stress auxiliar: Pipelined sender rule
+ */
+PRIVATE void do_pipeline_sender(int local, int remote)
+{
+    int ret;
+    int portalid;
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((portalid = vsys_portal_open(local, remote)) >= 0);
+
+        test_stress_barrier();
+
+        /* Do not wait for the receiver between writes. */
+        for (int j = 0; j < NCOMMUNICATIONS; ++j) {
+            data[0] = (char)j;
+            do {
+                ret = vsys_portal_awrite(portalid, data, HAL_PORTAL_MAX_SIZE);
+                KASSERT(AWRITE_CHECKS(ret));
+            } while (ret != HAL_PORTAL_MAX_SIZE);
+        }
+        KASSERT(vsys_portal_wait(portalid) == 0);
+
+        KASSERT(vsys_portal_close(portalid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress auxiliar: Pipelined receiver rule
+ */
+PRIVATE void do_pipeline_receiver(int local, int remote)
+{
+    int ret;
+    int portalid;
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((portalid = vsys_portal_create(local)) >= 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j) {
+            data[0] = (-1);
+            KASSERT(vsys_portal_allow(portalid, remote) == 0);
+            do {
+                ret = vsys_portal_aread(portalid, data, HAL_PORTAL_MAX_SIZE);
+                KASSERT(AREAD_CHECKS(ret));
+            } while (ret != HAL_PORTAL_MAX_SIZE);
+            KASSERT(vsys_portal_wait(portalid) == 0);
+
+            /* Messages must arrive in order. */
+            KASSERT(data[0] == (char)j);
+        }
+
+        KASSERT(vsys_portal_unlink(portalid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress Test: Portal Pipeline
+ */
+PRIVATE void stress_portal_pipeline(void)
+{
+    if (processor_node_get_num() == NODENUM_MASTER)
+        do_pipeline_sender(NODENUM_MASTER, NODENUM_SLAVE);
+    else
+        do_pipeline_receiver(NODENUM_SLAVE, NODENUM_MASTER);
+}
+
+/**
+ * @brief Stress auxiliar: Early sender rule
+ */
+PRIVATE void do_early_sender(int local, int remote)
+{
+    int portalid;
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((portalid = vsys_portal_open(local, remote)) >= 0);
+
+        test_stress_barrier();
+
+        /* Writes need no prior allow. */
+        data[0] = (char)i;
+        KASSERT(vsys_portal_awrite(portalid, data, HAL_PORTAL_MAX_SIZE) ==
+                HAL_PORTAL_MAX_SIZE);
+        KASSERT(vsys_portal_wait(portalid) == 0);
+
+        test_stress_barrier();
+
+        KASSERT(vsys_portal_close(portalid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress auxiliar: Late receiver rule
+ */
+PRIVATE void do_late_receiver(int local, int remote)
+{
+    int portalid;
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((portalid = vsys_portal_create(local)) >= 0);
+
+        test_stress_barrier();
+
+        /* Allow only after the write has completed. */
+        test_stress_barrier();
+
+        data[0] = (-1);
+        KASSERT(vsys_portal_allow(portalid, remote) == 0);
+        KASSERT(vsys_portal_aread(portalid, data, HAL_PORTAL_MAX_SIZE) ==
+                HAL_PORTAL_MAX_SIZE);
+        KASSERT(vsys_portal_wait(portalid) == 0);
+        KASSERT(data[0] == (char)i);
+
+        KASSERT(vsys_portal_unlink(portalid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress Test: Portal Write Before Allow
+ */
+PRIVATE void stress_portal_early_write(void)
+{
+    if (processor_node_get_num() == NODENUM_MASTER)
+        do_early_sender(NODENUM_MASTER, NODENUM_SLAVE);
+    else
+        do_late_receiver(NODENUM_SLAVE, NODENUM_MASTER);
+}
+
+/**
+ * @brief Stress auxiliar: Short sender rule
+ */
+PRIVATE void do_short_sender(int local, int remote)
+{
+    int portalid;
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((portalid = vsys_portal_open(local, remote)) >= 0);
+
+        test_stress_barrier();
+
+        kmemset(data, (char)i, HAL_PORTAL_MAX_SIZE / 2);
+        KASSERT(vsys_portal_awrite(portalid, data, HAL_PORTAL_MAX_SIZE / 2) ==
+                HAL_PORTAL_MAX_SIZE / 2);
+        KASSERT(vsys_portal_wait(portalid) == 0);
+
+        KASSERT(vsys_portal_close(portalid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress auxiliar: Short receiver rule
+ */
+PRIVATE void do_short_receiver(int local, int remote)
+{
+    int portalid;
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((portalid = vsys_portal_create(local)) >= 0);
+
+        test_stress_barrier();
+
+        /* Only the bytes that were written are read. */
+        kmemset(data, -1, HAL_PORTAL_MAX_SIZE);
+        KASSERT(vsys_portal_allow(portalid, remote) == 0);
+        KASSERT(vsys_portal_aread(portalid, data, HAL_PORTAL_MAX_SIZE) ==
+                HAL_PORTAL_MAX_SIZE / 2);
+        KASSERT(vsys_portal_wait(portalid) == 0);
+
+        for (unsigned int j = 0; j < HAL_PORTAL_MAX_SIZE / 2; ++j)
+            KASSERT(data[j] == (char)i);
+        KASSERT(data[HAL_PORTAL_MAX_SIZE / 2] == (char)(-1));
+
+        KASSERT(vsys_portal_unlink(portalid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress Test: Portal Short Message
+ */
+PRIVATE void stress_portal_short(void)
+{
+    if (processor_node_get_num() == NODENUM_MASTER)
+        do_short_sender(NODENUM_MASTER, NODENUM_SLAVE);
+    else
+        do_short_receiver(NODENUM_SLAVE, NODENUM_MASTER);
+}
+
+/**
+ * @brief Stress auxiliar: Large sender rule
+ */
+PRIVATE void do_large_sender(int local, int remote)
+{
+    int portalid;
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((portalid = vsys_portal_open(local, remote)) >= 0);
+
+        test_stress_barrier();
+
+        for (unsigned int j = 0; j < LARGE_SIZE; ++j)
+            large[j] = (char)(i + j);
+
+        KASSERT(vsys_portal_awrite_large(portalid, large, LARGE_SIZE) ==
+                LARGE_SIZE);
+        KASSERT(vsys_portal_wait(portalid) == 0);
+
+        KASSERT(vsys_portal_close(portalid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress auxiliar: Large receiver rule
+ */
+PRIVATE void do_large_receiver(int local, int remote)
+{
+    int portalid;
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((portalid = vsys_portal_create(local)) >= 0);
+
+        test_stress_barrier();
+
+        kmemset(large, -1, LARGE_SIZE);
+
+        KASSERT(vsys_portal_allow(portalid, remote) == 0);
+        KASSERT(vsys_portal_aread_large(portalid, large, LARGE_SIZE) ==
+                LARGE_SIZE);
+        KASSERT(vsys_portal_wait(portalid) == 0);
+
+        for (unsigned int j = 0; j < LARGE_SIZE; ++j)
+            KASSERT(large[j] == (char)(i + j));
+
+        KASSERT(vsys_portal_unlink(portalid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress Test: Portal Large Transfer
+ */
+PRIVATE void stress_portal_large(void)
+{
+    if (processor_node_get_num() == NODENUM_MASTER)
+        do_large_sender(NODENUM_MASTER, NODENUM_SLAVE);
+    else
+        do_large_receiver(NODENUM_SLAVE, NODENUM_MASTER);
+}
+
+/**
+ * @brief Stress auxiliar: Zero-copy receiver rule
+ */
+PRIVATE void do_zerocopy_receiver(int local, int remote)
+{
+    int ret;
+    char *msg;
+    int portalid;
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((portalid = vsys_portal_create(local)) >= 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j) {
+            KASSERT(vsys_portal_allow(portalid, remote) == 0);
+            do {
+                ret = vsys_portal_peek(portalid, (void **)&msg);
+                KASSERT(AREAD_CHECKS(ret));
+            } while (ret != HAL_PORTAL_MAX_SIZE);
+
+            KASSERT(msg[0] == (char)j);
+
+            KASSERT(vsys_portal_release(portalid) == 0);
+        }
+
+        KASSERT(vsys_portal_unlink(portalid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress Test: Portal Zero-Copy
+ */
+PRIVATE void stress_portal_zerocopy(void)
+{
+    if (processor_node_get_num() == NODENUM_MASTER)
+        do_pipeline_sender(NODENUM_MASTER, NODENUM_SLAVE);
+    else
+        do_zerocopy_receiver(NODENUM_SLAVE, NODENUM_MASTER);
+}
+
+/**
+ * @brief Stress auxiliar: Gather sender rule
+ */
+PRIVATE void do_gather_sender(int local, int remote)
+{
+    int ret;
+    int portalid;
+    char header[HAL_PORTAL_RESERVED_SIZE];
+    struct portal_iovec iov[2] = {
+        {header, HAL_PORTAL_RESERVED_SIZE},
+        {data, HAL_PORTAL_DATA_SIZE},
+    };
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((portalid = vsys_portal_open(local, remote)) >= 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j) {
+            header[0] = (char)j;
+            data[0] = (char)~j;
+            do {
+                ret = vsys_portal_awritev(portalid, iov, 2);
+                KASSERT(AWRITE_CHECKS(ret));
+            } while (ret != HAL_PORTAL_MAX_SIZE);
+        }
+        KASSERT(vsys_portal_wait(portalid) == 0);
+
+        KASSERT(vsys_portal_close(portalid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress auxiliar: Scatter receiver rule
+ */
+PRIVATE void do_scatter_receiver(int local, int remote)
+{
+    int ret;
+    int portalid;
+    struct portal_iovec iov[2] = {
+        {data, 1},
+        {data + 1, HAL_PORTAL_MAX_SIZE - 1},
+    };
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((portalid = vsys_portal_create(local)) >= 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j) {
+            kmemset(data, -1, HAL_PORTAL_MAX_SIZE);
+            KASSERT(vsys_portal_allow(portalid, remote) == 0);
+            do {
+                ret = vsys_portal_areadv(portalid, iov, 2);
+                KASSERT(AREAD_CHECKS(ret));
+            } while (ret != HAL_PORTAL_MAX_SIZE);
+            KASSERT(vsys_portal_wait(portalid) == 0);
+
+            /* Segments must be laid out back to back. */
+            KASSERT(data[0] == (char)j);
+            KASSERT(data[HAL_PORTAL_RESERVED_SIZE] == (char)~j);
+        }
+
+        KASSERT(vsys_portal_unlink(portalid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress Test: Portal Scatter-Gather
+ */
+PRIVATE void stress_portal_scatter_gather(void)
+{
+    if (processor_node_get_num() == NODENUM_MASTER)
+        do_gather_sender(NODENUM_MASTER, NODENUM_SLAVE);
+    else
+        do_scatter_receiver(NODENUM_SLAVE, NODENUM_MASTER);
+}
+
+/**
+ * @brief Stress auxiliar: Multicast sender rule
+ */
+PRIVATE void do_multicast_sender(int local, int remote)
+{
+    int ret;
+    int portalid;
+    int nodes[2] = {local, remote};
+
+    for (unsigned int i = 0; i < NSETUPS; ++i) {
+        KASSERT((portalid = vsys_portal_mopen(nodes, 2)) >= 0);
+
+        test_stress_barrier();
+
+        for (int j = 0; j < NCOMMUNICATIONS; ++j) {
+            data[0] = (j % sizeof(char));
+            do {
+                ret = vsys_portal_awrite(portalid, data, HAL_PORTAL_MAX_SIZE);
+                KASSERT(AWRITE_CHECKS(ret));
+            } while (ret != HAL_PORTAL_MAX_SIZE);
+            KASSERT(vsys_portal_wait(portalid) == 0);
+        }
+
+        KASSERT(vsys_portal_close(portalid) == 0);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * @brief Stress Test: Portal Multicast
+ */
+PRIVATE void stress_portal_multicast(void)
+{
+    if (processor_node_get_num() == NODENUM_MASTER)
+        do_multicast_sender(NODENUM_MASTER, NODENUM_SLAVE);
+    else
+        do_receiver(NODENUM_SLAVE, NODENUM_MASTER);
+}
+
 /*============================================================================*
  * Test Driver                                                                *
  *============================================================================*/
@@ -258,6 +697,13 @@ PRIVATE struct test stress_portal_tests[] = {
     {stress_portal_broadcast, "broadcast    "},
     {stress_portal_gather, "gather       "},
     {stress_portal_pingpong, "ping-pong    "},
+    {stress_portal_pipeline, "pipeline     "},
+    {stress_portal_early_write, "early write  "},
+    {stress_portal_short, "short        "},
+    {stress_portal_large, "large        "},
+    {stress_portal_zerocopy, "zero-copy    "},
+    {stress_portal_scatter_gather, "scatter      "},
+    {stress_portal_multicast, "multicast    "},
     {NULL, NULL},
 };
 
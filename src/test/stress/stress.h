@@ -38,6 +38,16 @@ EXTERN void test_stress_cleanup(void);
 EXTERN void test_stress_barrier(void);
 /**@}*/
 
+/**
+ * @brief Stress test driver for the Sync Interface
+ */
+EXTERN void test_stress_sync(void);
+
+/**
+ * @brief Barrier sweep over the nodes that run stress tests
+ */
+EXTERN void test_stress_sync_sweep(void);
+
 /**
  * @brief Stress test driver for the Mailbox Interface
  */
@@ -54,4 +64,9 @@ EXTERN void test_stress_portal(void);
  */
 EXTERN void test_stress_combination(void);
 
+/**
+ * @brief Stress test driver for the Coalescing Interface
+ */
+EXTERN void test_stress_coalesce(void);
+
 #endif /* _STRESS_H_ */
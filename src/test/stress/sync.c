@@ -0,0 +1,423 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../test.h"
+#include "stress.h"
+#include <nanvix/const.h>
+#include <nanvix/hal/hal.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+
+#if (__TARGET_HAS_SYNC && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+/**
+ * @brief Number of barriers in a benchmark.
+ */
+#define NBARRIERS 100
+
+/*============================================================================*
+ * Stress Tests                                                               *
+ *============================================================================*/
+
+/**
+ * @brief Stress auxiliar: Signal until the sync accepts it.
+ */
+PRIVATE void do_signal(int syncid)
+{
+    int ret;
+
+    do
+        ret = vsys_sync_signal(syncid);
+    while (ret == (-EAGAIN));
+    KASSERT(ret == 0);
+}
+
+/**
+ * @brief Stress Test: Split-Phase Barrier
+ *
+ * Both nodes gather into each other, announcing arrival first and
+ * testing for completion while they work.
+ */
+PRIVATE void stress_sync_split_phase(void)
+{
+    int ret;
+    int local;
+    int remote;
+    int syncin;
+    int syncout;
+    int nodes[2];
+    int ntests;
+
+    local = processor_node_get_num();
+    remote = (local == NODENUM_MASTER) ? NODENUM_SLAVE : NODENUM_MASTER;
+
+    /* We gather. */
+    nodes[0] = local;
+    nodes[1] = remote;
+    KASSERT((syncin = vsys_sync_create(nodes, 2, SYNC_ALL_TO_ONE)) >= 0);
+
+    /* Remote gathers. */
+    nodes[0] = remote;
+    nodes[1] = local;
+    KASSERT((syncout = vsys_sync_open(nodes, 2, SYNC_ALL_TO_ONE)) >= 0);
+
+    test_stress_barrier();
+
+    for (int i = 0; i < NBARRIERS; i++) {
+        KASSERT(vsys_sync_arrive(syncout) == 0);
+
+        /* Overlap some work with the barrier. */
+        for (ntests = 0; (ret = vsys_sync_test(syncin)) == 0; ntests++) {
+            if (ntests == NBARRIERS) {
+                KASSERT(vsys_sync_await(syncin) == 0);
+                break;
+            }
+        }
+        KASSERT(ret >= 0);
+
+        KASSERT(vsys_sync_await(syncout) == 0);
+    }
+
+    test_stress_barrier();
+
+    KASSERT(vsys_sync_close(syncout) == 0);
+    KASSERT(vsys_sync_unlink(syncin) == 0);
+}
+
+/**
+ * @brief Stress Test: Signal Before Create
+ *
+ * The master signals a sync that the slave only creates afterwards,
+ * so the signal must not be lost meanwhile.
+ */
+PRIVATE void stress_sync_early_signal(void)
+{
+    int local;
+    int remote;
+    int syncid;
+    int nodes[2];
+
+    local = processor_node_get_num();
+    remote = (local == NODENUM_MASTER) ? NODENUM_SLAVE : NODENUM_MASTER;
+
+    for (int i = 0; i < NBARRIERS; i++) {
+        /* Remote gathers. */
+        if (local == NODENUM_MASTER) {
+            nodes[0] = remote;
+            nodes[1] = local;
+            KASSERT((syncid = vsys_sync_open(nodes, 2, SYNC_ALL_TO_ONE)) >= 0);
+            do_signal(syncid);
+
+            test_stress_barrier();
+
+            KASSERT(vsys_sync_close(syncid) == 0);
+        } else {
+            test_stress_barrier();
+
+            nodes[0] = local;
+            nodes[1] = remote;
+            KASSERT((syncid = vsys_sync_create(nodes, 2, SYNC_ALL_TO_ONE)) >=
+                    0);
+            KASSERT(vsys_sync_wait(syncid) == 0);
+
+            KASSERT(vsys_sync_unlink(syncid) == 0);
+        }
+
+        test_stress_barrier();
+    }
+}
+
+/*============================================================================*
+ * Barrier Sweep                                                              *
+ *============================================================================*/
+
+/**
+ * @brief Barrier among the first nodes of the processor.
+ */
+struct barrier {
+    int root;    /**< Node that gathers arrivals. */
+    int gather;  /**< Sync of arrivals.           */
+    int release; /**< Sync of release.            */
+};
+
+/**
+ * @brief Algorithms of syncs.
+ */
+PRIVATE const struct {
+    int algorithm;    /**< Algorithm. */
+    const char *name; /**< Name.      */
+} algorithms[] = {
+    {SYNC_ALGORITHM_LINEAR, "linear       "},
+    {SYNC_ALGORITHM_TREE, "tree         "},
+    {SYNC_ALGORITHM_DISSEMINATION, "dissemination"},
+    {-1, NULL},
+};
+
+/**
+ * @brief Stress auxiliar: Opens a barrier.
+ *
+ * Node @p root gathers the arrivals of all nodes below @p nnodes, and
+ * then broadcasts their release.
+ *
+ * @param barrier   Target barrier.
+ * @param root      Node that gathers arrivals.
+ * @param nnodes    Number of nodes.
+ * @param algorithm Algorithm of the syncs.
+ */
+PRIVATE void do_barrier_open(struct barrier *barrier, int root, int nnodes,
+                             int algorithm)
+{
+    int nodes[PROCESSOR_NOC_NODES_NUM];
+
+    /* Root comes first. */
+    nodes[0] = root;
+    for (int i = 0, j = 1; i < nnodes; i++) {
+        if (i != root)
+            nodes[j++] = i;
+    }
+
+    barrier->root = root;
+
+    if (processor_node_get_num() == root) {
+        KASSERT((barrier->gather =
+                     vsys_sync_create(nodes, nnodes, SYNC_ALL_TO_ONE)) >= 0);
+        KASSERT((barrier->release =
+                     vsys_sync_open(nodes, nnodes, SYNC_ONE_TO_ALL)) >= 0);
+    } else {
+        KASSERT((barrier->gather =
+                     vsys_sync_open(nodes, nnodes, SYNC_ALL_TO_ONE)) >= 0);
+        KASSERT((barrier->release =
+                     vsys_sync_create(nodes, nnodes, SYNC_ONE_TO_ALL)) >= 0);
+    }
+
+    KASSERT(vsys_sync_ioctl(barrier->gather,
+                            SYNC_IOCTL_SET_ALGORITHM,
+                            algorithm) == 0);
+    KASSERT(vsys_sync_ioctl(barrier->release,
+                            SYNC_IOCTL_SET_ALGORITHM,
+                            algorithm) == 0);
+}
+
+/**
+ * @brief Stress auxiliar: Waits on a barrier.
+ *
+ * @param barrier Target barrier.
+ */
+PRIVATE void do_barrier_wait(struct barrier *barrier)
+{
+    if (processor_node_get_num() == barrier->root) {
+        KASSERT(vsys_sync_wait(barrier->gather) == 0);
+        do_signal(barrier->release);
+    } else {
+        do_signal(barrier->gather);
+        KASSERT(vsys_sync_wait(barrier->release) == 0);
+    }
+}
+
+/**
+ * @brief Stress auxiliar: Closes a barrier.
+ *
+ * @param barrier Target barrier.
+ */
+PRIVATE void do_barrier_close(struct barrier *barrier)
+{
+    if (processor_node_get_num() == barrier->root) {
+        KASSERT(vsys_sync_unlink(barrier->gather) == 0);
+        KASSERT(vsys_sync_close(barrier->release) == 0);
+    } else {
+        KASSERT(vsys_sync_close(barrier->gather) == 0);
+        KASSERT(vsys_sync_unlink(barrier->release) == 0);
+    }
+}
+
+/**
+ * @brief Stress Test: Barrier Topology
+ *
+ * All nodes meet in barriers of some algorithm. With four nodes or
+ * more, intermediate nodes of a tree or a dissemination topology relay
+ * the release and combine the arrivals of their children. No round
+ * may complete before every node arrives, nor complete twice.
+ *
+ * @param control   Barrier among all nodes.
+ * @param nnodes    Number of nodes.
+ * @param algorithm Algorithm of the syncs.
+ */
+PRIVATE void stress_sync_topology(struct barrier *control, int nnodes,
+                                  int algorithm)
+{
+    int local;
+    struct barrier barrier;
+
+    local = processor_node_get_num();
+
+    do_barrier_open(&barrier, NODENUM_MASTER, nnodes, algorithm);
+
+    /* Nobody signals before all nodes have selected the algorithm. */
+    do_barrier_wait(control);
+
+    for (int i = 0; i < NBARRIERS; i++) {
+        if (local == barrier.root) {
+            KASSERT(vsys_sync_wait(barrier.gather) == 0);
+
+            /* Nobody is released, thus nobody arrives again. */
+            KASSERT(vsys_sync_test(barrier.gather) == 0);
+
+            do_signal(barrier.release);
+        } else {
+            /* We did not arrive, thus we are not released. */
+            KASSERT(vsys_sync_test(barrier.release) == 0);
+
+            do_signal(barrier.gather);
+            KASSERT(vsys_sync_wait(barrier.release) == 0);
+        }
+    }
+
+    do_barrier_wait(control);
+
+    /* Every round was consumed exactly once. */
+    KASSERT(vsys_sync_test((local == barrier.root) ? barrier.gather
+                                                   : barrier.release) == 0);
+
+    do_barrier_close(&barrier);
+}
+
+/**
+ * @brief Stress Test: Barrier Benchmark
+ *
+ * Nodes below @p nnodes meet in barriers, and the master reports the
+ * average cost of a barrier. The other nodes only join the control
+ * barrier.
+ *
+ * @param control   Barrier among all nodes.
+ * @param nnodes    Number of nodes.
+ * @param algorithm Algorithm of the syncs.
+ * @param name      Name of the algorithm.
+ */
+PRIVATE void stress_sync_benchmark(struct barrier *control, int nnodes,
+                                   int algorithm, const char *name)
+{
+    int local;
+    uint64_t t0;
+    uint64_t t1;
+    struct barrier barrier;
+
+    local = processor_node_get_num();
+
+    if (local < nnodes)
+        do_barrier_open(&barrier, NODENUM_MASTER, nnodes, algorithm);
+
+    do_barrier_wait(control);
+
+    if (local < nnodes) {
+        t0 = clock_read();
+
+        for (int i = 0; i < NBARRIERS; i++)
+            do_barrier_wait(&barrier);
+
+        t1 = clock_read();
+
+        CLUSTER_KPRINTF("[test][stress][sync] %s nnodes=%2d cycles/barrier=%d",
+                        name,
+                        nnodes,
+                        (int)((t1 - t0) / NBARRIERS));
+    }
+
+    do_barrier_wait(control);
+
+    if (local < nnodes)
+        do_barrier_close(&barrier);
+}
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test stress_sync_tests[] = {
+    /* Intra-Cluster API Tests */
+    {stress_sync_split_phase, "split phase  "},
+    {stress_sync_early_signal, "early signal "},
+    {NULL, NULL},
+};
+
+/**
+ * The test_stress_sync() function launches stress testing units on the
+ * sync interface of the HAL.
+ */
+PUBLIC void test_stress_sync(void)
+{
+    test_stress_barrier();
+
+    /* API Tests */
+    CLUSTER_KPRINTF(HLINE);
+    for (int i = 0; stress_sync_tests[i].test_fn != NULL; i++) {
+        stress_sync_tests[i].test_fn();
+
+        CLUSTER_KPRINTF("[test][stress][sync] %s [passed]",
+                        stress_sync_tests[i].name);
+
+        test_stress_barrier();
+    }
+}
+
+/**
+ * The test_stress_sync_sweep() function launches the barrier sweep on
+ * every node that runs stress tests. Barriers of each algorithm are
+ * first checked among all nodes, and then timed among the first two,
+ * three, and so on up to all nodes.
+ *
+ * @note Boot four clusters or more to cover relays and combining.
+ */
+PUBLIC void test_stress_sync_sweep(void)
+{
+    int nnodes;
+    struct barrier control;
+
+    nnodes = test_stress_nodes_num();
+
+    /* Measured barriers are rooted at the master, thus not this one. */
+    do_barrier_open(&control, nnodes - 1, nnodes, SYNC_ALGORITHM_LINEAR);
+
+    CLUSTER_KPRINTF(HLINE);
+    for (int i = 0; algorithms[i].name != NULL; i++) {
+        stress_sync_topology(&control, nnodes, algorithms[i].algorithm);
+
+        CLUSTER_KPRINTF("[test][stress][sync] %s nnodes=%2d [passed]",
+                        algorithms[i].name,
+                        nnodes);
+    }
+
+    for (int n = NODES_AMOUNT; n <= nnodes; n++) {
+        for (int i = 0; algorithms[i].name != NULL; i++) {
+            stress_sync_benchmark(
+                &control, n, algorithms[i].algorithm, algorithms[i].name);
+        }
+    }
+
+    do_barrier_close(&control);
+}
+
+#endif /* __TARGET_HAS_SYNC && !__NANVIX_IKC_USES_ONLY_MAILBOX */
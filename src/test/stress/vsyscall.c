@@ -92,6 +92,20 @@ PUBLIC void vsys_loop(void)
             ret = sync_signal((int)sysboard.arg0);
             break;
 
+        case NR_sync_ioctl:
+            ret = sync_ioctl((int)sysboard.arg0,
+                             (unsigned)sysboard.arg1,
+                             (int)sysboard.arg2);
+            break;
+
+        case NR_sync_arrive:
+            ret = sync_arrive((int)sysboard.arg0);
+            break;
+
+        case NR_sync_test:
+            ret = sync_test((int)sysboard.arg0);
+            break;
+
         case NR_mailbox_create:
             ret = mailbox_create((int)sysboard.arg0);
             break;
@@ -120,6 +134,36 @@ PUBLIC void vsys_loop(void)
                                  (size_t)sysboard.arg2);
             break;
 
+        case NR_mailbox_areadv:
+            ret = mailbox_areadv((int)sysboard.arg0,
+                                 (void *)(long)sysboard.arg1,
+                                 (int)sysboard.arg2);
+            break;
+
+        case NR_mailbox_awritev:
+            ret = mailbox_awritev((int)sysboard.arg0,
+                                  (const void *)(long)sysboard.arg1,
+                                  (int)sysboard.arg2);
+            break;
+
+        case NR_mailbox_reserve:
+            ret = mailbox_reserve((int)sysboard.arg0,
+                                  (void **)(long)sysboard.arg1);
+            break;
+
+        case NR_mailbox_commit:
+            ret = mailbox_commit((int)sysboard.arg0);
+            break;
+
+        case NR_mailbox_peek:
+            ret = mailbox_peek((int)sysboard.arg0,
+                               (void **)(long)sysboard.arg1);
+            break;
+
+        case NR_mailbox_release:
+            ret = mailbox_release((int)sysboard.arg0);
+            break;
+
         case NR_portal_create:
             ret = portal_create((int)sysboard.arg0);
             break;
@@ -152,6 +196,83 @@ PUBLIC void vsys_loop(void)
                                 (size_t)sysboard.arg2);
             break;
 
+        case NR_portal_aread_large:
+            ret = portal_aread_large((int)sysboard.arg0,
+                                     (void *)(long)sysboard.arg1,
+                                     (size_t)sysboard.arg2);
+            break;
+
+        case NR_portal_awrite_large:
+            ret = portal_awrite_large((int)sysboard.arg0,
+                                      (const void *)(long)sysboard.arg1,
+                                      (size_t)sysboard.arg2);
+            break;
+
+        case NR_portal_peek:
+            ret = portal_peek((int)sysboard.arg0, (void **)(long)sysboard.arg1);
+            break;
+
+        case NR_portal_release:
+            ret = portal_release((int)sysboard.arg0);
+            break;
+
+        case NR_portal_mopen:
+            ret = portal_mopen((const int *)(long)sysboard.arg0,
+                               (int)sysboard.arg1);
+            break;
+
+        case NR_portal_awritev:
+            ret = portal_awritev(
+                (int)sysboard.arg0,
+                (const struct portal_iovec *)(long)sysboard.arg1,
+                (int)sysboard.arg2);
+            break;
+
+        case NR_portal_areadv:
+            ret = portal_areadv(
+                (int)sysboard.arg0,
+                (const struct portal_iovec *)(long)sysboard.arg1,
+                (int)sysboard.arg2);
+            break;
+
+        case NR_coalesce_create:
+            ret = coalesce_create((int)sysboard.arg0);
+            break;
+
+        case NR_coalesce_open:
+            ret = coalesce_open((int)sysboard.arg0);
+            break;
+
+        case NR_coalesce_unlink:
+            ret = coalesce_unlink((int)sysboard.arg0);
+            break;
+
+        case NR_coalesce_close:
+            ret = coalesce_close((int)sysboard.arg0);
+            break;
+
+        case NR_coalesce_awrite:
+            ret = coalesce_awrite((int)sysboard.arg0,
+                                  (const void *)(long)sysboard.arg1,
+                                  (size_t)sysboard.arg2);
+            break;
+
+        case NR_coalesce_aread:
+            ret = coalesce_aread((int)sysboard.arg0,
+                                 (void *)(long)sysboard.arg1,
+                                 (size_t)sysboard.arg2);
+            break;
+
+        case NR_coalesce_flush:
+            ret = coalesce_flush((int)sysboard.arg0);
+            break;
+
+        case NR_coalesce_ioctl:
+            ret = coalesce_ioctl((int)sysboard.arg0,
+                                 (unsigned)sysboard.arg1,
+                                 (int)sysboard.arg2);
+            break;
+
         default:
             ret = (-EINVAL);
         }
@@ -244,6 +365,46 @@ PUBLIC int vsys_sync_signal(int a)
     return (sysboard.ret);
 }
 
+PUBLIC int vsys_sync_arrive(int a)
+{
+    sysboard.nr_syscall = NR_sync_arrive;
+    sysboard.arg0 = (word_t)a;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_sync_test(int a)
+{
+    sysboard.nr_syscall = NR_sync_test;
+    sysboard.arg0 = (word_t)a;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_sync_await(int a)
+{
+    return (sync_await(a));
+}
+
+PUBLIC int vsys_sync_ioctl(int a, unsigned b, int c)
+{
+    sysboard.nr_syscall = NR_sync_ioctl;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+    sysboard.arg2 = (word_t)c;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
 /*============================================================================*
  * Mailbox Kernel Calls                                                       *
  *============================================================================*/
@@ -318,6 +479,78 @@ PUBLIC int vsys_mailbox_awrite(int a, const void *b, size_t c)
     return (sysboard.ret);
 }
 
+PUBLIC int vsys_mailbox_areadv(int a, void *b, int c)
+{
+    sysboard.nr_syscall = NR_mailbox_areadv;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+    sysboard.arg2 = (word_t)c;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_mailbox_awritev(int a, const void *b, int c)
+{
+    sysboard.nr_syscall = NR_mailbox_awritev;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+    sysboard.arg2 = (word_t)c;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_mailbox_reserve(int a, void **b)
+{
+    sysboard.nr_syscall = NR_mailbox_reserve;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_mailbox_commit(int a)
+{
+    sysboard.nr_syscall = NR_mailbox_commit;
+    sysboard.arg0 = (word_t)a;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_mailbox_peek(int a, void **b)
+{
+    sysboard.nr_syscall = NR_mailbox_peek;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_mailbox_release(int a)
+{
+    sysboard.nr_syscall = NR_mailbox_release;
+    sysboard.arg0 = (word_t)a;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
 PUBLIC int vsys_mailbox_wait(int a)
 {
     return (mailbox_wait(a));
@@ -410,10 +643,195 @@ PUBLIC int vsys_portal_awrite(int a, const void *b, size_t c)
     return (sysboard.ret);
 }
 
+PUBLIC int vsys_portal_aread_large(int a, void *b, size_t c)
+{
+    sysboard.nr_syscall = NR_portal_aread_large;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+    sysboard.arg2 = (word_t)c;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_portal_awrite_large(int a, const void *b, size_t c)
+{
+    sysboard.nr_syscall = NR_portal_awrite_large;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+    sysboard.arg2 = (word_t)c;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_portal_peek(int a, void **b)
+{
+    sysboard.nr_syscall = NR_portal_peek;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_portal_release(int a)
+{
+    sysboard.nr_syscall = NR_portal_release;
+    sysboard.arg0 = (word_t)a;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_portal_mopen(const int *a, int b)
+{
+    sysboard.nr_syscall = NR_portal_mopen;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_portal_awritev(int a, const struct portal_iovec *b, int c)
+{
+    sysboard.nr_syscall = NR_portal_awritev;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+    sysboard.arg2 = (word_t)c;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_portal_areadv(int a, const struct portal_iovec *b, int c)
+{
+    sysboard.nr_syscall = NR_portal_areadv;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+    sysboard.arg2 = (word_t)c;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
 PUBLIC int vsys_portal_wait(int a)
 {
     return (portal_wait(a));
 }
 
+/*============================================================================*
+ * Coalesce Kernel Calls                                                      *
+ *============================================================================*/
+
+PUBLIC int vsys_coalesce_create(int a)
+{
+    sysboard.nr_syscall = NR_coalesce_create;
+    sysboard.arg0 = (word_t)a;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_coalesce_open(int a)
+{
+    sysboard.nr_syscall = NR_coalesce_open;
+    sysboard.arg0 = (word_t)a;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_coalesce_unlink(int a)
+{
+    sysboard.nr_syscall = NR_coalesce_unlink;
+    sysboard.arg0 = (word_t)a;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_coalesce_close(int a)
+{
+    sysboard.nr_syscall = NR_coalesce_close;
+    sysboard.arg0 = (word_t)a;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_coalesce_awrite(int a, const void *b, size_t c)
+{
+    sysboard.nr_syscall = NR_coalesce_awrite;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+    sysboard.arg2 = (word_t)c;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_coalesce_aread(int a, void *b, size_t c)
+{
+    sysboard.nr_syscall = NR_coalesce_aread;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+    sysboard.arg2 = (word_t)c;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_coalesce_flush(int a)
+{
+    sysboard.nr_syscall = NR_coalesce_flush;
+    sysboard.arg0 = (word_t)a;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
+PUBLIC int vsys_coalesce_ioctl(int a, unsigned b, int c)
+{
+    sysboard.nr_syscall = NR_coalesce_ioctl;
+    sysboard.arg0 = (word_t)a;
+    sysboard.arg1 = (word_t)b;
+    sysboard.arg2 = (word_t)c;
+
+    semaphore_up(&master);
+    semaphore_down(&slave);
+
+    return (sysboard.ret);
+}
+
 #endif /* __TARGET_HAS_SYNC && __TARGET_HAS_MAILBOX && __TARGET_HAS_PORTAL &&  \
           !__NANVIX_IKC_USES_ONLY_MAILBOX */
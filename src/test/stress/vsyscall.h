@@ -28,6 +28,9 @@
 #include <nanvix/const.h>
 #include <posix/stddef.h>
 
+/* Forward definitions. */
+struct portal_iovec;
+
 /**
  * @brief Number of system calls.
  *
@@ -61,8 +64,32 @@
 #define NR_portal_awrite 19  /**< portal_awrite()   */
 #define NR_portal_aread 20   /**< portal_aread()    */
 #define NR_portal_wait 21    /**< portal_wait()     */
+#define NR_mailbox_awritev 22 /**< mailbox_awritev() */
+#define NR_mailbox_areadv 23  /**< mailbox_areadv()  */
+#define NR_mailbox_reserve 24 /**< mailbox_reserve() */
+#define NR_mailbox_commit 25  /**< mailbox_commit()  */
+#define NR_mailbox_peek 26    /**< mailbox_peek()    */
+#define NR_mailbox_release 27 /**< mailbox_release() */
+#define NR_portal_awrite_large 28 /**< portal_awrite_large() */
+#define NR_portal_aread_large 29  /**< portal_aread_large()  */
+#define NR_portal_peek 30         /**< portal_peek()         */
+#define NR_portal_release 31      /**< portal_release()      */
+#define NR_portal_awritev 32      /**< portal_awritev()      */
+#define NR_portal_areadv 33       /**< portal_areadv()       */
+#define NR_portal_mopen 34        /**< portal_mopen()        */
+#define NR_sync_ioctl 35          /**< sync_ioctl()          */
+#define NR_sync_arrive 36         /**< sync_arrive()         */
+#define NR_sync_test 37           /**< sync_test()           */
+#define NR_coalesce_create 38     /**< coalesce_create()     */
+#define NR_coalesce_open 39       /**< coalesce_open()       */
+#define NR_coalesce_unlink 40     /**< coalesce_unlink()     */
+#define NR_coalesce_close 41      /**< coalesce_close()      */
+#define NR_coalesce_awrite 42     /**< coalesce_awrite()     */
+#define NR_coalesce_aread 43      /**< coalesce_aread()      */
+#define NR_coalesce_flush 44      /**< coalesce_flush()      */
+#define NR_coalesce_ioctl 45      /**< coalesce_ioctl()      */
 
-#define NR_last_kcall 23 /**< NR_SYSCALLS definer      */
+#define NR_last_kcall 46 /**< NR_SYSCALLS definer      */
 /**@}*/
 
 /*============================================================================*
@@ -83,6 +110,10 @@ EXTERN int vsys_sync_unlink(int);
 EXTERN int vsys_sync_close(int);
 EXTERN int vsys_sync_wait(int);
 EXTERN int vsys_sync_signal(int);
+EXTERN int vsys_sync_ioctl(int, unsigned, int);
+EXTERN int vsys_sync_arrive(int);
+EXTERN int vsys_sync_test(int);
+EXTERN int vsys_sync_await(int);
 
 /*============================================================================*
  * Mailbox Kernel Calls                                                       *
@@ -94,6 +125,12 @@ EXTERN int vsys_mailbox_unlink(int);
 EXTERN int vsys_mailbox_close(int);
 EXTERN int vsys_mailbox_aread(int, void *, size_t);
 EXTERN int vsys_mailbox_awrite(int, const void *, size_t);
+EXTERN int vsys_mailbox_areadv(int, void *, int);
+EXTERN int vsys_mailbox_awritev(int, const void *, int);
+EXTERN int vsys_mailbox_reserve(int, void **);
+EXTERN int vsys_mailbox_commit(int);
+EXTERN int vsys_mailbox_peek(int, void **);
+EXTERN int vsys_mailbox_release(int);
 EXTERN int vsys_mailbox_wait(int);
 
 /*============================================================================*
@@ -107,6 +144,26 @@ EXTERN int vsys_portal_unlink(int);
 EXTERN int vsys_portal_close(int);
 EXTERN int vsys_portal_aread(int, void *, size_t);
 EXTERN int vsys_portal_awrite(int, const void *, size_t);
+EXTERN int vsys_portal_aread_large(int, void *, size_t);
+EXTERN int vsys_portal_awrite_large(int, const void *, size_t);
+EXTERN int vsys_portal_peek(int, void **);
+EXTERN int vsys_portal_release(int);
+EXTERN int vsys_portal_mopen(const int *, int);
+EXTERN int vsys_portal_awritev(int, const struct portal_iovec *, int);
+EXTERN int vsys_portal_areadv(int, const struct portal_iovec *, int);
 EXTERN int vsys_portal_wait(int);
 
+/*============================================================================*
+ * Coalesce Kernel Calls                                                      *
+ *============================================================================*/
+
+EXTERN int vsys_coalesce_create(int);
+EXTERN int vsys_coalesce_open(int);
+EXTERN int vsys_coalesce_unlink(int);
+EXTERN int vsys_coalesce_close(int);
+EXTERN int vsys_coalesce_awrite(int, const void *, size_t);
+EXTERN int vsys_coalesce_aread(int, void *, size_t);
+EXTERN int vsys_coalesce_flush(int);
+EXTERN int vsys_coalesce_ioctl(int, unsigned, int);
+
 #endif /* _VSYSCALL_H_ */
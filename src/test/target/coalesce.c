@@ -0,0 +1,231 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "../test.h"
+#include <nanvix/const.h>
+#include <nanvix/hal/hal.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+
+#if (__HAL_HAS_COALESCE)
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Create and Unlink a Coalesced Mailbox
+ */
+PRIVATE void test_coalesce_create_unlink(void)
+{
+    int mbxid;
+
+    KASSERT((mbxid = coalesce_create(NODENUM_MASTER)) >= 0);
+    KASSERT(coalesce_unlink(mbxid) == 0);
+}
+
+/**
+ * @brief API Test: Open and Close a Coalesced Mailbox
+ */
+PRIVATE void test_coalesce_open_close(void)
+{
+    int mbxid;
+
+    KASSERT((mbxid = coalesce_open(NODENUM_SLAVE)) >= 0);
+    KASSERT(coalesce_flush(mbxid) == 0);
+    KASSERT(coalesce_close(mbxid) == 0);
+}
+
+/**
+ * @brief API Test: Set Thresholds of a Coalesced Mailbox
+ */
+PRIVATE void test_coalesce_thresholds(void)
+{
+    int mbxid;
+
+    KASSERT((mbxid = coalesce_open(NODENUM_SLAVE)) >= 0);
+    KASSERT(coalesce_ioctl(mbxid, COALESCE_IOCTL_SET_THRESHOLD, 1) == 0);
+    KASSERT(coalesce_ioctl(
+                mbxid, COALESCE_IOCTL_SET_THRESHOLD, COALESCE_MSGS_MAX) == 0);
+    KASSERT(coalesce_ioctl(mbxid, COALESCE_IOCTL_SET_DELAY, 0) == 0);
+    KASSERT(coalesce_ioctl(
+                mbxid, COALESCE_IOCTL_SET_DELAY, COALESCE_DELAY_DEFAULT) == 0);
+    KASSERT(coalesce_close(mbxid) == 0);
+}
+
+/**
+ * @brief API Test: Coalesced Mailbox Read Timeout
+ */
+PRIVATE void test_coalesce_read_timeout(void)
+{
+    int mbxid;
+    char msg[HAL_MAILBOX_MSG_SIZE];
+
+    KASSERT((mbxid = coalesce_create(NODENUM_MASTER)) >= 0);
+    KASSERT(mailbox_ioctl(mbxid, HAL_MAILBOX_IOCTL_SET_TIMEOUT, 10) == 0);
+    KASSERT(coalesce_aread(mbxid, msg, HAL_MAILBOX_MSG_SIZE) == -ETIMEDOUT);
+    KASSERT(coalesce_unlink(mbxid) == 0);
+}
+
+/*============================================================================*
+ * Fault Injection Tests                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Fault Injection Test: Invalid Create
+ */
+PRIVATE void test_coalesce_invalid_create(void)
+{
+    KASSERT(coalesce_create(-1) == -EINVAL);
+    KASSERT(coalesce_create(PROCESSOR_NOC_NODES_NUM) == -EINVAL);
+    KASSERT(coalesce_create(NODENUM_SLAVE) == -EINVAL);
+}
+
+/**
+ * @brief Fault Injection Test: Invalid Open
+ */
+PRIVATE void test_coalesce_invalid_open(void)
+{
+    KASSERT(coalesce_open(-1) == -EINVAL);
+    KASSERT(coalesce_open(PROCESSOR_NOC_NODES_NUM) == -EINVAL);
+    KASSERT(coalesce_open(NODENUM_MASTER) == -EINVAL);
+}
+
+/**
+ * @brief Fault Injection Test: Bad Unlink and Close
+ */
+PRIVATE void test_coalesce_bad_unlink_close(void)
+{
+    int mbxid;
+
+    KASSERT(coalesce_unlink(-1) == -EBADF);
+    KASSERT(coalesce_close(-1) == -EBADF);
+
+    /* Double unlink. */
+    KASSERT((mbxid = coalesce_create(NODENUM_MASTER)) >= 0);
+    KASSERT(coalesce_unlink(mbxid) == 0);
+    KASSERT(coalesce_unlink(mbxid) == -EBADF);
+
+    /* Double close. */
+    KASSERT((mbxid = coalesce_open(NODENUM_SLAVE)) >= 0);
+    KASSERT(coalesce_close(mbxid) == 0);
+    KASSERT(coalesce_close(mbxid) == -EBADF);
+    KASSERT(coalesce_flush(mbxid) == -EBADF);
+}
+
+/**
+ * @brief Fault Injection Test: Invalid Read and Write
+ */
+PRIVATE void test_coalesce_invalid_read_write(void)
+{
+    int mbxid;
+    char msg[HAL_MAILBOX_MSG_SIZE];
+
+    KASSERT(coalesce_aread(-1, msg, HAL_MAILBOX_MSG_SIZE) == -EBADF);
+    KASSERT(coalesce_awrite(-1, msg, HAL_MAILBOX_MSG_SIZE) == -EBADF);
+
+    KASSERT((mbxid = coalesce_create(NODENUM_MASTER)) >= 0);
+    KASSERT(coalesce_aread(mbxid, NULL, HAL_MAILBOX_MSG_SIZE) == -EINVAL);
+    KASSERT(coalesce_aread(mbxid, msg, 0) == -EINVAL);
+    KASSERT(coalesce_unlink(mbxid) == 0);
+
+    KASSERT((mbxid = coalesce_open(NODENUM_SLAVE)) >= 0);
+    KASSERT(coalesce_awrite(mbxid, NULL, HAL_MAILBOX_MSG_SIZE) == -EINVAL);
+    KASSERT(coalesce_awrite(mbxid, msg, 0) == -EINVAL);
+    KASSERT(coalesce_close(mbxid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Bad Thresholds
+ */
+PRIVATE void test_coalesce_bad_thresholds(void)
+{
+    int mbxid;
+
+    KASSERT(coalesce_ioctl(-1, COALESCE_IOCTL_SET_DELAY, 0) == -EBADF);
+
+    KASSERT((mbxid = coalesce_open(NODENUM_SLAVE)) >= 0);
+    KASSERT(coalesce_ioctl(mbxid, COALESCE_IOCTL_SET_THRESHOLD, 0) == -EINVAL);
+    KASSERT(coalesce_ioctl(
+                mbxid, COALESCE_IOCTL_SET_THRESHOLD, COALESCE_MSGS_MAX + 1) ==
+            -EINVAL);
+    KASSERT(coalesce_ioctl(mbxid, COALESCE_IOCTL_SET_DELAY, -1) == -EINVAL);
+    KASSERT(coalesce_ioctl(mbxid, -1) == -EINVAL);
+    KASSERT(coalesce_close(mbxid) == 0);
+}
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test coalesce_tests_api[] = {
+    {test_coalesce_create_unlink, "create unlink"},
+    {test_coalesce_open_close, "open close   "},
+    {test_coalesce_thresholds, "thresholds   "},
+    {test_coalesce_read_timeout, "read timeout "},
+    {NULL, NULL},
+};
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test coalesce_tests_fault[] = {
+    {test_coalesce_invalid_create, "invalid create    "},
+    {test_coalesce_invalid_open, "invalid open      "},
+    {test_coalesce_bad_unlink_close, "bad unlink close  "},
+    {test_coalesce_invalid_read_write, "invalid read write"},
+    {test_coalesce_bad_thresholds, "bad thresholds    "},
+    {NULL, NULL},
+};
+
+#endif /* __HAL_HAS_COALESCE */
+
+/**
+ * The test_coalesce() function launches testing units on the
+ * coalescing interface of the HAL.
+ */
+PUBLIC void test_coalesce(void)
+{
+#if (__HAL_HAS_COALESCE)
+    /* API Tests */
+    kprintf(HLINE);
+    for (int i = 0; coalesce_tests_api[i].test_fn != NULL; i++) {
+        coalesce_tests_api[i].test_fn();
+        kprintf("[test][api][coalesce] %s [passed]",
+                coalesce_tests_api[i].name);
+    }
+
+    /* FAULT Tests */
+    kprintf(HLINE);
+    for (int i = 0; coalesce_tests_fault[i].test_fn != NULL; i++) {
+        coalesce_tests_fault[i].test_fn();
+        kprintf("[test][fault][coalesce] %s [passed]",
+                coalesce_tests_fault[i].name);
+    }
+#endif /* __HAL_HAS_COALESCE */
+}
@@ -56,6 +56,107 @@ PRIVATE void test_mailbox_open_close(void)
     KASSERT(mailbox_close(mbxid) == 0);
 }
 
+/**
+ * @brief API Test: Mailbox Read Timeout
+ */
+PRIVATE void test_mailbox_read_timeout(void)
+{
+    int mbxid;
+    char msg[HAL_MAILBOX_MSG_SIZE];
+
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+    KASSERT(mailbox_ioctl(mbxid, HAL_MAILBOX_IOCTL_SET_TIMEOUT, 10) == 0);
+    KASSERT(mailbox_aread(mbxid, msg, HAL_MAILBOX_MSG_SIZE) == -ETIMEDOUT);
+    KASSERT(mailbox_unlink(mbxid) == 0);
+}
+
+/**
+ * @brief API Test: Mailbox Short Read Timeout
+ */
+PRIVATE void test_mailbox_short_read_timeout(void)
+{
+    int mbxid;
+    char msg[16];
+
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+    KASSERT(mailbox_ioctl(mbxid, HAL_MAILBOX_IOCTL_SET_TIMEOUT, 10) == 0);
+    KASSERT(mailbox_aread(mbxid, msg, sizeof(msg)) == -ETIMEDOUT);
+    KASSERT(mailbox_unlink(mbxid) == 0);
+}
+
+/**
+ * @brief API Test: Mailbox Peek Timeout
+ */
+PRIVATE void test_mailbox_peek_timeout(void)
+{
+    int mbxid;
+    void *msg;
+
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+    KASSERT(mailbox_ioctl(mbxid, HAL_MAILBOX_IOCTL_SET_TIMEOUT, 10) == 0);
+    KASSERT(mailbox_peek(mbxid, &msg) == -ETIMEDOUT);
+    KASSERT(mailbox_release(mbxid) == -EINVAL);
+    KASSERT(mailbox_unlink(mbxid) == 0);
+}
+
+/**
+ * @brief API Test: Mailbox Try Read
+ */
+PRIVATE void test_mailbox_read_try(void)
+{
+    int mbxid;
+    char msg[HAL_MAILBOX_MSG_SIZE];
+
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+    KASSERT(mailbox_ioctl(
+                mbxid, HAL_MAILBOX_IOCTL_SET_TIMEOUT, HAL_MAILBOX_TIMEOUT_TRY) ==
+            0);
+    KASSERT(mailbox_aread(mbxid, msg, HAL_MAILBOX_MSG_SIZE) == -ETIMEDOUT);
+    KASSERT(mailbox_ioctl(mbxid,
+                          HAL_MAILBOX_IOCTL_SET_TIMEOUT,
+                          HAL_MAILBOX_TIMEOUT_INFINITE) == 0);
+    KASSERT(mailbox_unlink(mbxid) == 0);
+}
+
+/**
+ * @brief API Test: Mailbox Set Priority
+ */
+PRIVATE void test_mailbox_set_priority(void)
+{
+    int mbxid;
+
+    KASSERT((mbxid = mailbox_open(NODENUM_SLAVE)) >= 0);
+    KASSERT(mailbox_ioctl(mbxid,
+                          HAL_MAILBOX_IOCTL_SET_PRIORITY,
+                          HAL_MAILBOX_PRIORITY_HIGH) == 0);
+    KASSERT(mailbox_ioctl(mbxid,
+                          HAL_MAILBOX_IOCTL_SET_PRIORITY,
+                          HAL_MAILBOX_PRIORITY_LOW) == 0);
+    KASSERT(mailbox_ioctl(mbxid,
+                          HAL_MAILBOX_IOCTL_SET_PRIORITY,
+                          HAL_MAILBOX_PRIORITY_NORMAL) == 0);
+    KASSERT(mailbox_close(mbxid) == 0);
+}
+
+/**
+ * @brief API Test: Mailbox Credits
+ */
+PRIVATE void test_mailbox_credits(void)
+{
+    int mbxid;
+    int ncredits;
+
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+    KASSERT(mailbox_ioctl(mbxid, HAL_MAILBOX_IOCTL_SET_CREDITS, 1) == 0);
+    KASSERT(mailbox_unlink(mbxid) == 0);
+
+    KASSERT((mbxid = mailbox_open(NODENUM_SLAVE)) >= 0);
+    KASSERT(mailbox_ioctl(mbxid, HAL_MAILBOX_IOCTL_GET_CREDITS, &ncredits) ==
+            0);
+    KASSERT(ncredits >= 0);
+    KASSERT(mailbox_close(mbxid) == 0);
+}
+
 /*============================================================================*
  * Fault Injection Tests                                                      *
  *============================================================================*/
@@ -110,6 +211,8 @@ PRIVATE void test_mailbox_invalid_read(void)
 
     KASSERT(mailbox_aread(mbxid, NULL, HAL_MAILBOX_MSG_SIZE) == -EINVAL);
     KASSERT(mailbox_aread(mbxid, msg, 0) == -EINVAL);
+    KASSERT(mailbox_aread(mbxid, msg, HAL_MAILBOX_MSG_SIZE_MAX + 1) ==
+            -EINVAL);
 
     KASSERT(mailbox_unlink(mbxid) == 0);
 }
@@ -129,6 +232,85 @@ PRIVATE void test_mailbox_invalid_write(void)
 
     KASSERT(mailbox_awrite(mbxid, NULL, HAL_MAILBOX_MSG_SIZE) == -EINVAL);
     KASSERT(mailbox_awrite(mbxid, msg, 0) == -EINVAL);
+    KASSERT(mailbox_awrite(mbxid, msg, HAL_MAILBOX_MSG_SIZE_MAX + 1) ==
+            -EINVAL);
+
+    KASSERT(mailbox_close(mbxid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Mailbox Invalid Batch Read
+ */
+PRIVATE void test_mailbox_invalid_readv(void)
+{
+    int mbxid;
+    char msgs[2 * HAL_MAILBOX_MSG_SIZE];
+
+    KASSERT(mailbox_areadv(-1, msgs, 2) == -EBADF);
+
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+
+    KASSERT(mailbox_areadv(mbxid, NULL, 2) == -EINVAL);
+    KASSERT(mailbox_areadv(mbxid, msgs, 0) == -EINVAL);
+    KASSERT(mailbox_areadv(mbxid, msgs, -1) == -EINVAL);
+
+    KASSERT(mailbox_unlink(mbxid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Mailbox Invalid Batch Write
+ */
+PRIVATE void test_mailbox_invalid_writev(void)
+{
+    int mbxid;
+    char msgs[2 * HAL_MAILBOX_MSG_SIZE];
+    kmemset(msgs, 0, 2 * HAL_MAILBOX_MSG_SIZE);
+
+    KASSERT(mailbox_awritev(-1, msgs, 2) == -EBADF);
+
+    KASSERT((mbxid = mailbox_open(NODENUM_SLAVE)) >= 0);
+
+    KASSERT(mailbox_awritev(mbxid, NULL, 2) == -EINVAL);
+    KASSERT(mailbox_awritev(mbxid, msgs, 0) == -EINVAL);
+    KASSERT(mailbox_awritev(mbxid, msgs, -1) == -EINVAL);
+
+    KASSERT(mailbox_close(mbxid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Mailbox Invalid Peek
+ */
+PRIVATE void test_mailbox_invalid_peek(void)
+{
+    int mbxid;
+    void *msg;
+
+    KASSERT(mailbox_peek(-1, &msg) == -EBADF);
+    KASSERT(mailbox_release(-1) == -EBADF);
+
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+
+    KASSERT(mailbox_peek(mbxid, NULL) == -EINVAL);
+    KASSERT(mailbox_release(mbxid) == -EINVAL);
+
+    KASSERT(mailbox_unlink(mbxid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Mailbox Invalid Reserve
+ */
+PRIVATE void test_mailbox_invalid_reserve(void)
+{
+    int mbxid;
+    void *msg;
+
+    KASSERT(mailbox_reserve(-1, &msg) == -EBADF);
+    KASSERT(mailbox_commit(-1) == -EBADF);
+
+    KASSERT((mbxid = mailbox_open(NODENUM_SLAVE)) >= 0);
+
+    KASSERT(mailbox_reserve(mbxid, NULL) == -EINVAL);
+    KASSERT(mailbox_commit(mbxid) == -EINVAL);
 
     KASSERT(mailbox_close(mbxid) == 0);
 }
@@ -223,6 +405,64 @@ PRIVATE void test_mailbox_bad_write(void)
     KASSERT(mailbox_close(mbxid) == 0);
 }
 
+/**
+ * @brief Fault Injection Test: Mailbox Bad Timeout
+ */
+PRIVATE void test_mailbox_bad_timeout(void)
+{
+    int mbxid;
+
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+    KASSERT(mailbox_ioctl(mbxid, HAL_MAILBOX_IOCTL_SET_TIMEOUT, -2) == -EINVAL);
+    KASSERT(mailbox_unlink(mbxid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Mailbox Bad Priority
+ */
+PRIVATE void test_mailbox_bad_priority(void)
+{
+    int mbxid;
+
+    /* Input mailboxes do not send messages. */
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+    KASSERT(mailbox_ioctl(mbxid,
+                          HAL_MAILBOX_IOCTL_SET_PRIORITY,
+                          HAL_MAILBOX_PRIORITY_HIGH) == -EBADF);
+    KASSERT(mailbox_unlink(mbxid) == 0);
+
+    KASSERT((mbxid = mailbox_open(NODENUM_SLAVE)) >= 0);
+    KASSERT(mailbox_ioctl(mbxid, HAL_MAILBOX_IOCTL_SET_PRIORITY, -1) ==
+            -EINVAL);
+    KASSERT(mailbox_ioctl(mbxid,
+                          HAL_MAILBOX_IOCTL_SET_PRIORITY,
+                          HAL_MAILBOX_PRIORITY_HIGH + 1) == -EINVAL);
+    KASSERT(mailbox_close(mbxid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Mailbox Bad Credits
+ */
+PRIVATE void test_mailbox_bad_credits(void)
+{
+    int mbxid;
+    int ncredits;
+
+    /* Input mailboxes do not spend credits. */
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+    KASSERT(mailbox_ioctl(mbxid, HAL_MAILBOX_IOCTL_SET_CREDITS, 0) == -EINVAL);
+    KASSERT(mailbox_ioctl(mbxid, HAL_MAILBOX_IOCTL_GET_CREDITS, &ncredits) ==
+            -EBADF);
+    KASSERT(mailbox_unlink(mbxid) == 0);
+
+    /* Output mailboxes do not grant credits. */
+    KASSERT((mbxid = mailbox_open(NODENUM_SLAVE)) >= 0);
+    KASSERT(mailbox_ioctl(mbxid, HAL_MAILBOX_IOCTL_SET_CREDITS, 1) == -EBADF);
+    KASSERT(mailbox_ioctl(mbxid, HAL_MAILBOX_IOCTL_GET_CREDITS, NULL) ==
+            -EINVAL);
+    KASSERT(mailbox_close(mbxid) == 0);
+}
+
 /*============================================================================*
  * Test Driver                                                                *
  *============================================================================*/
@@ -234,6 +474,12 @@ PRIVATE struct test mailbox_tests_api[] = {
     /* Intra-Cluster API Tests */
     {test_mailbox_create_unlink, "create unlink"},
     {test_mailbox_open_close, "open close   "},
+    {test_mailbox_read_timeout, "read timeout "},
+    {test_mailbox_short_read_timeout, "short read   "},
+    {test_mailbox_peek_timeout, "peek timeout "},
+    {test_mailbox_read_try, "read try     "},
+    {test_mailbox_set_priority, "set priority "},
+    {test_mailbox_credits, "credits      "},
     {NULL, NULL},
 };
 
@@ -247,6 +493,10 @@ PRIVATE struct test mailbox_tests_fault[] = {
     {test_mailbox_invalid_close, "invalid close "},
     {test_mailbox_invalid_read, "invalid read  "},
     {test_mailbox_invalid_write, "invalid write "},
+    {test_mailbox_invalid_readv, "invalid readv "},
+    {test_mailbox_invalid_writev, "invalid writev"},
+    {test_mailbox_invalid_peek, "invalid peek  "},
+    {test_mailbox_invalid_reserve, "invalid commit"},
     {test_mailbox_bad_create, "bad create    "},
     {test_mailbox_bad_open, "bad open      "},
     {test_mailbox_bad_unlink, "bad unlink    "},
@@ -255,6 +505,9 @@ PRIVATE struct test mailbox_tests_fault[] = {
     {test_mailbox_double_close, "double close  "},
     {test_mailbox_bad_read, "bad read      "},
     {test_mailbox_bad_write, "bad write     "},
+    {test_mailbox_bad_timeout, "bad timeout   "},
+    {test_mailbox_bad_priority, "bad priority  "},
+    {test_mailbox_bad_credits, "bad credits   "},
     {NULL, NULL},
 };
 
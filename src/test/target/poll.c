@@ -0,0 +1,213 @@
+/*
+ * MIT License
+ *
+ * Copyright(c) 2011-2020 The Maintainers of Nanvix
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "../test.h"
+#include <nanvix/const.h>
+#include <nanvix/hal/hal.h>
+#include <nanvix/hlib.h>
+#include <posix/errno.h>
+
+#if (__TARGET_HAS_POLL && __TARGET_HAS_MAILBOX)
+
+/*============================================================================*
+ * API Tests                                                                  *
+ *============================================================================*/
+
+/**
+ * @brief API Test: Poll Mailbox
+ */
+PRIVATE void test_poll_mailbox(void)
+{
+    int mbxid;
+    struct ikc_pollfd fds[1];
+
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+
+    fds[0].type = IKC_MAILBOX;
+    fds[0].id = mbxid;
+    fds[0].events = IKC_POLLIN;
+
+    /* Nothing to read. */
+    KASSERT(ikc_poll(fds, 1, 0) == 0);
+    KASSERT(fds[0].revents == 0);
+    KASSERT(ikc_poll(fds, 1, 10) == 0);
+    KASSERT(fds[0].revents == 0);
+
+    KASSERT(mailbox_unlink(mbxid) == 0);
+}
+
+#if (__TARGET_HAS_SYNC && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+
+/**
+ * @brief API Test: Poll Many Endpoints
+ */
+PRIVATE void test_poll_many(void)
+{
+    int mbxid;
+    int syncid;
+    int nodes[NODES_AMOUNT];
+    struct ikc_pollfd fds[2];
+
+    nodes[0] = NODENUM_SLAVE;
+    nodes[1] = NODENUM_MASTER;
+
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+    KASSERT((syncid = sync_open(nodes, NODES_AMOUNT, SYNC_ALL_TO_ONE)) >= 0);
+
+    fds[0].type = IKC_MAILBOX;
+    fds[0].id = mbxid;
+    fds[0].events = IKC_POLLIN;
+    fds[1].type = IKC_SYNC;
+    fds[1].id = syncid;
+    fds[1].events = IKC_POLLOUT;
+
+    /* Nothing pending on the sync. */
+    KASSERT(ikc_poll(fds, 2, -1) == 1);
+    KASSERT(fds[0].revents == 0);
+    KASSERT(fds[1].revents == IKC_POLLOUT);
+
+    KASSERT(sync_close(syncid) == 0);
+    KASSERT(mailbox_unlink(mbxid) == 0);
+}
+
+#endif
+
+/*============================================================================*
+ * Fault Injection Tests                                                      *
+ *============================================================================*/
+
+/**
+ * @brief Fault Injection Test: Poll Invalid Set
+ */
+PRIVATE void test_poll_invalid_set(void)
+{
+    struct ikc_pollfd fds[1];
+
+    fds[0].type = IKC_MAILBOX;
+    fds[0].id = 0;
+    fds[0].events = IKC_POLLIN;
+
+    KASSERT(ikc_poll(NULL, 1, 0) == -EINVAL);
+    KASSERT(ikc_poll(fds, 0, 0) == -EINVAL);
+    KASSERT(ikc_poll(fds, -1, 0) == -EINVAL);
+    KASSERT(ikc_poll(fds, IKC_POLL_MAX + 1, 0) == -EINVAL);
+}
+
+/**
+ * @brief Fault Injection Test: Poll Invalid Endpoint
+ */
+PRIVATE void test_poll_invalid_endpoint(void)
+{
+    int mbxid;
+    struct ikc_pollfd fds[1];
+
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+
+    /* Invalid type. */
+    fds[0].type = -1;
+    fds[0].id = mbxid;
+    fds[0].events = IKC_POLLIN;
+    KASSERT(ikc_poll(fds, 1, 0) == -EINVAL);
+
+    /* Invalid events. */
+    fds[0].type = IKC_MAILBOX;
+    fds[0].events = 0;
+    KASSERT(ikc_poll(fds, 1, 0) == -EINVAL);
+    fds[0].events = ~(IKC_POLLIN | IKC_POLLOUT);
+    KASSERT(ikc_poll(fds, 1, 0) == -EINVAL);
+
+    KASSERT(mailbox_unlink(mbxid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Poll Bad Endpoint
+ */
+PRIVATE void test_poll_bad_endpoint(void)
+{
+    int mbxid;
+    struct ikc_pollfd fds[1];
+
+    fds[0].type = IKC_MAILBOX;
+    fds[0].events = IKC_POLLIN;
+
+    /* Invalid ID. */
+    fds[0].id = -1;
+    KASSERT(ikc_poll(fds, 1, 0) == -EBADF);
+
+    /* Unlinked mailbox. */
+    KASSERT((mbxid = mailbox_create(NODENUM_MASTER)) >= 0);
+    KASSERT(mailbox_unlink(mbxid) == 0);
+    fds[0].id = mbxid;
+    KASSERT(ikc_poll(fds, 1, 0) == -EBADF);
+}
+
+/*============================================================================*
+ * Test Driver                                                                *
+ *============================================================================*/
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test poll_tests_api[] = {
+    {test_poll_mailbox, "poll mailbox"},
+#if (__TARGET_HAS_SYNC && !__NANVIX_IKC_USES_ONLY_MAILBOX)
+    {test_poll_many, "poll many   "},
+#endif
+    {NULL, NULL},
+};
+
+/**
+ * @brief Unit tests.
+ */
+PRIVATE struct test poll_tests_fault[] = {
+    {test_poll_invalid_set, "invalid set     "},
+    {test_poll_invalid_endpoint, "invalid endpoint"},
+    {test_poll_bad_endpoint, "bad endpoint    "},
+    {NULL, NULL},
+};
+
+#endif /* __TARGET_HAS_POLL && __TARGET_HAS_MAILBOX */
+
+/**
+ * The test_poll() function launches testing units on the poll
+ * interface of the HAL.
+ */
+PUBLIC void test_poll(void)
+{
+#if (__TARGET_HAS_POLL && __TARGET_HAS_MAILBOX)
+    /* API Tests */
+    kprintf(HLINE);
+    for (int i = 0; poll_tests_api[i].test_fn != NULL; i++) {
+        poll_tests_api[i].test_fn();
+        kprintf("[test][api][poll] %s [passed]", poll_tests_api[i].name);
+    }
+
+    /* FAULT Tests */
+    kprintf(HLINE);
+    for (int i = 0; poll_tests_fault[i].test_fn != NULL; i++) {
+        poll_tests_fault[i].test_fn();
+        kprintf("[test][fault][poll] %s [passed]", poll_tests_fault[i].name);
+    }
+#endif /* __TARGET_HAS_POLL && __TARGET_HAS_MAILBOX */
+}
@@ -61,6 +61,22 @@ PRIVATE void test_portal_open_close(void)
     KASSERT(portal_close(portalid) == 0);
 }
 
+/**
+ * @brief API Test: Portal Multicast Open Close
+ */
+PRIVATE void test_portal_mopen_close(void)
+{
+    int portalid;
+    int nodes[2] = {NODENUM_MASTER, NODENUM_SLAVE};
+
+    KASSERT((portalid = portal_mopen(nodes, 2)) >= 0);
+
+    /* Remote NoC node is already reached by the multicast portal. */
+    KASSERT(portal_open(NODENUM_MASTER, NODENUM_SLAVE) == -EEXIST);
+
+    KASSERT(portal_close(portalid) == 0);
+}
+
 /**
  * @brief API Test: Portal Allow
  */
@@ -75,6 +91,41 @@ PRIVATE void test_portal_allow(void)
     KASSERT(portal_unlink(portalid) == 0);
 }
 
+/**
+ * @brief API Test: Portal Read Timeout
+ */
+PRIVATE void test_portal_read_timeout(void)
+{
+    int portalid;
+    char buf[HAL_PORTAL_MAX_SIZE];
+
+    KASSERT((portalid = portal_create(NODENUM_MASTER)) >= 0);
+    KASSERT(portal_ioctl(portalid, HAL_PORTAL_IOCTL_SET_TIMEOUT, 10) == 0);
+    KASSERT(portal_allow(portalid, NODENUM_SLAVE) == 0);
+    KASSERT(portal_aread(portalid, buf, HAL_PORTAL_MAX_SIZE) == -ETIMEDOUT);
+    KASSERT(portal_unlink(portalid) == 0);
+}
+
+/**
+ * @brief API Test: Portal Try Read
+ */
+PRIVATE void test_portal_read_try(void)
+{
+    int portalid;
+    char buf[HAL_PORTAL_MAX_SIZE];
+
+    KASSERT((portalid = portal_create(NODENUM_MASTER)) >= 0);
+    KASSERT(portal_ioctl(portalid,
+                         HAL_PORTAL_IOCTL_SET_TIMEOUT,
+                         HAL_PORTAL_TIMEOUT_TRY) == 0);
+    KASSERT(portal_allow(portalid, NODENUM_SLAVE) == 0);
+    KASSERT(portal_aread(portalid, buf, HAL_PORTAL_MAX_SIZE) == -ETIMEDOUT);
+    KASSERT(portal_ioctl(portalid,
+                         HAL_PORTAL_IOCTL_SET_TIMEOUT,
+                         HAL_PORTAL_TIMEOUT_INFINITE) == 0);
+    KASSERT(portal_unlink(portalid) == 0);
+}
+
 /*============================================================================*
  * Fault Injection Tests                                                      *
  *============================================================================*/
@@ -103,6 +154,27 @@ PRIVATE void test_portal_invalid_open(void)
     KASSERT(portal_open(NODENUM_MASTER, PROCESSOR_NOC_NODES_NUM) == -EINVAL);
 }
 
+/**
+ * @brief Fault Injection Test: Portal Invalid Multicast Open
+ */
+PRIVATE void test_portal_invalid_mopen(void)
+{
+    int nodes[2] = {NODENUM_MASTER, NODENUM_SLAVE};
+
+    /* Invalid nodes list. */
+    KASSERT(portal_mopen(NULL, 2) == -EINVAL);
+    KASSERT(portal_mopen(nodes, -1) == -EINVAL);
+    KASSERT(portal_mopen(nodes, 0) == -EINVAL);
+    KASSERT(portal_mopen(nodes, 1) == -EINVAL);
+    KASSERT(portal_mopen(nodes, PROCESSOR_NOC_NODES_NUM + 1) == -EINVAL);
+
+    /* Invalid remote NoC node. */
+    nodes[1] = -1;
+    KASSERT(portal_mopen(nodes, 2) == -EINVAL);
+    nodes[1] = PROCESSOR_NOC_NODES_NUM;
+    KASSERT(portal_mopen(nodes, 2) == -EINVAL);
+}
+
 /**
  * @brief Fault Injection Test: Portal Invalid Allow
  */
@@ -194,6 +266,148 @@ PRIVATE void test_portal_invalid_write(void)
     KASSERT(portal_close(portalid) == 0);
 }
 
+/**
+ * @brief Fault Injection Test: Portal Invalid Large Read
+ */
+PRIVATE void test_portal_invalid_read_large(void)
+{
+    int portalid;
+    char buf[PORTAL_SIZE];
+
+    /* Invalid portal ID */
+    KASSERT(portal_aread_large(-1, buf, PORTAL_SIZE) == -EBADF);
+    KASSERT(portal_aread_large(HAL_PORTAL_CREATE_MAX, buf, PORTAL_SIZE) ==
+            -EBADF);
+
+    KASSERT((portalid = portal_create(NODENUM_MASTER)) >= 0);
+
+    /* Invalid buffer. */
+    KASSERT(portal_aread_large(portalid, NULL, PORTAL_SIZE) == -EINVAL);
+
+    /* Invalid buffer size. */
+    KASSERT(portal_aread_large(portalid, buf, 0) == -EINVAL);
+
+    /* Not allowed. */
+    KASSERT(portal_aread_large(portalid, buf, PORTAL_SIZE) == -EBADF);
+
+    KASSERT(portal_unlink(portalid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Portal Invalid Large Write
+ */
+PRIVATE void test_portal_invalid_write_large(void)
+{
+    int portalid;
+    char buf[PORTAL_SIZE];
+    kmemset(buf, 0, PORTAL_SIZE);
+
+    /* Invalid portal ID */
+    KASSERT(portal_awrite_large(-1, buf, PORTAL_SIZE) == -EBADF);
+    KASSERT(portal_awrite_large(HAL_PORTAL_OPEN_MAX, buf, PORTAL_SIZE) ==
+            -EBADF);
+
+    KASSERT((portalid = portal_open(NODENUM_MASTER, NODENUM_SLAVE)) >= 0);
+
+    /* Invalid buffer. */
+    KASSERT(portal_awrite_large(portalid, NULL, PORTAL_SIZE) == -EINVAL);
+
+    /* Invalid buffer size. */
+    KASSERT(portal_awrite_large(portalid, buf, 0) == -EINVAL);
+
+    KASSERT(portal_close(portalid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Portal Invalid Scatter Read
+ */
+PRIVATE void test_portal_invalid_readv(void)
+{
+    int portalid;
+    char buf[PORTAL_SIZE];
+    struct portal_iovec iov[2] = {{buf, PORTAL_SIZE / 2}, {NULL, 0}};
+
+    /* Invalid portal ID */
+    KASSERT(portal_areadv(-1, iov, 1) == -EBADF);
+    KASSERT(portal_areadv(HAL_PORTAL_CREATE_MAX, iov, 1) == -EBADF);
+
+    KASSERT((portalid = portal_create(NODENUM_MASTER)) >= 0);
+
+    /* Invalid segments. */
+    KASSERT(portal_areadv(portalid, NULL, 1) == -EINVAL);
+    KASSERT(portal_areadv(portalid, iov, 0) == -EINVAL);
+    KASSERT(portal_areadv(portalid, iov, HAL_PORTAL_IOV_MAX + 1) == -EINVAL);
+
+    /* Invalid segment. */
+    iov[1].len = PORTAL_SIZE / 2;
+    KASSERT(portal_areadv(portalid, iov, 2) == -EINVAL);
+
+    /* Invalid size. */
+    iov[0].len = 0;
+    KASSERT(portal_areadv(portalid, iov, 1) == -EINVAL);
+
+    KASSERT(portal_unlink(portalid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Portal Invalid Gather Write
+ */
+PRIVATE void test_portal_invalid_writev(void)
+{
+    int portalid;
+    char buf[PORTAL_SIZE];
+    struct portal_iovec iov[2] = {{buf, PORTAL_SIZE / 2}, {NULL, 0}};
+
+    /* Invalid portal ID */
+    KASSERT(portal_awritev(-1, iov, 1) == -EBADF);
+    KASSERT(portal_awritev(HAL_PORTAL_OPEN_MAX, iov, 1) == -EBADF);
+
+    KASSERT((portalid = portal_open(NODENUM_MASTER, NODENUM_SLAVE)) >= 0);
+
+    /* Invalid segments. */
+    KASSERT(portal_awritev(portalid, NULL, 1) == -EINVAL);
+    KASSERT(portal_awritev(portalid, iov, 0) == -EINVAL);
+    KASSERT(portal_awritev(portalid, iov, HAL_PORTAL_IOV_MAX + 1) == -EINVAL);
+
+    /* Invalid segment. */
+    iov[1].len = PORTAL_SIZE / 2;
+    KASSERT(portal_awritev(portalid, iov, 2) == -EINVAL);
+
+    /* Invalid size. */
+    iov[0].len = 0;
+    KASSERT(portal_awritev(portalid, iov, 1) == -EINVAL);
+
+    KASSERT(portal_close(portalid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Portal Invalid Peek
+ */
+PRIVATE void test_portal_invalid_peek(void)
+{
+    int portalid;
+    void *buf;
+
+    /* Invalid portal ID */
+    KASSERT(portal_peek(-1, &buf) == -EBADF);
+    KASSERT(portal_peek(HAL_PORTAL_CREATE_MAX, &buf) == -EBADF);
+    KASSERT(portal_release(-1) == -EBADF);
+    KASSERT(portal_release(HAL_PORTAL_CREATE_MAX) == -EBADF);
+
+    KASSERT((portalid = portal_create(NODENUM_MASTER)) >= 0);
+
+    /* Invalid buffer. */
+    KASSERT(portal_peek(portalid, NULL) == -EINVAL);
+
+    /* Not allowed. */
+    KASSERT(portal_peek(portalid, &buf) == -EBADF);
+
+    /* Nothing peeked. */
+    KASSERT(portal_release(portalid) == -EINVAL);
+
+    KASSERT(portal_unlink(portalid) == 0);
+}
+
 /**
  * @brief Fault Injection Test: Portal Bad Create
  */
@@ -215,6 +429,28 @@ PRIVATE void test_portal_bad_open(void)
     KASSERT(portal_open(NODENUM_MASTER, NODENUM_MASTER) == -EINVAL);
 }
 
+/**
+ * @brief Fault Injection Test: Portal Bad Multicast Open
+ */
+PRIVATE void test_portal_bad_mopen(void)
+{
+    int portalid;
+    int nodes[2] = {NODENUM_SLAVE, NODENUM_MASTER};
+
+    /* Bad local NoC node. */
+    KASSERT(portal_mopen(nodes, 2) == -EINVAL);
+
+    /* Bad remote NoC node. */
+    nodes[0] = NODENUM_MASTER;
+    KASSERT(portal_mopen(nodes, 2) == -EINVAL);
+
+    /* Multicast portal exists. */
+    nodes[1] = NODENUM_SLAVE;
+    KASSERT((portalid = portal_mopen(nodes, 2)) >= 0);
+    KASSERT(portal_mopen(nodes, 2) == -EEXIST);
+    KASSERT(portal_close(portalid) == 0);
+}
+
 /**
  * @brief Fault Injection Test: Portal Bad Allow
  */
@@ -293,6 +529,18 @@ PRIVATE void test_portal_double_allow(void)
     KASSERT(portal_unlink(portalid) == 0);
 }
 
+/**
+ * @brief Fault Injection Test: Portal Bad Timeout
+ */
+PRIVATE void test_portal_bad_timeout(void)
+{
+    int portalid;
+
+    KASSERT((portalid = portal_create(NODENUM_MASTER)) >= 0);
+    KASSERT(portal_ioctl(portalid, HAL_PORTAL_IOCTL_SET_TIMEOUT, -2) == -EINVAL);
+    KASSERT(portal_unlink(portalid) == 0);
+}
+
 #endif /* __TARGET_HAS_PORTAL && !__NANVIX_IKC_USES_ONLY_MAILBOX */
 
 /*============================================================================*
@@ -307,7 +555,10 @@ PRIVATE void test_portal_double_allow(void)
 PRIVATE struct test portal_tests_api[] = {
     {test_portal_create_unlink, "create unlink"},
     {test_portal_open_close, "open close   "},
+    {test_portal_mopen_close, "mopen close  "},
     {test_portal_allow, "open allow   "},
+    {test_portal_read_timeout, "read timeout "},
+    {test_portal_read_try, "read try     "},
     {NULL, NULL},
 };
 
@@ -317,19 +568,27 @@ PRIVATE struct test portal_tests_api[] = {
 PRIVATE struct test portal_tests_fault[] = {
     {test_portal_invalid_create, "invalid create"},
     {test_portal_invalid_open, "invalid open  "},
+    {test_portal_invalid_mopen, "invalid mopen "},
     {test_portal_invalid_allow, "invalid allow "},
     {test_portal_invalid_unlink, "invalid unlink"},
     {test_portal_invalid_close, "invalid close "},
     {test_portal_invalid_read, "invalid read  "},
     {test_portal_invalid_write, "invalid write "},
+    {test_portal_invalid_read_large, "invalid lread "},
+    {test_portal_invalid_write_large, "invalid lwrite"},
+    {test_portal_invalid_readv, "invalid readv "},
+    {test_portal_invalid_writev, "invalid writev"},
+    {test_portal_invalid_peek, "invalid peek  "},
     {test_portal_bad_create, "bad create    "},
     {test_portal_bad_open, "bad open      "},
+    {test_portal_bad_mopen, "bad mopen     "},
     {test_portal_bad_allow, "bad allow     "},
     {test_portal_bad_unlink, "bad unlink    "},
     {test_portal_bad_close, "bad close     "},
     {test_portal_double_unlink, "double unlink "},
     {test_portal_double_close, "double close  "},
     {test_portal_double_allow, "double allow  "},
+    {test_portal_bad_timeout, "bad timeout   "},
     {NULL, NULL},
 };
 
@@ -84,6 +84,94 @@ PRIVATE void test_sync_open_close(void)
     KASSERT(sync_close(syncid) == 0);
 }
 
+/**
+ * @brief API Test: Synchronization Point Set Timeout
+ */
+PRIVATE void test_sync_set_timeout(void)
+{
+    int syncid;
+    int nodes[NODES_AMOUNT];
+
+    nodes[0] = NODENUM_SLAVE;
+    nodes[1] = NODENUM_MASTER;
+
+    KASSERT((syncid = sync_open(nodes, NODES_AMOUNT, SYNC_ALL_TO_ONE)) >= 0);
+    KASSERT(sync_ioctl(syncid, SYNC_IOCTL_SET_TIMEOUT, 10) == 0);
+    KASSERT(sync_close(syncid) == 0);
+
+    KASSERT((syncid = sync_create(nodes, NODES_AMOUNT, SYNC_ONE_TO_ALL)) >= 0);
+    KASSERT(sync_ioctl(syncid, SYNC_IOCTL_SET_TIMEOUT, 10) == 0);
+    KASSERT(sync_unlink(syncid) == 0);
+}
+
+/**
+ * @brief API Test: Synchronization Point Wait Timeout
+ */
+PRIVATE void test_sync_wait_timeout(void)
+{
+    int syncid;
+    int nodes[NODES_AMOUNT];
+
+    nodes[0] = NODENUM_SLAVE;
+    nodes[1] = NODENUM_MASTER;
+
+    KASSERT((syncid = sync_create(nodes, NODES_AMOUNT, SYNC_ONE_TO_ALL)) >= 0);
+    KASSERT(sync_ioctl(syncid, SYNC_IOCTL_SET_TIMEOUT, SYNC_TIMEOUT_TRY) == 0);
+    KASSERT(sync_wait(syncid) == -ETIMEDOUT);
+    KASSERT(sync_ioctl(syncid, SYNC_IOCTL_SET_TIMEOUT, 10) == 0);
+    KASSERT(sync_wait(syncid) == -ETIMEDOUT);
+    KASSERT(sync_await(syncid) == -ETIMEDOUT);
+    KASSERT(sync_unlink(syncid) == 0);
+}
+
+/**
+ * @brief API Test: Synchronization Point Set Algorithm
+ */
+PRIVATE void test_sync_set_algorithm(void)
+{
+    int syncid;
+    int nodes[NODES_AMOUNT];
+
+    nodes[0] = NODENUM_SLAVE;
+    nodes[1] = NODENUM_MASTER;
+
+    KASSERT((syncid = sync_open(nodes, NODES_AMOUNT, SYNC_ALL_TO_ONE)) >= 0);
+    KASSERT(sync_ioctl(syncid, SYNC_IOCTL_SET_ALGORITHM, SYNC_ALGORITHM_TREE) ==
+            0);
+    KASSERT(sync_ioctl(
+                syncid, SYNC_IOCTL_SET_ALGORITHM, SYNC_ALGORITHM_LINEAR) == 0);
+    KASSERT(sync_close(syncid) == 0);
+
+    KASSERT((syncid = sync_create(nodes, NODES_AMOUNT, SYNC_ONE_TO_ALL)) >= 0);
+    KASSERT(sync_ioctl(syncid,
+                       SYNC_IOCTL_SET_ALGORITHM,
+                       SYNC_ALGORITHM_DISSEMINATION) == 0);
+    KASSERT(sync_unlink(syncid) == 0);
+}
+
+/**
+ * @brief API Test: Synchronization Point Split-Phase Test
+ */
+PRIVATE void test_sync_split_phase(void)
+{
+    int syncid;
+    int nodes[NODES_AMOUNT];
+
+    nodes[0] = NODENUM_SLAVE;
+    nodes[1] = NODENUM_MASTER;
+
+    /* Nothing pending. */
+    KASSERT((syncid = sync_open(nodes, NODES_AMOUNT, SYNC_ALL_TO_ONE)) >= 0);
+    KASSERT(sync_test(syncid) == 1);
+    KASSERT(sync_await(syncid) == 0);
+    KASSERT(sync_close(syncid) == 0);
+
+    /* Nothing completed. */
+    KASSERT((syncid = sync_create(nodes, NODES_AMOUNT, SYNC_ONE_TO_ALL)) >= 0);
+    KASSERT(sync_test(syncid) == 0);
+    KASSERT(sync_unlink(syncid) == 0);
+}
+
 /*============================================================================*
  * Fault Injection Tests                                                      *
  *============================================================================*/
@@ -405,6 +493,75 @@ PRIVATE void test_sync_bad_wait(void)
     KASSERT(sync_close(syncid) == 0);
 }
 
+/**
+ * @brief Fault Injection Test: Synchronization Point Bad Algorithm
+ */
+PRIVATE void test_sync_bad_algorithm(void)
+{
+    int syncid;
+    int nodes[NODES_AMOUNT];
+
+    nodes[0] = NODENUM_SLAVE;
+    nodes[1] = NODENUM_MASTER;
+
+    KASSERT((syncid = sync_open(nodes, NODES_AMOUNT, SYNC_ALL_TO_ONE)) >= 0);
+    KASSERT(sync_ioctl(syncid, SYNC_IOCTL_SET_ALGORITHM, -1) == -EINVAL);
+    KASSERT(sync_ioctl(syncid, SYNC_IOCTL_SET_ALGORITHM, 1000) == -EINVAL);
+    KASSERT(sync_close(syncid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Synchronization Point Bad Timeout
+ */
+PRIVATE void test_sync_bad_timeout(void)
+{
+    int syncid;
+    int nodes[NODES_AMOUNT];
+
+    nodes[0] = NODENUM_SLAVE;
+    nodes[1] = NODENUM_MASTER;
+
+    KASSERT((syncid = sync_open(nodes, NODES_AMOUNT, SYNC_ALL_TO_ONE)) >= 0);
+    KASSERT(sync_ioctl(syncid, SYNC_IOCTL_SET_TIMEOUT, -2) == -EINVAL);
+    KASSERT(sync_close(syncid) == 0);
+}
+
+/**
+ * @brief Fault Injection Test: Synchronization Point Invalid Split-Phase
+ */
+PRIVATE void test_sync_invalid_split_phase(void)
+{
+    KASSERT(sync_arrive(-1) == -EBADF);
+    KASSERT(sync_arrive(1000) == -EBADF);
+    KASSERT(sync_test(-1) == -EBADF);
+    KASSERT(sync_test(1000) == -EBADF);
+    KASSERT(sync_await(-1) == -EBADF);
+    KASSERT(sync_await(1000) == -EBADF);
+}
+
+/**
+ * @brief Fault Injection Test: Synchronization Point Bad Split-Phase
+ */
+PRIVATE void test_sync_bad_split_phase(void)
+{
+    int syncid;
+    int nodes[NODES_AMOUNT];
+
+    nodes[0] = NODENUM_SLAVE;
+    nodes[1] = NODENUM_MASTER;
+
+    KASSERT((syncid = sync_create(nodes, NODES_AMOUNT, SYNC_ONE_TO_ALL)) >= 0);
+    KASSERT(sync_arrive(syncid) == -EBADF);
+    KASSERT(sync_unlink(syncid) == 0);
+
+    /* Closed sync. */
+    KASSERT((syncid = sync_open(nodes, NODES_AMOUNT, SYNC_ALL_TO_ONE)) >= 0);
+    KASSERT(sync_close(syncid) == 0);
+    KASSERT(sync_arrive(syncid) == -EBADF);
+    KASSERT(sync_test(syncid) == -EBADF);
+    KASSERT(sync_await(syncid) == -EBADF);
+}
+
 /*============================================================================*
  * Test Driver                                                                *
  *============================================================================*/
@@ -415,6 +572,10 @@ PRIVATE void test_sync_bad_wait(void)
 PRIVATE struct test sync_tests_api[] = {
     {test_sync_create_unlink, "create unlink"},
     {test_sync_open_close, "open close   "},
+    {test_sync_set_timeout, "set timeout  "},
+    {test_sync_wait_timeout, "wait timeout "},
+    {test_sync_set_algorithm, "set algorithm"},
+    {test_sync_split_phase, "split phase  "},
     {NULL, NULL},
 };
 
@@ -435,6 +596,10 @@ PRIVATE struct test sync_tests_fault[] = {
     {test_sync_bad_signal, "bad signal    "},
     {test_sync_invalid_wait, "invalid wait  "},
     {test_sync_bad_wait, "bad wait      "},
+    {test_sync_bad_algorithm, "bad algorithm "},
+    {test_sync_bad_timeout, "bad timeout   "},
+    {test_sync_invalid_split_phase, "invalid split "},
+    {test_sync_bad_split_phase, "bad split     "},
     {NULL, NULL},
 };
 
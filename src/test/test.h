@@ -116,6 +116,11 @@ EXTERN void test_perf(void);
  */
 EXTERN void test_spinlock(void);
 
+/**
+ * @brief Test driver for Spin Wait Interface.
+ */
+EXTERN void test_spinwait(void);
+
 /**
  * @brief Test driver for Timer Interface.
  */
@@ -146,6 +151,16 @@ EXTERN void test_mailbox(void);
  */
 EXTERN void test_portal(void);
 
+/**
+ * @brief Test driver for the Poll Interface
+ */
+EXTERN void test_poll(void);
+
+/**
+ * @brief Test driver for the Coalescing Interface
+ */
+EXTERN void test_coalesce(void);
+
 /**
  * @brief Test driver for the Clusters Interface
  */
@@ -161,6 +176,11 @@ EXTERN void test_noc(void);
  */
 EXTERN void test_stress_al(void);
 
+/**
+ * @brief Gets the number of nodes that run stress tests.
+ */
+EXTERN int test_stress_nodes_num(void);
+
 /**
  * @brief Stress test driver for the Mailbox Interface
  */